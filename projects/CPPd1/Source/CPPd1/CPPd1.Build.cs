@@ -19,10 +19,13 @@ public class CPPd1 : ModuleRules
 			"GameplayStateTreeModule",
 			"UMG",
 			"Slate",
-			"ProceduralMeshComponent"
+			"SlateCore",
+			"ProceduralMeshComponent",
+			"MeshDescription",
+			"StaticMeshDescription"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "AssetRegistry", "NavigationSystem", "RenderCore" });
 
 		PublicIncludePaths.AddRange(new string[] {
 			"CPPd1",
@@ -34,6 +37,8 @@ public class CPPd1 : ModuleRules
 			"CPPd1/Variant_Combat/Gameplay",
 			"CPPd1/Variant_Combat/Interfaces",
 			"CPPd1/Variant_Combat/UI",
+			"CPPd1/Variant_Combat/Simulation",
+			"CPPd1/Variant_Combat/Diagnostics",
 			"CPPd1/Variant_SideScrolling",
 			"CPPd1/Variant_SideScrolling/AI",
 			"CPPd1/Variant_SideScrolling/Gameplay",
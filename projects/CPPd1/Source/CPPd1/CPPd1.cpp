@@ -5,4 +5,44 @@
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, CPPd1, "CPPd1" );
 
-DEFINE_LOG_CATEGORY(LogCPPd1)
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogCPPd1)
+
+DEFINE_STAT(STAT_CombatAttackTrace);
+DEFINE_STAT(STAT_CombatApplyDamage);
+DEFINE_STAT(STAT_CombatLockOnQuery);
+DEFINE_STAT(STAT_CombatEngagementUpdate);
+DEFINE_STAT(STAT_CombatWaveSpawn);
+DEFINE_STAT(STAT_CombatHUDRefresh);
+DEFINE_STAT(STAT_CombatCubeNinjaRebuild);
+DEFINE_STAT(STAT_CombatSaveCapture);
+DEFINE_STAT(STAT_CombatHazardDamage);
+DEFINE_STAT(STAT_CombatAttackTraces);
+DEFINE_STAT(STAT_CombatEnemiesAlive);
+DEFINE_STAT(STAT_CombatActiveRagdolls);
+DEFINE_STAT(STAT_CombatPooledActors);
+
+uint64 FCombatSystemTimer::FrameCycles[(int32)ECombatTimedSystem::Count] = {};
+
+const TCHAR* FCombatSystemTimer::GetName(ECombatTimedSystem System)
+{
+	switch (System)
+	{
+	case ECombatTimedSystem::AttackTrace:		return TEXT("AttackTrace");
+	case ECombatTimedSystem::ApplyDamage:		return TEXT("ApplyDamage");
+	case ECombatTimedSystem::LockOnQuery:		return TEXT("LockOnQuery");
+	case ECombatTimedSystem::EngagementUpdate:	return TEXT("EngagementUpdate");
+	case ECombatTimedSystem::WaveSpawn:			return TEXT("WaveSpawn");
+	case ECombatTimedSystem::HUDRefresh:		return TEXT("HUDRefresh");
+	case ECombatTimedSystem::CubeNinjaRebuild:	return TEXT("CubeNinjaRebuild");
+	case ECombatTimedSystem::SaveCapture:		return TEXT("SaveCapture");
+	case ECombatTimedSystem::HazardDamage:		return TEXT("HazardDamage");
+	default:									return TEXT("Unknown");
+	}
+}
+
+LLM_DEFINE_TAG(Combat);
+LLM_DEFINE_TAG(Combat_Enemies);
+LLM_DEFINE_TAG(Combat_HUD);
+LLM_DEFINE_TAG(Combat_ProceduralMesh);
+LLM_DEFINE_TAG(Combat_TricksSkills);
+LLM_DEFINE_TAG(Combat_Spawners);
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
 
 // Module API macro - for classes that need to be exported
 #ifndef CPPd1_API
@@ -10,4 +14,84 @@
 #endif
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogCPPd1, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogCPPd1, Log, All);
+
+/**
+ * Combat stat group: "stat Combat" in the console, and CPU scopes/counters in Unreal Insights (-trace=cpu,stats).
+ * Cycle stats time the hot combat paths; counters track how much combat is live this frame.
+ */
+DECLARE_STATS_GROUP(TEXT("Combat"), STATGROUP_Combat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attack Trace"), STAT_CombatAttackTrace, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Damage"), STAT_CombatApplyDamage, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lock-On Query"), STAT_CombatLockOnQuery, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Engagement Update"), STAT_CombatEngagementUpdate, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wave Spawn"), STAT_CombatWaveSpawn, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Refresh"), STAT_CombatHUDRefresh, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cube Ninja Rebuild"), STAT_CombatCubeNinjaRebuild, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Capture"), STAT_CombatSaveCapture, STATGROUP_Combat, CPPd1_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hazard Damage"), STAT_CombatHazardDamage, STATGROUP_Combat, CPPd1_API);
+
+/** Melee sweeps issued this frame (reset every frame) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Attack Traces"), STAT_CombatAttackTraces, STATGROUP_Combat, CPPd1_API);
+
+/** Live totals, kept up to date by the actors themselves */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemies Alive"), STAT_CombatEnemiesAlive, STATGROUP_Combat, CPPd1_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Ragdolls"), STAT_CombatActiveRagdolls, STATGROUP_Combat, CPPd1_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Actors"), STAT_CombatPooledActors, STATGROUP_Combat, CPPd1_API);
+
+/** Game-thread combat systems that are also timed every frame for hitch reports, whether or not stats are compiled in */
+enum class ECombatTimedSystem : uint8
+{
+	AttackTrace,
+	ApplyDamage,
+	LockOnQuery,
+	EngagementUpdate,
+	WaveSpawn,
+	HUDRefresh,
+	CubeNinjaRebuild,
+	SaveCapture,
+	HazardDamage,
+	Count
+};
+
+/** Per-frame game-thread time per combat system; reset at the start of every frame by UCombatHitchDetector */
+struct CPPd1_API FCombatSystemTimer
+{
+	static uint64 FrameCycles[(int32)ECombatTimedSystem::Count];
+
+	struct FScope
+	{
+		explicit FScope(ECombatTimedSystem InSystem) : System(InSystem), StartCycles(FPlatformTime::Cycles64()) {}
+
+		~FScope()
+		{
+			if (IsInGameThread())
+			{
+				FrameCycles[(int32)System] += FPlatformTime::Cycles64() - StartCycles;
+			}
+		}
+
+		ECombatTimedSystem System;
+		uint64 StartCycles;
+	};
+
+	static void ResetFrame() { FMemory::Memzero(FrameCycles); }
+	static const TCHAR* GetName(ECombatTimedSystem System);
+};
+
+/** Stat scope plus hitch timing for a game-thread combat system: COMBAT_SCOPE(WaveSpawn) times STAT_CombatWaveSpawn */
+#define COMBAT_SCOPE(System) \
+	SCOPE_CYCLE_COUNTER(STAT_Combat##System); \
+	FCombatSystemTimer::FScope CombatSystemScope_##System(ECombatTimedSystem::System)
+
+/**
+ * Low-Level Memory tracker tags for combat content: "stat LLMFULL" in the console, or -llm with -trace=memtag in Insights.
+ * Scope allocations with LLM_SCOPE_BYTAG(Combat_Enemies) etc.; they nest under Combat.
+ */
+LLM_DECLARE_TAG_API(Combat, CPPd1_API);
+LLM_DECLARE_TAG_API(Combat_Enemies, CPPd1_API);
+LLM_DECLARE_TAG_API(Combat_HUD, CPPd1_API);
+LLM_DECLARE_TAG_API(Combat_ProceduralMesh, CPPd1_API);
+LLM_DECLARE_TAG_API(Combat_TricksSkills, CPPd1_API);
+LLM_DECLARE_TAG_API(Combat_Spawners, CPPd1_API);
@@ -2,14 +2,35 @@
 
 #include "CPPd1GameStateBase.h"
 #include "CPPd1PlayerState.h"
+#include "CPPd1RoundSnapshot.h"
+#include "CPPd1GoalZone.h"
+#include "EngineUtils.h"
 
 void ACPPd1GameStateBase::SetGamePhase(ECPPd1GamePhase Phase)
 {
 	GamePhase = Phase;
 }
 
+void ACPPd1GameStateBase::HandleBeginPlay()
+{
+	Super::HandleBeginPlay();
+
+	// every actor has begun play: snapshot the level as the match starts, if it's played in rounds
+	UCPPd1RoundSnapshot* Snapshot = GetWorld()->GetSubsystem<UCPPd1RoundSnapshot>();
+	if (Snapshot && TActorIterator<ACPPd1GoalZone>(GetWorld()))
+	{
+		Snapshot->Capture();
+	}
+}
+
 void ACPPd1GameStateBase::StartNextRound()
 {
+	// put the level back the way the match started, in one pass and without respawning anyone
+	if (UCPPd1RoundSnapshot* Snapshot = GetWorld()->GetSubsystem<UCPPd1RoundSnapshot>())
+	{
+		Snapshot->Restore();
+	}
+
 	CurrentRound++;
 	GamePhase = ECPPd1GamePhase::Fighting;
 }
@@ -44,7 +44,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "CPPd1")
 	void SetGamePhase(ECPPd1GamePhase Phase);
 
-	/** Advance to next round and set phase to Fighting. */
+	/** Advance to next round and set phase to Fighting. Restores the round snapshot taken when the match started */
 	UFUNCTION(BlueprintCallable, Category = "CPPd1")
 	void StartNextRound();
+
+protected:
+
+	/** Captures the round snapshot once every actor has begun play, in levels with a goal zone */
+	virtual void HandleBeginPlay() override;
 };
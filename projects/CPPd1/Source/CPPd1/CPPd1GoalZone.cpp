@@ -3,6 +3,7 @@
 #include "CPPd1GoalZone.h"
 #include "CPPd1PlayerState.h"
 #include "CPPd1GameStateBase.h"
+#include "CPPd1RoundSnapshot.h"
 #include "Components/BoxComponent.h"
 #include "GameFramework/Character.h"
 
@@ -16,11 +17,36 @@ ACPPd1GoalZone::ACPPd1GoalZone()
 	TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &ACPPd1GoalZone::OnOverlap);
 }
 
+void ACPPd1GoalZone::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UCPPd1RoundSnapshot::Register(this);
+}
+
+void ACPPd1GoalZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UCPPd1RoundSnapshot::Unregister(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ACPPd1GoalZone::ResetForNewRound()
 {
 	bRoundAlreadyWon = false;
 }
 
+void ACPPd1GoalZone::CaptureRoundState()
+{
+	bRoundStartWon = bRoundAlreadyWon;
+}
+
+void ACPPd1GoalZone::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	SetActorTransform(RoundStartTransform);
+	bRoundAlreadyWon = bRoundStartWon;
+}
+
 void ACPPd1GoalZone::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	if (bOneWinPerRound && bRoundAlreadyWon) return;
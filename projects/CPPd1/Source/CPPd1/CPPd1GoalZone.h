@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "CPPd1RoundResettable.h"
 #include "CPPd1GoalZone.generated.h"
 
 class UBoxComponent;
@@ -16,7 +17,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCPPd1RoundWon, int32, WinningPlay
  * Notifies game state and can be used to advance rounds or end the match.
  */
 UCLASS(abstract)
-class ACPPd1GoalZone : public AActor
+class ACPPd1GoalZone : public AActor, public ICPPd1RoundResettable
 {
 	GENERATED_BODY()
 
@@ -43,8 +44,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "CPPd1")
 	void ResetForNewRound();
 
+	// ~begin ICPPd1RoundResettable interface
+	virtual void CaptureRoundState() override;
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+	// ~end ICPPd1RoundResettable interface
+
 protected:
 
+	/** bRoundAlreadyWon when the round snapshot was taken */
+	bool bRoundStartWon = false;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION()
 	void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 };
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CPPd1LockOnTargetComponent.h"
+#include "CPPd1.h"
 #include "GameFramework/Actor.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/World.h"
@@ -42,6 +43,8 @@ FVector UCPPd1LockOnTargetComponent::GetLockOnWorldLocation() const
 
 void UCPPd1LockOnTargetComponent::FindLockOnTargetsInRadius(UObject* WorldContextObject, FVector Origin, float Radius, TArray<AActor*>& OutTargets)
 {
+	COMBAT_SCOPE(LockOnQuery);
+
 	OutTargets.Reset();
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 	if (!World) return;
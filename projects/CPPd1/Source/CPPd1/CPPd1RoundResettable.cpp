@@ -0,0 +1,4 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CPPd1RoundResettable.h"
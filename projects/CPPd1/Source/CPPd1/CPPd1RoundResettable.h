@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CPPd1RoundResettable.generated.h"
+
+/**
+ *  Round Resettable Interface
+ *  Actors that carry state beyond their transform (HP, flags, spawner progress) and can put it back in place
+ *  when UCPPd1RoundSnapshot restores the round
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class UCPPd1RoundResettable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICPPd1RoundResettable
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Remember whatever this actor needs beyond its transform to return to round start */
+	virtual void CaptureRoundState() = 0;
+
+	/** Go back to the captured state and to the transform the actor had at capture, without being destroyed */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) = 0;
+};
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CPPd1RoundSnapshot.h"
+#include "CPPd1RoundResettable.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+void UCPPd1RoundSnapshot::Register(AActor* Actor)
+{
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	if (UCPPd1RoundSnapshot* Snapshot = World ? World->GetSubsystem<UCPPd1RoundSnapshot>() : nullptr)
+	{
+		Snapshot->RegisterActor(Actor);
+	}
+}
+
+void UCPPd1RoundSnapshot::Unregister(AActor* Actor)
+{
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	if (UCPPd1RoundSnapshot* Snapshot = World ? World->GetSubsystem<UCPPd1RoundSnapshot>() : nullptr)
+	{
+		Snapshot->UnregisterActor(Actor);
+	}
+}
+
+void UCPPd1RoundSnapshot::RegisterActor(AActor* Actor)
+{
+	if (!Actor || IsRegistered(Actor))
+	{
+		return;
+	}
+
+	FActorEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+
+	// joined mid-round (e.g. a ghost spawned for a solo player): its round start is now
+	if (bHasSnapshot)
+	{
+		CaptureEntry(Entry);
+	}
+}
+
+void UCPPd1RoundSnapshot::UnregisterActor(AActor* Actor)
+{
+	Entries.RemoveAllSwap([Actor](const FActorEntry& Entry) { return Entry.Actor == Actor; });
+}
+
+bool UCPPd1RoundSnapshot::IsRegistered(const AActor* Actor) const
+{
+	return Entries.ContainsByPredicate([Actor](const FActorEntry& Entry) { return Entry.Actor == Actor; });
+}
+
+void UCPPd1RoundSnapshot::Capture()
+{
+	for (FActorEntry& Entry : Entries)
+	{
+		CaptureEntry(Entry);
+	}
+
+	bHasSnapshot = true;
+}
+
+void UCPPd1RoundSnapshot::CaptureEntry(FActorEntry& Entry)
+{
+	AActor* Actor = Entry.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	Entry.Transform = Actor->GetActorTransform();
+
+	if (ICPPd1RoundResettable* Resettable = Cast<ICPPd1RoundResettable>(Actor))
+	{
+		Resettable->CaptureRoundState();
+	}
+}
+
+void UCPPd1RoundSnapshot::Restore()
+{
+	if (!bHasSnapshot)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (const FActorEntry& Entry : Entries)
+	{
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		if (ICPPd1RoundResettable* Resettable = Cast<ICPPd1RoundResettable>(Actor))
+		{
+			Resettable->RestoreRoundState(Entry.Transform);
+			continue;
+		}
+
+		// plain actors: back to the start transform, and at rest if they simulate
+		Actor->SetActorTransform(Entry.Transform, false, nullptr, ETeleportType::ResetPhysics);
+		if (UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
+		{
+			if (Root->IsSimulatingPhysics())
+			{
+				Root->SetPhysicsLinearVelocity(FVector::ZeroVector);
+				Root->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+			}
+		}
+	}
+
+	UE_LOG(LogCPPd1, Log, TEXT("RoundSnapshot: restored %d actors in %.2f ms"), Entries.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UCPPd1RoundSnapshot::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
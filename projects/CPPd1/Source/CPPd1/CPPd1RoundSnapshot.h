@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CPPd1RoundSnapshot.generated.h"
+
+/**
+ * Round start snapshot of the registered actors, restored in one pass so the next round starts within a frame.
+ *
+ * Actors register themselves on BeginPlay (ICPPd1RoundResettable implementers do this automatically; anything
+ * else can be registered from Blueprint for a transform-only reset). Capture records every transform and lets
+ * resettable actors store their own state; Restore teleports each actor back and hands resettable ones their
+ * transform to restore the rest. Nothing registered is destroyed or spawned.
+ *
+ * ACPPd1GameStateBase captures when the match starts, in levels with a goal zone, and StartNextRound restores on
+ * every round after that. Without a snapshot, nothing is restored and broken actors are destroyed as usual.
+ */
+UCLASS()
+class CPPd1_API UCPPd1RoundSnapshot : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Include an actor in the snapshot. Registered after Capture, it's captured right away */
+	UFUNCTION(BlueprintCallable, Category = "CPPd1|Round")
+	void RegisterActor(AActor* Actor);
+
+	/** Drop an actor from the snapshot (EndPlay) */
+	UFUNCTION(BlueprintCallable, Category = "CPPd1|Round")
+	void UnregisterActor(AActor* Actor);
+
+	/** True if the actor is registered with the snapshot */
+	bool IsRegistered(const AActor* Actor) const;
+
+	/** Record the round start state of every registered actor */
+	UFUNCTION(BlueprintCallable, Category = "CPPd1|Round")
+	void Capture();
+
+	/** Put every registered actor back to its captured state. Does nothing before the first Capture */
+	UFUNCTION(BlueprintCallable, Category = "CPPd1|Round")
+	void Restore();
+
+	/** True once Capture has run */
+	UFUNCTION(BlueprintPure, Category = "CPPd1|Round")
+	bool HasSnapshot() const { return bHasSnapshot; }
+
+	/** Shorthands for actors registering from BeginPlay / EndPlay */
+	static void Register(AActor* Actor);
+	static void Unregister(AActor* Actor);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	struct FActorEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FTransform Transform;
+	};
+
+	/** Record one entry's transform and custom state */
+	static void CaptureEntry(FActorEntry& Entry);
+
+	TArray<FActorEntry> Entries;
+
+	bool bHasSnapshot = false;
+};
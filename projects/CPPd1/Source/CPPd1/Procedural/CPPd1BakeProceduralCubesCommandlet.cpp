@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CPPd1BakeProceduralCubesCommandlet.h"
+#include "CPPd1ProceduralCubeBaker.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UCPPd1BakeProceduralCubesCommandlet::UCPPd1BakeProceduralCubesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCPPd1BakeProceduralCubesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> Maps;
+	ParamValues.FindRef(TEXT("Maps")).ParseIntoArray(Maps, TEXT("+"));
+	if (Maps.Num() == 0)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("BakeProceduralCubes: no maps given (use -Maps=/Game/Map1+/Game/Map2)"));
+		return 1;
+	}
+
+	const FString* OutPath = ParamValues.Find(TEXT("OutPath"));
+	const FString Folder = OutPath ? *OutPath : FString(UCPPd1ProceduralCubeBaker::DefaultBakeFolder);
+	const bool bSetInstanced = Switches.Contains(TEXT("Instanced"));
+
+	int32 NumErrors = 0;
+	for (const FString& MapName : Maps)
+	{
+		UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("BakeProceduralCubes: could not load map %s"), *MapName);
+			++NumErrors;
+			continue;
+		}
+
+		const int32 NumChanged = UCPPd1ProceduralCubeBaker::BakeCubesInLevel(World->PersistentLevel, Folder, bSetInstanced);
+		UE_LOG(LogCPPd1, Display, TEXT("BakeProceduralCubes: %s - %d cubes updated"), *MapName, NumChanged);
+		if (NumChanged == 0) continue;
+
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetMapPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Standalone;
+		if (!UPackage::SavePackage(Package, World, *Filename, SaveArgs))
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("BakeProceduralCubes: failed to save %s"), *Filename);
+			++NumErrors;
+		}
+	}
+
+	return NumErrors > 0 ? 1 : 0;
+#else
+	UE_LOG(LogCPPd1, Error, TEXT("BakeProceduralCubes requires an editor build"));
+	return 1;
+#endif
+}
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Commandlets/Commandlet.h"
+#include "CPPd1BakeProceduralCubesCommandlet.generated.h"
+
+/**
+ * Bakes every ACPPd1ProceduralCube in the given maps to shared static mesh assets and saves the maps.
+ *
+ * UnrealEditor-Cmd CPPd1.uproject -run=CPPd1BakeProceduralCubes -Maps=/Game/Maps/Arena+/Game/Maps/Dojo [-OutPath=/Game/Procedural/Baked] [-Instanced]
+ *
+ * -Instanced also switches the baked cubes to Instanced render mode.
+ */
+UCLASS()
+class CPPd1_API UCPPd1BakeProceduralCubesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCPPd1BakeProceduralCubesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
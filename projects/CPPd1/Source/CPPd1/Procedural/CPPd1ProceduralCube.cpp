@@ -1,8 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CPPd1ProceduralCube.h"
+#include "CPPd1ProceduralGeometry.h"
+#include "CPPd1ProceduralCubeBaker.h"
+#include "CPPd1ProceduralCubeInstancer.h"
 #include "ProceduralMeshComponent.h"
-#include "Engine/Engine.h"
+#include "Materials/MaterialInterface.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
 
 ACPPd1ProceduralCube::ACPPd1ProceduralCube()
 {
@@ -10,6 +15,7 @@ ACPPd1ProceduralCube::ACPPd1ProceduralCube()
 
 	ProceduralMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("ProceduralMesh"));
 	SetRootComponent(ProceduralMesh);
+	ProceduralMesh->bUseAsyncCooking = true;
 }
 
 void ACPPd1ProceduralCube::OnConstruction(const FTransform& Transform)
@@ -18,45 +24,87 @@ void ACPPd1ProceduralCube::OnConstruction(const FTransform& Transform)
 	BuildCubeMesh();
 }
 
+void ACPPd1ProceduralCube::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (RenderMode != ECPPd1ProceduralCubeRenderMode::Instanced)
+	{
+		return;
+	}
+
+	// the instancer batches every cube that begins play this frame; until then the procedural mesh keeps drawing
+	if (UCPPd1ProceduralCubeInstancer* Instancer = GetWorld()->GetSubsystem<UCPPd1ProceduralCubeInstancer>())
+	{
+		Instancer->AddCube(this);
+	}
+}
+
+void ACPPd1ProceduralCube::ReleaseProceduralMesh()
+{
+	if (!ProceduralMesh) return;
+
+	// drop any build still in flight
+	++BuildSerial;
+
+	// the instanced mesh draws and collides for us now; drop the procedural section data
+	ProceduralMesh->ClearAllMeshSections();
+	ProceduralMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ProceduralMesh->SetVisibility(false);
+}
+
 void ACPPd1ProceduralCube::RebuildMesh()
 {
 	BuildCubeMesh();
 }
 
+#if WITH_EDITOR
+void ACPPd1ProceduralCube::BakeToStaticMesh()
+{
+	if (UStaticMesh* Mesh = UCPPd1ProceduralCubeBaker::BakeCubeAsset(Size, UCPPd1ProceduralCubeBaker::DefaultBakeFolder))
+	{
+		Modify();
+		BakedMesh = Mesh;
+	}
+}
+#endif
+
 void ACPPd1ProceduralCube::BuildCubeMesh()
 {
 	if (!ProceduralMesh) return;
 
-	TArray<FVector> Vertices;
-	TArray<int32> Triangles;
-	TArray<FVector> Normals;
-	TArray<FVector2D> UV0;
-
-	const float H = Size * 0.5f;
-	// 8 corners of a cube (centered at origin)
-	FVector V[8] = {
-		FVector(-H, -H, -H), FVector( H, -H, -H), FVector( H,  H, -H), FVector(-H,  H, -H), // bottom
-		FVector(-H, -H,  H), FVector( H, -H,  H), FVector( H,  H,  H), FVector(-H,  H,  H)  // top
-	};
-
-	// 6 faces: front, back, left, right, top, bottom (outward normals)
-	auto AddQuad = [&](int32 A, int32 B, int32 C, int32 D, const FVector& N) {
-		int32 Base = Vertices.Num();
-		Vertices.Add(V[A]); Vertices.Add(V[B]); Vertices.Add(V[C]); Vertices.Add(V[D]);
-		Normals.Add(N); Normals.Add(N); Normals.Add(N); Normals.Add(N);
-		UV0.Add(FVector2D(0,0)); UV0.Add(FVector2D(1,0)); UV0.Add(FVector2D(1,1)); UV0.Add(FVector2D(0,1));
-		Triangles.Add(Base+0); Triangles.Add(Base+1); Triangles.Add(Base+2);
-		Triangles.Add(Base+0); Triangles.Add(Base+2); Triangles.Add(Base+3);
-	};
-
-	AddQuad(4, 5, 6, 7, FVector( 0,  0,  1)); // front (Z+)
-	AddQuad(1, 0, 3, 2, FVector( 0,  0, -1)); // back (Z-)
-	AddQuad(0, 4, 7, 3, FVector(-1,  0,  0)); // left (X-)
-	AddQuad(5, 1, 2, 6, FVector( 1,  0,  0)); // right (X+)
-	AddQuad(7, 6, 2, 3, FVector( 0,  1,  0)); // top (Y+)
-	AddQuad(0, 1, 5, 4, FVector( 0, -1,  0)); // bottom (Y-)
+	const uint32 Serial = ++BuildSerial;
+	const FVector HalfExtents(Size * 0.5f);
 
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
+	{
+		// editor construction scripts want the result immediately
+		FCPPd1ProceduralMeshData Data;
+		FCPPd1ProceduralGeometry::AppendBox(Data, HalfExtents);
+		CommitCubeMesh(Data);
+		return;
+	}
+
+	TWeakObjectPtr<ACPPd1ProceduralCube> WeakThis(this);
+	FCPPd1ProceduralGeometry::BuildAsync(
+		[HalfExtents](TArray<FCPPd1ProceduralMeshData>& OutSections)
+		{
+			FCPPd1ProceduralGeometry::AppendBox(OutSections.AddDefaulted_GetRef(), HalfExtents);
+		},
+		[WeakThis, Serial](TArray<FCPPd1ProceduralMeshData>&& Sections)
+		{
+			ACPPd1ProceduralCube* Cube = WeakThis.Get();
+			if (Cube && Cube->BuildSerial == Serial && Sections.Num() > 0)
+			{
+				Cube->CommitCubeMesh(Sections[0]);
+			}
+		});
+}
+
+void ACPPd1ProceduralCube::CommitCubeMesh(const FCPPd1ProceduralMeshData& Data)
+{
 	ProceduralMesh->ClearAllMeshSections();
-	ProceduralMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UV0, TArray<FColor>(), TArray<FProcMeshTangent>(), true);
-	ProceduralMesh->SetMaterial(0, nullptr); // use default material or set in editor
+	ProceduralMesh->CreateMeshSection(0, Data.Vertices, Data.Triangles, Data.Normals, Data.UV0, TArray<FColor>(), TArray<FProcMeshTangent>(), true);
+	ProceduralMesh->SetMaterial(0, Material); // null uses the default material
 }
@@ -8,10 +8,24 @@
 #include "CPPd1ProceduralCube.generated.h"
 
 class UProceduralMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+struct FCPPd1ProceduralMeshData;
+
+/** How a procedural cube is drawn during play */
+UENUM(BlueprintType)
+enum class ECPPd1ProceduralCubeRenderMode : uint8
+{
+	/** Keep the procedural mesh (one dynamic draw per cube) */
+	Procedural,
+	/** Hand the cube to the world's shared instanced mesh for its size/material and drop the procedural data */
+	Instanced
+};
 
 /**
  * Actor that builds a 3D cube from code at runtime (or in editor).
  * Place in level to see a procedural mesh; edit Size to rescale.
+ * Bake To Static Mesh (or the BakeProceduralCubes commandlet) writes a shared UStaticMesh asset per size.
  */
 UCLASS(BlueprintType, Blueprintable)
 class CPPd1_API ACPPd1ProceduralCube : public AActor
@@ -25,15 +39,43 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural", meta = (ClampMin = "1.0"))
 	float Size = 100.f;
 
+	/** Material for the cube (procedural and instanced). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural")
+	TObjectPtr<UMaterialInterface> Material;
+
+	/** How this cube renders during play. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural|Rendering")
+	ECPPd1ProceduralCubeRenderMode RenderMode = ECPPd1ProceduralCubeRenderMode::Procedural;
+
+	/** Baked static mesh for this cube's size. If unset, Instanced mode builds a transient mesh at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural|Rendering")
+	TObjectPtr<UStaticMesh> BakedMesh;
+
 	/** Rebuild the procedural mesh (e.g. after changing Size). */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Procedural")
 	void RebuildMesh();
 
+	/** Called by the instancer once this cube is drawn by a shared instanced mesh. */
+	void ReleaseProceduralMesh();
+
+#if WITH_EDITOR
+	/** Bake this cube's size into a shared static mesh asset and assign it to BakedMesh. */
+	UFUNCTION(CallInEditor, Category = "Procedural|Rendering")
+	void BakeToStaticMesh();
+#endif
+
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void BeginPlay() override;
 
 	UPROPERTY(VisibleAnywhere, Category = "Procedural")
 	TObjectPtr<UProceduralMeshComponent> ProceduralMesh;
 
+	/** Bumped by every build (and by ReleaseProceduralMesh) so stale async results are dropped */
+	uint32 BuildSerial = 0;
+
+	/** Build the cube section. Game worlds generate off-thread; editor/preview worlds build inline. */
 	void BuildCubeMesh();
+
+	void CommitCubeMesh(const FCPPd1ProceduralMeshData& Data);
 };
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CPPd1ProceduralCubeBaker.h"
+#include "CPPd1ProceduralCube.h"
+#include "CPPd1ProceduralGeometry.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Level.h"
+#include "MeshDescription.h"
+
+#if WITH_EDITOR
+#include "PhysicsEngine/BodySetup.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#endif
+
+FString UCPPd1ProceduralCubeBaker::GetBakedAssetName(float Size)
+{
+	// e.g. SM_ProceduralCube_100 or SM_ProceduralCube_37_5
+	return FString::Printf(TEXT("SM_ProceduralCube_%s"), *FString::SanitizeFloat(Size, 0).Replace(TEXT("."), TEXT("_")));
+}
+
+UStaticMesh* UCPPd1ProceduralCubeBaker::CreateCubeMesh(UObject* Outer, float Size)
+{
+	FCPPd1ProceduralMeshData Data;
+	FCPPd1ProceduralGeometry::AppendBox(Data, FVector(Size * 0.5f));
+
+	FMeshDescription MeshDescription;
+	FCPPd1ProceduralGeometry::ToMeshDescription(Data, MeshDescription);
+
+	UStaticMesh* Mesh = NewObject<UStaticMesh>(Outer, NAME_None, RF_Transient);
+	Mesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, FCPPd1ProceduralGeometry::MaterialSlotName));
+
+	UStaticMesh::FBuildMeshDescriptionsParams Params;
+	Params.bBuildSimpleCollision = true; // box from bounds, same shape as the cube
+	Params.bFastBuild = true;
+
+	TArray<const FMeshDescription*> MeshDescriptions = { &MeshDescription };
+	Mesh->BuildFromMeshDescriptions(MeshDescriptions, Params);
+	return Mesh;
+}
+
+#if WITH_EDITOR
+UStaticMesh* UCPPd1ProceduralCubeBaker::BakeCubeAsset(float Size, const FString& Folder)
+{
+	const FString AssetName = GetBakedAssetName(Size);
+	const FString PackageName = Folder / AssetName;
+
+	// one asset per size, shared by every cube that uses it
+	if (UStaticMesh* Existing = LoadObject<UStaticMesh>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet))
+	{
+		return Existing;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UStaticMesh* Mesh = NewObject<UStaticMesh>(Package, *AssetName, RF_Public | RF_Standalone);
+	Mesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, FCPPd1ProceduralGeometry::MaterialSlotName));
+
+	FCPPd1ProceduralMeshData Data;
+	FCPPd1ProceduralGeometry::AppendBox(Data, FVector(Size * 0.5f));
+
+	FMeshDescription MeshDescription;
+	FCPPd1ProceduralGeometry::ToMeshDescription(Data, MeshDescription);
+
+	Mesh->SetNumSourceModels(1);
+	FStaticMeshSourceModel& SourceModel = Mesh->GetSourceModel(0);
+	SourceModel.BuildSettings.bRecomputeNormals = false; // keep the flat face normals
+	SourceModel.BuildSettings.bRecomputeTangents = true;
+	SourceModel.BuildSettings.bGenerateLightmapUVs = true;
+
+	Mesh->CreateMeshDescription(0, MoveTemp(MeshDescription));
+	Mesh->CommitMeshDescription(0);
+
+	// simple box collision matching the procedural section's collision
+	Mesh->CreateBodySetup();
+	Mesh->GetBodySetup()->AggGeom.BoxElems.Add(FKBoxElem(Size));
+
+	Mesh->Build(false);
+	Mesh->PostEditChange();
+	Mesh->MarkPackageDirty();
+	FAssetRegistryModule::AssetCreated(Mesh);
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, Mesh, *Filename, SaveArgs))
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("ProceduralCubeBaker: failed to save %s"), *Filename);
+	}
+
+	return Mesh;
+}
+
+int32 UCPPd1ProceduralCubeBaker::BakeCubesInLevel(ULevel* Level, const FString& Folder, bool bSetInstanced)
+{
+	if (!Level) return 0;
+
+	int32 NumChanged = 0;
+	for (AActor* Actor : Level->Actors)
+	{
+		ACPPd1ProceduralCube* Cube = Cast<ACPPd1ProceduralCube>(Actor);
+		if (!Cube) continue;
+
+		UStaticMesh* Mesh = BakeCubeAsset(Cube->Size, Folder);
+		if (!Mesh) continue;
+
+		const bool bModeChanged = bSetInstanced && Cube->RenderMode != ECPPd1ProceduralCubeRenderMode::Instanced;
+		if (Cube->BakedMesh == Mesh && !bModeChanged) continue;
+
+		Cube->Modify();
+		Cube->BakedMesh = Mesh;
+		if (bSetInstanced)
+		{
+			Cube->RenderMode = ECPPd1ProceduralCubeRenderMode::Instanced;
+		}
+		++NumChanged;
+	}
+	return NumChanged;
+}
+#endif
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "CPPd1ProceduralCubeBaker.generated.h"
+
+class UStaticMesh;
+class ULevel;
+
+/**
+ * Turns procedural cube geometry into UStaticMesh objects.
+ * Runtime: CreateCubeMesh builds a transient mesh (used by the instancer when a cube has no baked asset).
+ * Editor: BakeCubeAsset / BakeCubesInLevel save one shared asset per cube size (used by the actor button and the commandlet).
+ */
+UCLASS()
+class CPPd1_API UCPPd1ProceduralCubeBaker : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Content folder baked cube meshes are saved to by default */
+	static constexpr const TCHAR* DefaultBakeFolder = TEXT("/Game/Procedural/Baked");
+
+	/** Asset name used for a baked cube of the given edge length */
+	static FString GetBakedAssetName(float Size);
+
+	/** Build a transient static mesh (with box collision) for a cube of the given edge length */
+	static UStaticMesh* CreateCubeMesh(UObject* Outer, float Size);
+
+#if WITH_EDITOR
+	/** Load or create + save the shared static mesh asset for a cube of the given edge length */
+	static UStaticMesh* BakeCubeAsset(float Size, const FString& Folder);
+
+	/** Bake every procedural cube in the level and assign BakedMesh. Optionally switch them to Instanced rendering. Returns the number of cubes changed. */
+	static int32 BakeCubesInLevel(ULevel* Level, const FString& Folder, bool bSetInstanced);
+#endif
+};
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CPPd1ProceduralCubeInstancer.h"
+#include "CPPd1ProceduralCube.h"
+#include "CPPd1ProceduralCubeBaker.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Engine/CollisionProfile.h"
+#include "TimerManager.h"
+
+bool UCPPd1ProceduralCubeInstancer::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCPPd1ProceduralCubeInstancer::Deinitialize()
+{
+	PendingCubes.Reset();
+	Batches.Reset();
+	BatchLookup.Reset();
+	RuntimeMeshes.Reset();
+	HostActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UCPPd1ProceduralCubeInstancer::AddCube(ACPPd1ProceduralCube* Cube)
+{
+	if (!Cube) return;
+
+	if (PendingCubes.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UCPPd1ProceduralCubeInstancer::FlushPendingCubes);
+	}
+	PendingCubes.Add(Cube);
+}
+
+void UCPPd1ProceduralCubeInstancer::FlushPendingCubes()
+{
+	// group transforms per batch so each HISM rebuilds its tree once
+	TMap<int32, TArray<FTransform>> TransformsPerBatch;
+	TArray<ACPPd1ProceduralCube*> Instanced;
+	Instanced.Reserve(PendingCubes.Num());
+
+	for (const TWeakObjectPtr<ACPPd1ProceduralCube>& WeakCube : PendingCubes)
+	{
+		ACPPd1ProceduralCube* Cube = WeakCube.Get();
+		if (!Cube || Cube->IsActorBeingDestroyed()) continue;
+
+		UStaticMesh* Mesh = Cube->BakedMesh ? Cube->BakedMesh.Get() : GetRuntimeMesh(Cube->Size);
+		if (!Mesh) continue;
+
+		GetBatch(Mesh, Cube->Material);
+		TransformsPerBatch.FindOrAdd(BatchLookup.FindChecked(MakeTuple(Mesh, Cube->Material.Get()))).Add(Cube->GetActorTransform());
+		Instanced.Add(Cube);
+	}
+	PendingCubes.Reset();
+
+	for (TPair<int32, TArray<FTransform>>& Pair : TransformsPerBatch)
+	{
+		Batches[Pair.Key]->AddInstances(Pair.Value, false, true);
+	}
+
+	for (ACPPd1ProceduralCube* Cube : Instanced)
+	{
+		Cube->ReleaseProceduralMesh();
+	}
+
+	UE_LOG(LogCPPd1, Verbose, TEXT("ProceduralCubeInstancer: %d cubes in %d batches"), Instanced.Num(), Batches.Num());
+}
+
+UStaticMesh* UCPPd1ProceduralCubeInstancer::GetRuntimeMesh(float Size)
+{
+	if (TObjectPtr<UStaticMesh>* Found = RuntimeMeshes.Find(Size))
+	{
+		return *Found;
+	}
+
+	UStaticMesh* Mesh = UCPPd1ProceduralCubeBaker::CreateCubeMesh(this, Size);
+	RuntimeMeshes.Add(Size, Mesh);
+	return Mesh;
+}
+
+UHierarchicalInstancedStaticMeshComponent* UCPPd1ProceduralCubeInstancer::GetBatch(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	const TPair<UStaticMesh*, UMaterialInterface*> Key(Mesh, Material);
+	if (const int32* Index = BatchLookup.Find(Key))
+	{
+		return Batches[*Index];
+	}
+
+	if (!HostActor)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		HostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+
+		USceneComponent* Root = NewObject<USceneComponent>(HostActor, TEXT("Root"));
+		Root->SetMobility(EComponentMobility::Static);
+		HostActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* Batch = NewObject<UHierarchicalInstancedStaticMeshComponent>(HostActor);
+	Batch->SetMobility(EComponentMobility::Static);
+	Batch->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		Batch->SetMaterial(0, Material);
+	}
+	Batch->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Batch->SetupAttachment(HostActor->GetRootComponent());
+	Batch->RegisterComponent();
+	HostActor->AddInstanceComponent(Batch);
+
+	BatchLookup.Add(Key, Batches.Add(Batch));
+	return Batch;
+}
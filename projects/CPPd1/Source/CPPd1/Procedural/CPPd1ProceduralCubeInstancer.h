@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CPPd1ProceduralCubeInstancer.generated.h"
+
+class ACPPd1ProceduralCube;
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/**
+ * Draws Instanced-mode procedural cubes through one HISM per (mesh, material).
+ * Cubes queue themselves in BeginPlay; the queue is flushed next tick so each batch is built with a single AddInstances call.
+ */
+UCLASS()
+class CPPd1_API UCPPd1ProceduralCubeInstancer : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Queue a cube to be drawn by the shared instanced mesh for its size/material. */
+	void AddCube(ACPPd1ProceduralCube* Cube);
+
+	/** Number of instanced batches (draw groups) currently in use. */
+	int32 GetNumBatches() const { return Batches.Num(); }
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	/** Move every queued cube into its batch and release its procedural mesh. */
+	void FlushPendingCubes();
+
+	/** Transient mesh shared by cubes of this size that have no BakedMesh. */
+	UStaticMesh* GetRuntimeMesh(float Size);
+
+	/** Find or create the HISM for this mesh/material pair. */
+	UHierarchicalInstancedStaticMeshComponent* GetBatch(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	/** Cubes waiting for the next flush */
+	TArray<TWeakObjectPtr<ACPPd1ProceduralCube>> PendingCubes;
+
+	/** Transient actor that owns the HISM components */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> HostActor;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> Batches;
+
+	UPROPERTY(Transient)
+	TMap<float, TObjectPtr<UStaticMesh>> RuntimeMeshes;
+
+	/** (mesh, material) -> index into Batches */
+	TMap<TPair<UStaticMesh*, UMaterialInterface*>, int32> BatchLookup;
+};
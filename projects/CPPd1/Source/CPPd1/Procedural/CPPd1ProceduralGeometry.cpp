@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CPPd1ProceduralGeometry.h"
+#include "MeshDescription.h"
+#include "MeshDescriptionBuilder.h"
+#include "StaticMeshAttributes.h"
+#include "Async/Async.h"
+
+const FName FCPPd1ProceduralGeometry::MaterialSlotName(TEXT("Procedural"));
+
+void FCPPd1ProceduralGeometry::AppendBox(FCPPd1ProceduralMeshData& OutData, const FVector& HalfExtents)
+{
+	const float Hx = HalfExtents.X, Hy = HalfExtents.Y, Hz = HalfExtents.Z;
+
+	// 8 corners of a box (centered at origin)
+	const FVector V[8] = {
+		FVector(-Hx, -Hy, -Hz), FVector(Hx, -Hy, -Hz), FVector(Hx, Hy, -Hz), FVector(-Hx, Hy, -Hz), // bottom
+		FVector(-Hx, -Hy, Hz),  FVector(Hx, -Hy, Hz),  FVector(Hx, Hy, Hz),  FVector(-Hx, Hy, Hz)   // top
+	};
+
+	OutData.Vertices.Reserve(OutData.Vertices.Num() + 24);
+	OutData.Normals.Reserve(OutData.Normals.Num() + 24);
+	OutData.UV0.Reserve(OutData.UV0.Num() + 24);
+	OutData.Triangles.Reserve(OutData.Triangles.Num() + 36);
+
+	auto AddQuad = [&OutData, &V](int32 A, int32 B, int32 C, int32 D, const FVector& N) {
+		const int32 Base = OutData.Vertices.Num();
+		OutData.Vertices.Add(V[A]); OutData.Vertices.Add(V[B]); OutData.Vertices.Add(V[C]); OutData.Vertices.Add(V[D]);
+		OutData.Normals.Add(N); OutData.Normals.Add(N); OutData.Normals.Add(N); OutData.Normals.Add(N);
+		OutData.UV0.Add(FVector2D(0, 0)); OutData.UV0.Add(FVector2D(1, 0)); OutData.UV0.Add(FVector2D(1, 1)); OutData.UV0.Add(FVector2D(0, 1));
+		OutData.Triangles.Add(Base + 0); OutData.Triangles.Add(Base + 1); OutData.Triangles.Add(Base + 2);
+		OutData.Triangles.Add(Base + 0); OutData.Triangles.Add(Base + 2); OutData.Triangles.Add(Base + 3);
+	};
+
+	AddQuad(4, 5, 6, 7, FVector( 0,  0,  1)); // Z+
+	AddQuad(1, 0, 3, 2, FVector( 0,  0, -1)); // Z-
+	AddQuad(0, 4, 7, 3, FVector(-1,  0,  0)); // X-
+	AddQuad(5, 1, 2, 6, FVector( 1,  0,  0)); // X+
+	AddQuad(7, 6, 2, 3, FVector( 0,  1,  0)); // Y+
+	AddQuad(0, 1, 5, 4, FVector( 0, -1,  0)); // Y-
+}
+
+void FCPPd1ProceduralGeometry::AppendSphere(FCPPd1ProceduralMeshData& OutData, float Radius, int32 Segments)
+{
+	if (Radius <= 0.f) return;
+
+	const int32 RingCount = FMath::Max(2, Segments);
+	const int32 SectCount = FMath::Max(3, Segments * 2);
+	const int32 Base = OutData.Vertices.Num();
+
+	const int32 NumVerts = (RingCount + 1) * (SectCount + 1);
+	OutData.Vertices.Reserve(Base + NumVerts);
+	OutData.Normals.Reserve(Base + NumVerts);
+	OutData.UV0.Reserve(Base + NumVerts);
+	OutData.Triangles.Reserve(OutData.Triangles.Num() + RingCount * SectCount * 6);
+
+	for (int32 Ring = 0; Ring <= RingCount; ++Ring)
+	{
+		const float Phi = PI * (float)Ring / (float)RingCount;
+		const float Y = -FMath::Cos(Phi);
+		const float RingR = FMath::Sin(Phi);
+		for (int32 Sect = 0; Sect <= SectCount; ++Sect)
+		{
+			const float Theta = 2.f * PI * (float)Sect / (float)SectCount;
+			const float X = RingR * FMath::Cos(Theta);
+			const float Z = RingR * FMath::Sin(Theta);
+			FVector N(X, Z, Y);
+			N.Normalize();
+			OutData.Vertices.Add(N * Radius);
+			OutData.Normals.Add(N);
+			OutData.UV0.Add(FVector2D((float)Sect / (float)SectCount, (float)Ring / (float)RingCount));
+		}
+	}
+
+	for (int32 Ring = 0; Ring < RingCount; ++Ring)
+	{
+		for (int32 Sect = 0; Sect < SectCount; ++Sect)
+		{
+			const int32 A = Base + Ring * (SectCount + 1) + Sect;
+			const int32 B = A + 1;
+			const int32 C = A + (SectCount + 1);
+			const int32 D = C + 1;
+			OutData.Triangles.Add(A); OutData.Triangles.Add(C); OutData.Triangles.Add(B);
+			OutData.Triangles.Add(B); OutData.Triangles.Add(C); OutData.Triangles.Add(D);
+		}
+	}
+}
+
+void FCPPd1ProceduralGeometry::ToMeshDescription(const FCPPd1ProceduralMeshData& Data, FMeshDescription& OutMeshDescription)
+{
+	FStaticMeshAttributes Attributes(OutMeshDescription);
+	Attributes.Register();
+
+	FMeshDescriptionBuilder Builder;
+	Builder.SetMeshDescription(&OutMeshDescription);
+	Builder.EnablePolyGroups();
+	Builder.SetNumUVLayers(1);
+
+	const FPolygonGroupID PolygonGroup = Builder.AppendPolygonGroup();
+	Attributes.GetPolygonGroupMaterialSlotNames()[PolygonGroup] = MaterialSlotName;
+
+	// one vertex instance per buffer vertex so flat box normals and sphere seams survive
+	TArray<FVertexInstanceID> Instances;
+	Instances.Reserve(Data.Vertices.Num());
+	for (int32 i = 0; i < Data.Vertices.Num(); ++i)
+	{
+		const FVertexID VertexID = Builder.AppendVertex(Data.Vertices[i]);
+		const FVertexInstanceID InstanceID = Builder.AppendInstance(VertexID);
+		if (Data.Normals.IsValidIndex(i))
+		{
+			Builder.SetInstanceNormal(InstanceID, Data.Normals[i]);
+		}
+		if (Data.UV0.IsValidIndex(i))
+		{
+			Builder.SetInstanceUV(InstanceID, FVector2D(Data.UV0[i]), 0);
+		}
+		Instances.Add(InstanceID);
+	}
+
+	for (int32 i = 0; i + 2 < Data.Triangles.Num(); i += 3)
+	{
+		Builder.AppendTriangle(Instances[Data.Triangles[i]], Instances[Data.Triangles[i + 1]], Instances[Data.Triangles[i + 2]], PolygonGroup);
+	}
+}
+
+void FCPPd1ProceduralGeometry::BuildAsync(TUniqueFunction<void(TArray<FCPPd1ProceduralMeshData>&)>&& Build, TUniqueFunction<void(TArray<FCPPd1ProceduralMeshData>&&)>&& OnComplete)
+{
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Build = MoveTemp(Build), OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		TArray<FCPPd1ProceduralMeshData> Sections;
+		Build(Sections);
+
+		// only the commit (CreateMeshSection) happens on the game thread
+		AsyncTask(ENamedThreads::GameThread, [Sections = MoveTemp(Sections), OnComplete = MoveTemp(OnComplete)]() mutable
+		{
+			OnComplete(MoveTemp(Sections));
+		});
+	});
+}
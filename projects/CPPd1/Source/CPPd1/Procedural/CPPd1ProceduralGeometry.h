@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+
+struct FMeshDescription;
+
+/** Plain vertex/index buffers for one procedural mesh section. Safe to build on any thread. */
+struct CPPd1_API FCPPd1ProceduralMeshData
+{
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UV0;
+
+	void Reset()
+	{
+		Vertices.Reset();
+		Triangles.Reset();
+		Normals.Reset();
+		UV0.Reset();
+	}
+};
+
+/**
+ * Shared geometry generators for the procedural actors (cube, cube-ninja body).
+ * Pure functions with no UObject access, so they can run off the game thread.
+ */
+struct CPPd1_API FCPPd1ProceduralGeometry
+{
+	/** Append an axis-aligned box centered at the origin (4 verts per face, flat normals). */
+	static void AppendBox(FCPPd1ProceduralMeshData& OutData, const FVector& HalfExtents);
+
+	/** Append a UV sphere centered at the origin. */
+	static void AppendSphere(FCPPd1ProceduralMeshData& OutData, float Radius, int32 Segments = 12);
+
+	/** Convert buffers into a static mesh description (one polygon group using MaterialSlotName). */
+	static void ToMeshDescription(const FCPPd1ProceduralMeshData& Data, FMeshDescription& OutMeshDescription);
+
+	/** Material slot name used by meshes built from procedural buffers */
+	static const FName MaterialSlotName;
+
+	/**
+	 * Run Build on a background task-graph thread, then OnComplete on the game thread with the finished sections.
+	 * Build must not touch UObjects; OnComplete should re-check anything it captured weakly.
+	 */
+	static void BuildAsync(TUniqueFunction<void(TArray<FCPPd1ProceduralMeshData>&)>&& Build, TUniqueFunction<void(TArray<FCPPd1ProceduralMeshData>&&)>&& OnComplete);
+};
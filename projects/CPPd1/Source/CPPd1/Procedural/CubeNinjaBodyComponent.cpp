@@ -1,11 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CubeNinjaBodyComponent.h"
+#include "CubeNinjaBodyManager.h"
+#include "CPPd1ProceduralGeometry.h"
 #include "ProceduralMeshComponent.h"
 #include "Materials/MaterialInterface.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
 #include "Engine/World.h"
 
 namespace
@@ -25,7 +26,10 @@ namespace
 
 UCubeNinjaBodyComponent::UCubeNinjaBodyComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	LLM_SCOPE_BYTAG(Combat_ProceduralMesh);
+
+	// limb swing is batched by UCubeNinjaBodyManager
+	PrimaryComponentTick.bCanEverTick = false;
 
 	PartIsSphere.SetNum(NumParts);
 	PartHalfExtents.SetNum(NumParts);
@@ -142,6 +146,7 @@ UCubeNinjaBodyComponent::UCubeNinjaBodyComponent()
 		}
 		
 		Mesh->SetupAttachment(Pivot);
+		Mesh->bUseAsyncCooking = true;
 		Mesh->SetRelativeLocation(FVector::Zero());
 		Mesh->SetRelativeRotation(FRotator::ZeroRotator);
 		PartPivots.Add(Pivot);
@@ -248,148 +253,100 @@ UCubeNinjaBodyComponent::UCubeNinjaBodyComponent()
 void UCubeNinjaBodyComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	
-	// Delay mesh building to ensure all components are fully initialized
-	// Use a timer to rebuild on next frame
+
+	// geometry is generated on a worker thread; the sections appear once it's committed
+	RebuildBody();
+
 	if (UWorld* World = GetWorld())
 	{
-		FTimerHandle RebuildTimer;
-		World->GetTimerManager().SetTimer(RebuildTimer, this, &UCubeNinjaBodyComponent::RebuildBody, 0.01f, false);
+		// resolve the owner's movement once; the manager reads velocity from it every frame
+		if (ACharacter* Char = Cast<ACharacter>(GetOwner()))
+		{
+			CachedMovement = Char->GetCharacterMovement();
+		}
+
+		if (UCubeNinjaBodyManager* Manager = World->GetSubsystem<UCubeNinjaBodyManager>())
+		{
+			Manager->RegisterBody(this);
+		}
 	}
 }
 
-void UCubeNinjaBodyComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCubeNinjaBodyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	UpdateLimbSwing(DeltaTime);
+	if (UWorld* World = GetWorld())
+	{
+		if (UCubeNinjaBodyManager* Manager = World->GetSubsystem<UCubeNinjaBodyManager>())
+		{
+			Manager->UnregisterBody(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UCubeNinjaBodyComponent::RebuildBody()
 {
+	COMBAT_SCOPE(CubeNinjaRebuild);
+	LLM_SCOPE_BYTAG(Combat_ProceduralMesh);
+
 	// Safety check
 	if (PartMeshes.Num() == 0 || PartPivots.Num() == 0)
 		return;
 
 	const float S = BodyScale;
-	for (int32 i = 0; i < PartMeshes.Num(); ++i)
-	{
-		if (!IsValid(PartMeshes[i])) continue;
-		if (PartIsSphere.IsValidIndex(i) && PartIsSphere[i] && PartRadii.IsValidIndex(i))
-			BuildSphereInMesh(PartMeshes[i], PartRadii[i] * S);
-		else if (PartHalfExtents.IsValidIndex(i))
-			BuildCubeInMesh(PartMeshes[i], PartHalfExtents[i] * S);
-	}
 	for (int32 i = 0; i < PartPivots.Num(); ++i)
 	{
 		if (IsValid(PartPivots[i]) && PartLocations.IsValidIndex(i))
 			PartPivots[i]->SetRelativeLocation(PartLocations[i] * S);
 	}
-}
 
-void UCubeNinjaBodyComponent::BuildCubeInMesh(UProceduralMeshComponent* Mesh, const FVector& HalfExtents)
-{
-	if (!IsValid(Mesh)) return;
-	const float Hx = HalfExtents.X, Hy = HalfExtents.Y, Hz = HalfExtents.Z;
-	FVector V[8] = {
-		FVector(-Hx, -Hy, -Hz), FVector(Hx, -Hy, -Hz), FVector(Hx, Hy, -Hz), FVector(-Hx, Hy, -Hz),
-		FVector(-Hx, -Hy, Hz),  FVector(Hx, -Hy, Hz),  FVector(Hx, Hy, Hz),  FVector(-Hx, Hy, Hz)
-	};
-	TArray<FVector> Vertices, Normals;
-	TArray<int32> Triangles;
-	TArray<FVector2D> UV0;
-	auto AddQuad = [&](int32 A, int32 B, int32 C, int32 D, const FVector& N) {
-		int32 Base = Vertices.Num();
-		Vertices.Add(V[A]); Vertices.Add(V[B]); Vertices.Add(V[C]); Vertices.Add(V[D]);
-		Normals.Add(N); Normals.Add(N); Normals.Add(N); Normals.Add(N);
-		UV0.Add(FVector2D(0,0)); UV0.Add(FVector2D(1,0)); UV0.Add(FVector2D(1,1)); UV0.Add(FVector2D(0,1));
-		Triangles.Add(Base+0); Triangles.Add(Base+1); Triangles.Add(Base+2);
-		Triangles.Add(Base+0); Triangles.Add(Base+2); Triangles.Add(Base+3);
-	};
-	AddQuad(4, 5, 6, 7, FVector(0, 0, 1));
-	AddQuad(1, 0, 3, 2, FVector(0, 0, -1));
-	AddQuad(0, 4, 7, 3, FVector(-1, 0, 0));
-	AddQuad(5, 1, 2, 6, FVector(1, 0, 0));
-	AddQuad(7, 6, 2, 3, FVector(0, 1, 0));
-	AddQuad(0, 1, 5, 4, FVector(0, -1, 0));
-	Mesh->ClearAllMeshSections();
-	Mesh->CreateMeshSection(0, Vertices, Triangles, Normals, UV0, TArray<FColor>(), TArray<FProcMeshTangent>(), true);
-	Mesh->SetMaterial(0, CubeMaterial);
-}
+	// copy the shape table so the worker never reads the component
+	const uint32 Serial = ++BuildSerial;
+	TArray<bool> IsSphere = PartIsSphere;
+	TArray<FVector> HalfExtents = PartHalfExtents;
+	TArray<float> Radii = PartRadii;
+	const int32 Num = PartMeshes.Num();
 
-void UCubeNinjaBodyComponent::BuildSphereInMesh(UProceduralMeshComponent* Mesh, float Radius, int32 Segments)
-{
-	if (!IsValid(Mesh) || Radius <= 0.f) return;
-	TArray<FVector> Vertices, Normals;
-	TArray<int32> Triangles;
-	TArray<FVector2D> UV0;
-	const int32 RingCount = FMath::Max(2, Segments);
-	const int32 SectCount = FMath::Max(3, Segments * 2);
-	for (int32 Ring = 0; Ring <= RingCount; ++Ring)
-	{
-		const float Phi = PI * (float)Ring / (float)RingCount;
-		const float Y = -FMath::Cos(Phi);
-		const float RingR = FMath::Sin(Phi);
-		for (int32 Sect = 0; Sect <= SectCount; ++Sect)
+	TWeakObjectPtr<UCubeNinjaBodyComponent> WeakThis(this);
+	FCPPd1ProceduralGeometry::BuildAsync(
+		[Num, S, IsSphere = MoveTemp(IsSphere), HalfExtents = MoveTemp(HalfExtents), Radii = MoveTemp(Radii)](TArray<FCPPd1ProceduralMeshData>& OutSections)
 		{
-			const float Theta = 2.f * PI * (float)Sect / (float)SectCount;
-			const float X = RingR * FMath::Cos(Theta);
-			const float Z = RingR * FMath::Sin(Theta);
-			FVector N(X, Z, Y);
-			N.Normalize();
-			Vertices.Add(N * Radius);
-			Normals.Add(N);
-			UV0.Add(FVector2D((float)Sect / (float)SectCount, (float)Ring / (float)RingCount));
-		}
-	}
-	for (int32 Ring = 0; Ring < RingCount; ++Ring)
-		for (int32 Sect = 0; Sect < SectCount; ++Sect)
+			SCOPE_CYCLE_COUNTER(STAT_CombatCubeNinjaRebuild);
+			LLM_SCOPE_BYTAG(Combat_ProceduralMesh);
+
+			OutSections.SetNum(Num);
+			for (int32 i = 0; i < Num; ++i)
+			{
+				if (IsSphere.IsValidIndex(i) && IsSphere[i] && Radii.IsValidIndex(i))
+					FCPPd1ProceduralGeometry::AppendSphere(OutSections[i], Radii[i] * S);
+				else if (HalfExtents.IsValidIndex(i))
+					FCPPd1ProceduralGeometry::AppendBox(OutSections[i], HalfExtents[i] * S);
+			}
+		},
+		[WeakThis, Serial](TArray<FCPPd1ProceduralMeshData>&& Sections)
 		{
-			const int32 A = Ring * (SectCount + 1) + Sect;
-			const int32 B = A + 1;
-			const int32 C = A + (SectCount + 1);
-			const int32 D = C + 1;
-			Triangles.Add(A); Triangles.Add(C); Triangles.Add(B);
-			Triangles.Add(B); Triangles.Add(C); Triangles.Add(D);
-		}
-	Mesh->ClearAllMeshSections();
-	Mesh->CreateMeshSection(0, Vertices, Triangles, Normals, UV0, TArray<FColor>(), TArray<FProcMeshTangent>(), true);
-	Mesh->SetMaterial(0, CubeMaterial);
+			UCubeNinjaBodyComponent* Body = WeakThis.Get();
+			if (Body && Body->BuildSerial == Serial)
+			{
+				Body->CommitPartMeshes(MoveTemp(Sections));
+			}
+		});
 }
 
-void UCubeNinjaBodyComponent::UpdateLimbSwing(float DeltaTime)
+void UCubeNinjaBodyComponent::CommitPartMeshes(TArray<FCPPd1ProceduralMeshData>&& Sections)
 {
-	// Safety checks
-	if (!IsValid(this) || !GetOwner())
-		return;
-
-	ACharacter* Char = Cast<ACharacter>(GetOwner());
-	if (!Char)
-		return;
+	COMBAT_SCOPE(CubeNinjaRebuild);
+	LLM_SCOPE_BYTAG(Combat_ProceduralMesh);
 
-	UCharacterMovementComponent* Movement = Char->GetCharacterMovement();
-	const float Speed = Movement ? Movement->Velocity.Size2D() : 0.f;
-	const bool bMoving = Speed > 10.f;
-	if (bMoving)
-		WalkCycleTime += DeltaTime * LimbSwingSpeed * 2.f * PI;
-	else
-		WalkCycleTime = FMath::FInterpTo(WalkCycleTime, 0.f, DeltaTime, 5.f);
-	const float Swing = FMath::Sin(WalkCycleTime) * LimbSwingAmount;
-	const float SwingLeg = FMath::Sin(WalkCycleTime + PI) * LimbSwingAmount;
-
-	// Safety check for arrays
-	if (!PartPivots.IsValidIndex(0) || PartPivots.Num() == 0)
-		return;
-
-	for (int32 Idx : SwingPartIndices)
+	for (int32 i = 0; i < PartMeshes.Num() && i < Sections.Num(); ++i)
 	{
-		if (PartPivots.IsValidIndex(Idx) && IsValid(PartPivots[Idx]))
-		{
-			FRotator R = PartDefaultRotations.IsValidIndex(Idx) ? PartDefaultRotations[Idx] : FRotator::ZeroRotator;
-			if (Idx == L_UA || Idx == R_UA)
-				R += FRotator(Idx == L_UA ? Swing : -Swing, 0.f, 0.f);
-			else
-				R += FRotator(Idx == L_UL ? SwingLeg : -SwingLeg, 0.f, 0.f);
-			PartPivots[Idx]->SetRelativeRotation(R);
-		}
+		UProceduralMeshComponent* Mesh = PartMeshes[i];
+		if (!IsValid(Mesh) || Sections[i].Vertices.Num() == 0) continue;
+
+		const FCPPd1ProceduralMeshData& Data = Sections[i];
+		Mesh->ClearAllMeshSections();
+		Mesh->CreateMeshSection(0, Data.Vertices, Data.Triangles, Data.Normals, Data.UV0, TArray<FColor>(), TArray<FProcMeshTangent>(), true);
+		Mesh->SetMaterial(0, CubeMaterial);
 	}
 }
@@ -9,11 +9,14 @@
 
 class UProceduralMeshComponent;
 class UMaterialInterface;
+class UCharacterMovementComponent;
+struct FCPPd1ProceduralMeshData;
 
 /**
  * A ninja "model" made of interlocking procedural shapes: spheres for head, pelvis, and joints
  * (shoulders, elbows, hands, knees, feet); tiny cubes for spine, chest, and limb segments.
  * Add to a Character; limb segments are driven by simple procedural motion (walk swing).
+ * Limb swing is updated for all bodies at once by UCubeNinjaBodyManager; the component itself doesn't tick.
  */
 UCLASS(ClassGroup = (Procedural), meta = (BlueprintSpawnableComponent))
 class CPPd1_API UCubeNinjaBodyComponent : public USceneComponent
@@ -35,18 +38,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cube Ninja|Motion", meta = (ClampMin = 0.1f, Units = "Hz"))
 	float LimbSwingSpeed = 2.0f;
 
+	/** Skip limb swing when no player camera is within this distance (0 = never distance-cull). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cube Ninja|Motion", meta = (ClampMin = 0.0f, Units = "cm"))
+	float SwingCullDistance = 5000.0f;
+
+	/** Skip limb swing while the owner hasn't been rendered recently (off-screen in every view). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cube Ninja|Motion")
+	bool bSkipSwingWhenNotRendered = true;
+
 	/** Optional material applied to all cube segments (if null, uses default which may appear black). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cube Ninja")
 	TObjectPtr<UMaterialInterface> CubeMaterial;
 
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	/** Rebuild all cube meshes (e.g. after changing BodyScale). */
+	/** Rebuild all cube meshes (e.g. after changing BodyScale). Geometry is generated off the game thread and committed when ready. */
 	UFUNCTION(BlueprintCallable, Category = "Cube Ninja")
 	void RebuildBody();
 
 protected:
+	friend class UCubeNinjaBodyManager;
+
 	UPROPERTY()
 	TArray<TObjectPtr<USceneComponent>> PartPivots;
 	UPROPERTY()
@@ -63,7 +76,12 @@ protected:
 
 	float WalkCycleTime = 0.0f;
 
-	void BuildCubeInMesh(UProceduralMeshComponent* Mesh, const FVector& HalfExtents);
-	void BuildSphereInMesh(UProceduralMeshComponent* Mesh, float Radius, int32 Segments = 12);
-	void UpdateLimbSwing(float DeltaTime);
+	/** Owner's movement component, resolved once on BeginPlay (read by the body manager each frame) */
+	TWeakObjectPtr<UCharacterMovementComponent> CachedMovement;
+
+	/** Bumped by every RebuildBody so a late async result from an older rebuild is dropped */
+	uint32 BuildSerial = 0;
+
+	/** Create the finished part sections on the game thread (collision cooks asynchronously) */
+	void CommitPartMeshes(TArray<FCPPd1ProceduralMeshData>&& Sections);
 };
@@ -0,0 +1,193 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CubeNinjaBodyManager.h"
+#include "CubeNinjaBodyComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+namespace
+{
+	/** Below this many bodies the parallel dispatch costs more than it saves */
+	const int32 SwingMinBatchSize = 16;
+
+	/** Owner speed above which the walk cycle advances */
+	const float SwingMinSpeed = 10.0f;
+}
+
+void UCubeNinjaBodyManager::RegisterBody(UCubeNinjaBodyComponent* Body)
+{
+	if (IsValid(Body))
+	{
+		Bodies.AddUnique(Body);
+	}
+}
+
+void UCubeNinjaBodyManager::UnregisterBody(UCubeNinjaBodyComponent* Body)
+{
+	Bodies.RemoveSingleSwap(Body);
+}
+
+bool UCubeNinjaBodyManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UCubeNinjaBodyManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCubeNinjaBodyManager, STATGROUP_Combat);
+}
+
+void UCubeNinjaBodyManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Bodies.RemoveAllSwap([](const TObjectPtr<UCubeNinjaBodyComponent>& Body) { return !IsValid(Body); });
+	if (Bodies.Num() == 0)
+	{
+		return;
+	}
+
+	GatherSlots();
+
+	// pure math over packed data; no UObject access inside the loop
+	ParallelFor(TEXT("CubeNinjaLimbSwing"), Slots.Num(), SwingMinBatchSize, [this, DeltaTime](int32 Index)
+	{
+		FCubeNinjaSwingSlot& Slot = Slots[Index];
+		if (!Slot.bRelevant)
+		{
+			return;
+		}
+
+		if (Slot.Speed > SwingMinSpeed)
+		{
+			// keep the phase wrapped so precision doesn't degrade on long walks
+			Slot.WalkCycleTime = FMath::Fmod(Slot.WalkCycleTime + DeltaTime * Slot.SwingSpeed * 2.0f * PI, 2.0f * PI);
+		}
+		else
+		{
+			Slot.WalkCycleTime = FMath::FInterpTo(Slot.WalkCycleTime, 0.0f, DeltaTime, 5.0f);
+		}
+
+		const float Swing = FMath::Sin(Slot.WalkCycleTime) * Slot.SwingAmount;
+		const float SwingLeg = FMath::Sin(Slot.WalkCycleTime + PI) * Slot.SwingAmount;
+		Slot.SwingPitch[0] = Swing;
+		Slot.SwingPitch[1] = -Swing;
+		Slot.SwingPitch[2] = SwingLeg;
+		Slot.SwingPitch[3] = -SwingLeg;
+	});
+
+	ApplySlots();
+}
+
+void UCubeNinjaBodyManager::GatherSlots()
+{
+	UWorld* World = GetWorld();
+
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->PlayerCameraManager)
+		{
+			ViewLocations.Add(PC->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	Slots.SetNum(Bodies.Num(), EAllowShrinking::No);
+
+	for (int32 i = 0; i < Bodies.Num(); ++i)
+	{
+		const UCubeNinjaBodyComponent* Body = Bodies[i];
+		FCubeNinjaSwingSlot& Slot = Slots[i];
+
+		Slot.bRelevant = false;
+
+		const UCharacterMovementComponent* Movement = Body->CachedMovement.Get();
+		const AActor* Owner = Body->GetOwner();
+		if (!Movement || !Owner)
+		{
+			continue;
+		}
+
+		// skip bodies the renderer hasn't drawn recently
+		if (Body->bSkipSwingWhenNotRendered && !Owner->WasRecentlyRendered(0.2f))
+		{
+			continue;
+		}
+
+		// skip bodies beyond the cull distance from every player camera
+		if (Body->SwingCullDistance > 0.0f && ViewLocations.Num() > 0)
+		{
+			const FVector BodyLocation = Body->GetComponentLocation();
+			const float CullDistSq = FMath::Square(Body->SwingCullDistance);
+
+			bool bInRange = false;
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				if (FVector::DistSquared(BodyLocation, ViewLocation) <= CullDistSq)
+				{
+					bInRange = true;
+					break;
+				}
+			}
+
+			if (!bInRange)
+			{
+				continue;
+			}
+		}
+
+		Slot.Speed = Movement->Velocity.Size2D();
+		Slot.SwingAmount = Body->LimbSwingAmount;
+		Slot.SwingSpeed = Body->LimbSwingSpeed;
+		Slot.WalkCycleTime = Body->WalkCycleTime;
+		Slot.bRelevant = true;
+	}
+}
+
+void UCubeNinjaBodyManager::ApplySlots()
+{
+	for (int32 i = 0; i < Bodies.Num(); ++i)
+	{
+		const FCubeNinjaSwingSlot& Slot = Slots[i];
+		if (!Slot.bRelevant)
+		{
+			continue;
+		}
+
+		UCubeNinjaBodyComponent* Body = Bodies[i];
+		Body->WalkCycleTime = Slot.WalkCycleTime;
+
+		const int32 NumSwingParts = FMath::Min(Body->SwingPartIndices.Num(), 4);
+		for (int32 k = 0; k < NumSwingParts; ++k)
+		{
+			const int32 PartIndex = Body->SwingPartIndices[k];
+			if (!Body->PartPivots.IsValidIndex(PartIndex))
+			{
+				continue;
+			}
+
+			USceneComponent* Pivot = Body->PartPivots[PartIndex];
+			if (!IsValid(Pivot))
+			{
+				continue;
+			}
+
+			FRotator NewRotation = Body->PartDefaultRotations.IsValidIndex(PartIndex) ? Body->PartDefaultRotations[PartIndex] : FRotator::ZeroRotator;
+			NewRotation.Pitch += Slot.SwingPitch[k];
+
+			// idle bodies settle on their default pose; don't touch the hierarchy if nothing moved
+			if (Pivot->GetRelativeRotation().Equals(NewRotation, 0.01f))
+			{
+				continue;
+			}
+
+			// write the rotation without the per-call overlap/physics path, then propagate once down this limb
+			Pivot->SetRelativeRotation_Direct(NewRotation);
+			Pivot->UpdateComponentToWorld();
+		}
+	}
+}
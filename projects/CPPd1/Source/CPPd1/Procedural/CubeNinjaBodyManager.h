@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CubeNinjaBodyManager.generated.h"
+
+class UCubeNinjaBodyComponent;
+
+/** Packed per-body limb swing data, filled on the game thread and computed in parallel. */
+struct FCubeNinjaSwingSlot
+{
+	/** Owner's horizontal speed this frame */
+	float Speed = 0.0f;
+	float SwingAmount = 0.0f;
+	float SwingSpeed = 0.0f;
+	float WalkCycleTime = 0.0f;
+
+	/** Pitch offsets for L_UpperArm, R_UpperArm, L_UpperLeg, R_UpperLeg (same order as SwingPartIndices) */
+	float SwingPitch[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	/** false = off-screen or beyond cull distance; skipped by compute and apply */
+	bool bRelevant = false;
+};
+
+/**
+ * Drives the walk-cycle limb swing of every cube-ninja body in the world in one pass.
+ * Bodies register on BeginPlay; each frame the manager gathers velocities into a packed array,
+ * computes phases and limb pitches with ParallelFor, then applies the pivot rotations in a single
+ * batched loop. Bodies that are off-screen or farther than their cull distance from every player camera are skipped.
+ */
+UCLASS()
+class CPPd1_API UCubeNinjaBodyManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Add a body to the batched update */
+	void RegisterBody(UCubeNinjaBodyComponent* Body);
+
+	/** Remove a body from the batched update */
+	void UnregisterBody(UCubeNinjaBodyComponent* Body);
+
+	/** Number of bodies currently registered */
+	int32 GetNumBodies() const { return Bodies.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registered bodies, index-aligned with Slots during a tick */
+	UPROPERTY()
+	TArray<TObjectPtr<UCubeNinjaBodyComponent>> Bodies;
+
+	/** Packed swing data (reused every frame to avoid allocations) */
+	TArray<FCubeNinjaSwingSlot> Slots;
+
+	/** Player camera locations gathered once per frame for distance culling */
+	TArray<FVector> ViewLocations;
+
+	/** Fill Slots from the registered bodies (game thread) */
+	void GatherSlots();
+
+	/** Write computed rotations back to the pivots (game thread) */
+	void ApplySlots();
+};
@@ -2,19 +2,26 @@
 
 
 #include "CombatEnemy.h"
+#include "CPPd1.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CombatAIController.h"
-#include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
-#include "CombatLifeBar.h"
+#include "CombatLifeBarOverlay.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
 #include "CPPd1LockOnTargetComponent.h"
+#include "CombatSimulation.h"
+#include "CombatInputRecorder.h"
+#include "CombatHitchDetector.h"
+#include "CombatAssetLoader.h"
+#include "CombatSpatialIndex.h"
 
 ACombatEnemy::ACombatEnemy()
 {
+	LLM_SCOPE_BYTAG(Combat_Enemies);
+
 	PrimaryActorTick.bCanEverTick = true;
 
 	// bind the attack montage ended delegate
@@ -29,9 +36,10 @@ ACombatEnemy::ACombatEnemy()
 	// ignore the controller's yaw rotation
 	bUseControllerRotationYaw = false;
 
-	// create the life bar
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
+	// create the life bar anchor (drawn by the life bar overlay)
+	LifeBar = CreateDefaultSubobject<USceneComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
+	LifeBar->SetRelativeLocation(FVector(0.0f, 0.0f, 110.0f));
 
 	// create the lock-on target component
 	LockOnTargetComponent = CreateDefaultSubobject<UCPPd1LockOnTargetComponent>(TEXT("LockOnTargetComponent"));
@@ -58,7 +66,7 @@ void ACombatEnemy::DoAIComboAttack()
 	bIsAttacking = true;
 
 	// choose how many times we're going to attack
-	TargetComboCount = FMath::RandRange(1, ComboSectionNames.Num() - 1);
+	TargetComboCount = AIRandom.RandRange(1, ComboSectionNames.Num() - 1);
 
 	// reset the attack counter
 	CurrentComboAttack = 0;
@@ -66,13 +74,14 @@ void ACombatEnemy::DoAIComboAttack()
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ComboAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		UAnimMontage* Montage = UCombatAssetLoader::Resolve(ComboAttackMontage);
+		const float MontageLength = AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, Montage);
 		}
 	}
 }
@@ -89,7 +98,7 @@ void ACombatEnemy::DoAIChargedAttack()
 	bIsAttacking = true;
 
 	// choose how many loops are we going to charge for
-	TargetChargeLoops = FMath::RandRange(MinChargeLoops, MaxChargeLoops);
+	TargetChargeLoops = AIRandom.RandRange(MinChargeLoops, MaxChargeLoops);
 
 	// reset the charge loop counter
 	CurrentChargeLoop = 0;
@@ -97,13 +106,14 @@ void ACombatEnemy::DoAIChargedAttack()
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		UAnimMontage* Montage = UCombatAssetLoader::Resolve(ChargedAttackMontage);
+		const float MontageLength = AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, Montage);
 		}
 	}
 }
@@ -117,8 +127,33 @@ void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 	OnAttackCompleted.ExecuteIfBound();
 }
 
+void ACombatEnemy::GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	OutPaths.Add(ComboAttackMontage.ToSoftObjectPath());
+	OutPaths.Add(ChargedAttackMontage.ToSoftObjectPath());
+}
+
+void ACombatEnemy::ExportSimulationTuning(FCombatSimFighterTuning& Out) const
+{
+	// enemies have no stamina/flow/skill components and flinch out of their attacks
+	Out.bHasCombatSystems = false;
+	Out.bInterruptedByHits = true;
+
+	Out.MaxHP = MaxHP;
+	Out.MeleeDamage = MeleeDamage;
+
+	// same combo length roll as DoAIComboAttack
+	Out.bRandomComboLength = true;
+	Out.ComboStages = FMath::Max(1, ComboSectionNames.Num());
+	Out.MinChargeLoops = MinChargeLoops;
+	Out.MaxChargeLoops = MaxChargeLoops;
+}
+
 void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 {
+	COMBAT_SCOPE(AttackTrace);
+	INC_DWORD_STAT(STAT_CombatAttackTraces);
+
 	// sweep for objects in front of the character to be hit by the attack
 	TArray<FHitResult> OutHits;
 
@@ -174,7 +209,7 @@ void ACombatEnemy::CheckCombo()
 		// jump to the next attack section
 		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 		{
-			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage);
+			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage.Get());
 		}
 	}
 }
@@ -187,13 +222,14 @@ void ACombatEnemy::CheckChargedAttack()
 	// jump to either the loop or attack section of the montage depending on whether we hit the loop target
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage);
+		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage.Get());
 	}
 }
 
 void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
-	
+	COMBAT_SCOPE(ApplyDamage);
+
 	// pass the damage event to the actor
 	FDamageEvent DamageEvent;
 	const float ActualDamage = TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
@@ -211,11 +247,17 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 			GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(), DamageLocation);
 		}
 
-		// stop the attack montages to interrupt the attack
+		// stop the attack montages to interrupt the attack (one that isn't loaded can't be playing)
 		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 		{
-			AnimInstance->Montage_Stop(0.1f, ComboAttackMontage);
-			AnimInstance->Montage_Stop(0.1f, ChargedAttackMontage);
+			if (UAnimMontage* Montage = ComboAttackMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, Montage);
+			}
+			if (UAnimMontage* Montage = ChargedAttackMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, Montage);
+			}
 		}
 
 		// pass control to BP to play effects, etc.
@@ -226,7 +268,10 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 void ACombatEnemy::HandleDeath()
 {
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->SetBarHidden(LifeBarHandle, true);
+	}
 
 	// disable the collision capsule to avoid being hit again while dead
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -237,6 +282,14 @@ void ACombatEnemy::HandleDeath()
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
 
+	// dead enemies don't crowd positioning queries
+	UCombatSpatialIndex::Unregister(this);
+
+	DEC_DWORD_STAT(STAT_CombatEnemiesAlive);
+	INC_DWORD_STAT(STAT_CombatActiveRagdolls);
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::EnemyDied, this);
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::RagdollOn, this);
+
 	// call the died delegate to notify any subscribers
 	OnEnemyDied.Broadcast(this);
 
@@ -251,6 +304,8 @@ void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
 
 void ACombatEnemy::RemoveFromLevel()
 {
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::EnemyRemoved, this);
+
 	// destroy this actor
 	Destroy();
 }
@@ -275,7 +330,10 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+		{
+			Overlay->SetBarPercent(LifeBarHandle, CurrentHP / MaxHP);
+		}
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -303,24 +361,52 @@ void ACombatEnemy::Landed(const FHitResult& Hit)
 
 void ACombatEnemy::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Combat_Enemies);
+
 	// reset HP to maximum
 	CurrentHP = MaxHP;
 
+	// seed before the StateTree starts so its first attack roll is reproducible
+	AIRandom.Initialize(UCombatInputRecorder::MakeRandomSeed(this));
+
 	// we top the HP before BeginPlay so StateTree picks it up at the right value
 	Super::BeginPlay();
 
-	// get the life bar widget from the widget comp
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
+	// register a full life bar with the overlay
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		LifeBarHandle = Overlay->RegisterBar(LifeBar, LifeBarColor);
+	}
+
+	UCombatSpatialIndex::Register(this);
 
-	// fill the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	INC_DWORD_STAT(STAT_CombatEnemiesAlive);
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::EnemySpawned, this);
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// release the life bar
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->UnregisterBar(LifeBarHandle);
+	}
+	LifeBarHandle = INDEX_NONE;
+
+	UCombatSpatialIndex::Unregister(this);
+
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// HandleDeath already moved dead enemies from alive to ragdoll
+	if (CurrentHP > 0.0f)
+	{
+		DEC_DWORD_STAT(STAT_CombatEnemiesAlive);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_CombatActiveRagdolls);
+	}
 }
@@ -8,11 +8,11 @@
 #include "CombatDamageable.h"
 #include "Animation/AnimMontage.h"
 #include "Engine/TimerHandle.h"
+#include "Math/RandomStream.h"
 #include "CombatEnemy.generated.h"
 
-class UWidgetComponent;
-class UCombatLifeBar;
 class UAnimMontage;
+struct FCombatSimFighterTuning;
 
 /** Completed attack animation delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyAttackCompleted);
@@ -32,9 +32,9 @@ class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDa
 {
 	GENERATED_BODY()
 
-	/** Life bar widget component */
+	/** Life bar anchor. The bar itself is drawn by the UCombatLifeBarOverlay subsystem */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
+	USceneComponent* LifeBar;
 
 	/** Lock-on target component - makes this enemy a valid lock-on target */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
@@ -63,9 +63,12 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
+	/** Life bar fill color */
 	UPROPERTY(EditAnywhere, Category="Damage")
-	UCombatLifeBar* LifeBarWidget;
+	FLinearColor LifeBarColor = FLinearColor::Red;
+
+	/** Handle of this enemy's bar in the life bar overlay */
+	int32 LifeBarHandle = INDEX_NONE;
 
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
@@ -90,9 +93,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 350.0f;
 
-	/** AnimMontage that will play for combo attacks */
+	/** AnimMontage that will play for combo attacks. Soft: preloaded by the variant's bundles and the spawners */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
-	UAnimMontage* ComboAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ComboAttackMontage;
 
 	/** Names of the AnimMontage sections that correspond to each stage of the combo attack */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
@@ -104,9 +107,9 @@ protected:
 	/** Index of the current stage of the melee attack combo */
 	int32 CurrentComboAttack = 0;
 
-	/** AnimMontage that will play for charged attacks */
+	/** AnimMontage that will play for charged attacks. Soft: preloaded by the variant's bundles and the spawners */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
-	UAnimMontage* ChargedAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ChargedAttackMontage;
 
 	/** Name of the AnimMontage section that corresponds to the charge loop */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
@@ -130,6 +133,9 @@ protected:
 	/** Number of charge animation loop currently playing */
 	int32 CurrentChargeLoop = 0;
 
+	/** Combo and charge rolls; seeded from the input recorder's session seed so replays make the same choices */
+	FRandomStream AIRandom;
+
 	/** Time to wait before removing this character from the level after it dies */
 	UPROPERTY(EditAnywhere, Category="Death")
 	float DeathRemovalTime = 5.0f;
@@ -162,6 +168,12 @@ public:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+	/** Soft assets this class needs during play; preloaded with the variant's Game bundle and by the spawners */
+	void GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
+	/** Copies this enemy's tuning into the headless combat simulator's fighter description */
+	void ExportSimulationTuning(FCombatSimFighterTuning& Out) const;
+
 public:
 
 	// ~begin ICombatAttacker interface
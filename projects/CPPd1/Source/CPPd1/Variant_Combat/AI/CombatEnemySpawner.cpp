@@ -2,11 +2,14 @@
 
 
 #include "CombatEnemySpawner.h"
+#include "CPPd1.h"
 #include "Components/SceneComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatAssetLoader.h"
+#include "CPPd1RoundSnapshot.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -29,8 +32,23 @@ ACombatEnemySpawner::ACombatEnemySpawner()
 
 void ACombatEnemySpawner::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Combat_Spawners);
+
 	Super::BeginPlay();
-	
+
+	// load the enemy class in the background, then hold it together with the montages it declares
+	EnemyClassHandle = UCombatAssetLoader::RequestAssets({ EnemyClass.ToSoftObjectPath() });
+	if (EnemyClassHandle)
+	{
+		// an already-complete handle doesn't take a delegate; it's loaded, so go straight on
+		if (!EnemyClassHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ACombatEnemySpawner::HandleEnemyClassLoaded)))
+		{
+			HandleEnemyClassLoaded();
+		}
+	}
+
+	UCPPd1RoundSnapshot::Register(this);
+
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
@@ -46,24 +64,49 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 	// clear the spawn timer
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	UCPPd1RoundSnapshot::Unregister(this);
+
+	for (TSharedPtr<FStreamableHandle>* Handle : { &EnemyClassHandle, &EnemyAssetsHandle })
+	{
+		if (Handle->IsValid())
+		{
+			(*Handle)->CancelHandle();
+			Handle->Reset();
+		}
+	}
+}
+
+void ACombatEnemySpawner::HandleEnemyClassLoaded()
+{
+	if (const UClass* Class = EnemyClass.Get())
+	{
+		TArray<FSoftObjectPath> Paths;
+		GetDefault<ACombatEnemy>(Class)->GatherPreloadAssets(Paths);
+		EnemyAssetsHandle = UCombatAssetLoader::RequestAssets(MoveTemp(Paths));
+	}
 }
 
 void ACombatEnemySpawner::SpawnEnemy()
 {
-	// ensure the enemy class is valid
-	if (IsValid(EnemyClass))
+	// the spawned enemy and everything it allocates on spawn count as enemy memory
+	LLM_SCOPE_BYTAG(Combat_Enemies);
+
+	// ensure the enemy class is valid. It normally finished loading during the initial spawn delay
+	if (UClass* Class = UCombatAssetLoader::Resolve(EnemyClass))
 	{
 		// spawn the enemy at the reference capsule's transform
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(Class, SpawnCapsule->GetComponentTransform(), SpawnParams);
 
 		// was the enemy successfully created?
 		if (SpawnedEnemy)
 		{
 			// subscribe to the death delegate
 			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			CurrentEnemy = SpawnedEnemy;
 		}
 	}
 }
@@ -123,3 +166,37 @@ void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
 {
 	// stub
 }
+
+void ACombatEnemySpawner::CaptureRoundState()
+{
+	RoundStartSpawnCount = SpawnCount;
+	bRoundStartActivated = bHasBeenActivated;
+}
+
+void ACombatEnemySpawner::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	SetActorTransform(RoundStartTransform);
+
+	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	// this round's enemy goes; stop listening first so its removal doesn't count as a kill
+	if (ACombatEnemy* Enemy = CurrentEnemy.Get())
+	{
+		Enemy->OnEnemyDied.RemoveDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+		Enemy->Destroy();
+	}
+	CurrentEnemy.Reset();
+
+	SpawnCount = RoundStartSpawnCount;
+	bHasBeenActivated = bRoundStartActivated;
+
+	// start over the way the round did
+	if (bShouldSpawnEnemiesImmediately)
+	{
+		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+	}
+	else if (bHasBeenActivated)
+	{
+		SpawnEnemy();
+	}
+}
@@ -5,11 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "CPPd1RoundResettable.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
 class UArrowComponent;
 class ACombatEnemy;
+struct FStreamableHandle;
 
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
@@ -18,7 +20,7 @@ class ACombatEnemy;
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
  */
 UCLASS(abstract)
-class ACombatEnemySpawner : public AActor, public ICombatActivatable
+class ACombatEnemySpawner : public AActor, public ICombatActivatable, public ICPPd1RoundResettable
 {
 	GENERATED_BODY()
 	
@@ -30,9 +32,9 @@ class ACombatEnemySpawner : public AActor, public ICombatActivatable
 
 protected:
 
-	/** Type of enemy to spawn */
+	/** Type of enemy to spawn. Soft: loaded in the background on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
-	TSubclassOf<ACombatEnemy> EnemyClass;
+	TSoftClassPtr<ACombatEnemy> EnemyClass;
 
 	/** If true, the first enemy will be spawned as soon as the game starts */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
@@ -64,6 +66,17 @@ protected:
 	/** Timer to spawn enemies after a delay */
 	FTimerHandle SpawnTimer;
 
+	/** Keep the enemy class and the montages it declares loaded while the spawner exists; cancelled on EndPlay */
+	TSharedPtr<FStreamableHandle> EnemyClassHandle;
+	TSharedPtr<FStreamableHandle> EnemyAssetsHandle;
+
+	/** Enemy currently out in the level, if any */
+	TWeakObjectPtr<ACombatEnemy> CurrentEnemy;
+
+	/** SpawnCount and bHasBeenActivated when the round snapshot was taken */
+	int32 RoundStartSpawnCount = 0;
+	bool bRoundStartActivated = false;
+
 public:	
 	
 	/** Constructor */
@@ -79,6 +92,9 @@ public:
 
 protected:
 
+	/** Class load finished; request the enemy's montages */
+	void HandleEnemyClassLoaded();
+
 	/** Spawn an enemy and subscribe to its death event */
 	void SpawnEnemy();
 
@@ -106,4 +122,13 @@ public:
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) override;
 
 	// ~end IActivatable interface
+
+	// ~begin ICPPd1RoundResettable interface
+
+	virtual void CaptureRoundState() override;
+
+	/** Removes the current enemy and starts spawning again the way BeginPlay or activation did */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+
+	// ~end ICPPd1RoundResettable interface
 };
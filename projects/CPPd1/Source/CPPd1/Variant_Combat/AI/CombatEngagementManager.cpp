@@ -43,6 +43,8 @@ void UCombatEngagementManager::TickComponent(float DeltaTime, ELevelTick TickTyp
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	COMBAT_SCOPE(EngagementUpdate);
+
 	// Auto-start next engagement if current is done and queue has enemies
 	if (!IsEngagementActive() && EnemyQueue.Num() > 0)
 	{
@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSpatialIndex.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+void UCombatSpatialIndex::Register(AActor* Enemy)
+{
+	if (UCombatSpatialIndex* Index = Get(Enemy))
+	{
+		Index->AddEnemy(Enemy);
+	}
+}
+
+void UCombatSpatialIndex::Unregister(AActor* Enemy)
+{
+	if (UCombatSpatialIndex* Index = Get(Enemy))
+	{
+		Index->RemoveEnemy(Enemy);
+	}
+}
+
+UCombatSpatialIndex* UCombatSpatialIndex::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatSpatialIndex>() : nullptr;
+}
+
+const AActor* UCombatSpatialIndex::ResolveQuerier(const UObject* Owner)
+{
+	if (const AController* Controller = Cast<AController>(Owner))
+	{
+		return Controller->GetPawn();
+	}
+	return Cast<AActor>(Owner);
+}
+
+void UCombatSpatialIndex::AddEnemy(AActor* Enemy)
+{
+	if (!Enemy || Enemies.Contains(Enemy))
+	{
+		return;
+	}
+
+	Enemies.Add(Enemy);
+	EnemyPositions.Add(Enemy->GetActorLocation());
+}
+
+void UCombatSpatialIndex::RemoveEnemy(AActor* Enemy)
+{
+	const int32 Slot = Enemies.IndexOfByKey(Enemy);
+	if (Slot != INDEX_NONE)
+	{
+		Enemies.RemoveAtSwap(Slot);
+		EnemyPositions.RemoveAtSwap(Slot);
+	}
+}
+
+bool UCombatSpatialIndex::IsRegistered(const AActor* Actor) const
+{
+	return Actor && Enemies.Contains(Actor);
+}
+
+void UCombatSpatialIndex::Refresh()
+{
+	if (RefreshedFrame == GFrameCounter)
+	{
+		return;
+	}
+	RefreshedFrame = GFrameCounter;
+
+	FrameSlots.Reset();
+	FrameCrowding.Reset();
+
+	for (int32 Slot = Enemies.Num() - 1; Slot >= 0; --Slot)
+	{
+		if (const AActor* Enemy = Enemies[Slot].Get())
+		{
+			EnemyPositions[Slot] = Enemy->GetActorLocation();
+		}
+		else
+		{
+			Enemies.RemoveAtSwap(Slot);
+			EnemyPositions.RemoveAtSwap(Slot);
+		}
+	}
+
+	PlayerPositions.Reset();
+	PlayerForwards.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerPositions.Add(Pawn->GetActorLocation());
+			PlayerForwards.Add(Pawn->GetActorForwardVector().GetSafeNormal2D());
+		}
+	}
+}
+
+TConstArrayView<FVector> UCombatSpatialIndex::GetEnemyPositions()
+{
+	Refresh();
+	return EnemyPositions;
+}
+
+TConstArrayView<FVector> UCombatSpatialIndex::GetPlayerPositions()
+{
+	Refresh();
+	return PlayerPositions;
+}
+
+TConstArrayView<FVector> UCombatSpatialIndex::GetPlayerForwards()
+{
+	Refresh();
+	return PlayerForwards;
+}
+
+int32 UCombatSpatialIndex::FindNearestPlayer(const FVector& Location)
+{
+	Refresh();
+
+	int32 Nearest = INDEX_NONE;
+	double NearestDistSq = TNumericLimits<double>::Max();
+	for (int32 PlayerIndex = 0; PlayerIndex < PlayerPositions.Num(); ++PlayerIndex)
+	{
+		const double DistSq = FVector::DistSquared(PlayerPositions[PlayerIndex], Location);
+		if (DistSq < NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			Nearest = PlayerIndex;
+		}
+	}
+	return Nearest;
+}
+
+TConstArrayView<FVector> UCombatSpatialIndex::GetRingPoints(int32 PlayerIndex, float Radius, int32 NumPoints)
+{
+	Refresh();
+	if (!PlayerPositions.IsValidIndex(PlayerIndex) || NumPoints <= 0)
+	{
+		return {};
+	}
+
+	FSlotKey Key;
+	Key.PlayerIndex = PlayerIndex;
+	Key.NumPoints = NumPoints;
+	Key.Distance = Radius;
+
+	if (const TArray<FVector>* Cached = FrameSlots.Find(Key))
+	{
+		return *Cached;
+	}
+
+	const FVector& Center = PlayerPositions[PlayerIndex];
+	const FVector& Forward = PlayerForwards[PlayerIndex];
+
+	TArray<FVector>& Points = FrameSlots.Add(Key);
+	Points.Reserve(NumPoints);
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		const float Angle = 360.0f * PointIndex / NumPoints;
+		Points.Add(Center + Forward.RotateAngleAxis(Angle, FVector::UpVector) * Radius);
+	}
+	return Points;
+}
+
+TConstArrayView<FVector> UCombatSpatialIndex::GetFlankPoints(int32 PlayerIndex, float Distance, float FlankAngle, int32 SlotsPerSide, float SlotSpacing)
+{
+	Refresh();
+	if (!PlayerPositions.IsValidIndex(PlayerIndex) || SlotsPerSide <= 0)
+	{
+		return {};
+	}
+
+	FSlotKey Key;
+	Key.PlayerIndex = PlayerIndex;
+	Key.NumPoints = SlotsPerSide;
+	Key.Distance = Distance;
+	Key.Angle = FlankAngle;
+	Key.Spacing = SlotSpacing;
+	Key.bFlank = true;
+
+	if (const TArray<FVector>* Cached = FrameSlots.Find(Key))
+	{
+		return *Cached;
+	}
+
+	const FVector& Center = PlayerPositions[PlayerIndex];
+	const FVector& Forward = PlayerForwards[PlayerIndex];
+
+	// slots on each side, spread evenly around the flank angle
+	TArray<FVector>& Points = FrameSlots.Add(Key);
+	Points.Reserve(SlotsPerSide * 2);
+	for (const float Side : { 1.0f, -1.0f })
+	{
+		for (int32 Slot = 0; Slot < SlotsPerSide; ++Slot)
+		{
+			const float Angle = FlankAngle + (Slot - (SlotsPerSide - 1) * 0.5f) * SlotSpacing;
+			Points.Add(Center + Forward.RotateAngleAxis(Side * Angle, FVector::UpVector) * Distance);
+		}
+	}
+	return Points;
+}
+
+int32 UCombatSpatialIndex::CountEnemiesNear(const FVector& Location, float Radius)
+{
+	Refresh();
+
+	const TPair<FIntVector, int32> Key(FIntVector(Location.GridSnap(1.0)), FMath::RoundToInt32(Radius));
+	if (const int32* Cached = FrameCrowding.Find(Key))
+	{
+		return *Cached;
+	}
+
+	const double RadiusSq = FMath::Square(double(Radius));
+	int32 Count = 0;
+	for (const FVector& EnemyPosition : EnemyPositions)
+	{
+		Count += FVector::DistSquared2D(EnemyPosition, Location) <= RadiusSq ? 1 : 0;
+	}
+
+	FrameCrowding.Add(Key, Count);
+	return Count;
+}
+
+bool UCombatSpatialIndex::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
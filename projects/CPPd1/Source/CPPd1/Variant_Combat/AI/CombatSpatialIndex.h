@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpatialIndex.generated.h"
+
+/**
+ * Packed player and enemy positions for combat AI queries.
+ *
+ * Enemies register while alive. Players are read from the player controllers. Positions are refreshed at most once
+ * per frame, on the first query of that frame. Ring and flank slots and crowding counts are cached for the rest of
+ * the frame, so every enemy querying around the same player shares one result instead of tracing on its own.
+ * The combat EQS generators and tests (EnvQueryGenerator_Combat*, EnvQueryTest_Combat*) read from here.
+ */
+UCLASS()
+class CPPd1_API UCombatSpatialIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Track a live enemy */
+	void AddEnemy(AActor* Enemy);
+
+	/** Stop tracking an enemy (death, EndPlay) */
+	void RemoveEnemy(AActor* Enemy);
+
+	/** True if the actor is a tracked enemy */
+	bool IsRegistered(const AActor* Actor) const;
+
+	/** Shorthands for enemies registering from BeginPlay / HandleDeath / EndPlay */
+	static void Register(AActor* Enemy);
+	static void Unregister(AActor* Enemy);
+
+	/** Shorthand for queries */
+	static UCombatSpatialIndex* Get(const UObject* WorldContextObject);
+
+	/** Querier actor of an EQS or AI request: the pawn itself, or a controller's pawn */
+	static const AActor* ResolveQuerier(const UObject* Owner);
+
+	/** Packed positions, refreshed for the current frame */
+	TConstArrayView<FVector> GetEnemyPositions();
+	TConstArrayView<FVector> GetPlayerPositions();
+
+	/** Players' horizontal facing, index-aligned with GetPlayerPositions */
+	TConstArrayView<FVector> GetPlayerForwards();
+
+	/** Index of the player closest to a location, INDEX_NONE without players */
+	int32 FindNearestPlayer(const FVector& Location);
+
+	/** NumPoints evenly spaced points at Radius around a player, starting at the player's facing. Cached for the frame */
+	TConstArrayView<FVector> GetRingPoints(int32 PlayerIndex, float Radius, int32 NumPoints);
+
+	/**
+	 * Slots at Distance on both sides of a player, centered FlankAngle degrees off the player's facing and
+	 * SlotSpacing degrees apart. Cached for the frame
+	 */
+	TConstArrayView<FVector> GetFlankPoints(int32 PlayerIndex, float Distance, float FlankAngle, int32 SlotsPerSide, float SlotSpacing);
+
+	/** Enemies within Radius of a location (2D). Cached for the frame per location, to the centimeter */
+	int32 CountEnemiesNear(const FVector& Location, float Radius);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Re-read positions and drop last frame's caches, once per frame */
+	void Refresh();
+
+	/** Packed per-enemy data, index-aligned. Removal swaps the last enemy in */
+	TArray<TWeakObjectPtr<AActor>> Enemies;
+	TArray<FVector> EnemyPositions;
+
+	/** Packed per-player data, index-aligned */
+	TArray<FVector> PlayerPositions;
+	TArray<FVector> PlayerForwards;
+
+	/** Generator parameters a set of slots was built from */
+	struct FSlotKey
+	{
+		int32 PlayerIndex = 0;
+		int32 NumPoints = 0;
+		float Distance = 0.0f;
+		float Angle = 0.0f;
+		float Spacing = 0.0f;
+		bool bFlank = false;
+
+		bool operator==(const FSlotKey& Other) const
+		{
+			return PlayerIndex == Other.PlayerIndex && NumPoints == Other.NumPoints && Distance == Other.Distance && Angle == Other.Angle && Spacing == Other.Spacing && bFlank == Other.bFlank;
+		}
+
+		friend uint32 GetTypeHash(const FSlotKey& Key)
+		{
+			return HashCombine(HashCombine(HashCombine(GetTypeHash(Key.PlayerIndex), GetTypeHash(Key.NumPoints)), HashCombine(GetTypeHash(Key.Distance), GetTypeHash(Key.Angle))), HashCombine(GetTypeHash(Key.Spacing), GetTypeHash(Key.bFlank)));
+		}
+	};
+
+	/** Generated ring and flank slots this frame */
+	TMap<FSlotKey, TArray<FVector>> FrameSlots;
+
+	/** Crowding counts this frame, by location rounded to the centimeter and radius */
+	TMap<TPair<FIntVector, int32>, int32> FrameCrowding;
+
+	/** GFrameCounter at the last Refresh */
+	uint64 RefreshedFrame = MAX_uint64;
+};
@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSpawnPlacement.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "NavigationSystem.h"
+#include "WorldCollision.h"
+
+UCombatSpawnPlacement* UCombatSpawnPlacement::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatSpawnPlacement>() : nullptr;
+}
+
+void UCombatSpawnPlacement::BuildPoints(const AActor* Spawner, TConstArrayView<FVector> Candidates, float CapsuleRadius, float CapsuleHalfHeight)
+{
+	UWorld* World = GetWorld();
+	if (!Spawner || !World)
+	{
+		return;
+	}
+
+	FSpawnerPoints& SpawnerPoints = Spawners.FindOrAdd(Spawner);
+	SpawnerPoints = FSpawnerPoints();
+	SpawnerPoints.BuildId = ++NextBuildId;
+	SpawnerPoints.CapsuleRadius = CapsuleRadius;
+	SpawnerPoints.CapsuleHalfHeight = CapsuleHalfHeight;
+
+	// onto the navmesh, then up so the capsule stands on it. Without a navigation system the candidates are used as given
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const FVector QueryExtent(CapsuleRadius * 2.0f, CapsuleRadius * 2.0f, CapsuleHalfHeight * 3.0f);
+
+	for (const FVector& Candidate : Candidates)
+	{
+		if (!NavSys)
+		{
+			SpawnerPoints.Candidates.Add(Candidate);
+			continue;
+		}
+
+		FNavLocation NavLocation;
+		if (NavSys->ProjectPointToNavigation(Candidate, NavLocation, QueryExtent))
+		{
+			SpawnerPoints.Candidates.Add(NavLocation.Location + FVector(0.0f, 0.0f, CapsuleHalfHeight + 2.0f));
+		}
+	}
+
+	SpawnerPoints.CandidateClear.Init(false, SpawnerPoints.Candidates.Num());
+	SpawnerPoints.PendingTests = SpawnerPoints.Candidates.Num();
+
+	if (SpawnerPoints.Candidates.IsEmpty())
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("CombatSpawnPlacement: none of %s's %d spawn points is on the navmesh"), *Spawner->GetName(), Candidates.Num());
+		return;
+	}
+
+	// level geometry only: pawns and physics bodies move, and will have moved by the time anything spawns
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatSpawnPlacement), false, Spawner);
+	FCollisionResponseParams ResponseParams;
+	ResponseParams.CollisionResponse.SetResponse(ECC_Pawn, ECR_Ignore);
+	ResponseParams.CollisionResponse.SetResponse(ECC_PhysicsBody, ECR_Ignore);
+
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight);
+	const FOverlapDelegate Delegate = FOverlapDelegate::CreateUObject(this, &UCombatSpawnPlacement::HandleOverlapResult, TWeakObjectPtr<const AActor>(Spawner), SpawnerPoints.BuildId);
+
+	for (int32 CandidateIndex = 0; CandidateIndex < SpawnerPoints.Candidates.Num(); ++CandidateIndex)
+	{
+		World->AsyncOverlapByChannel(SpawnerPoints.Candidates[CandidateIndex], FQuat::Identity, ECC_Pawn, Capsule, QueryParams, ResponseParams, &Delegate, uint32(CandidateIndex));
+	}
+}
+
+void UCombatSpawnPlacement::HandleOverlapResult(const FTraceHandle& Handle, FOverlapDatum& Datum, TWeakObjectPtr<const AActor> Spawner, uint32 BuildId)
+{
+	FSpawnerPoints* SpawnerPoints = Spawners.Find(Spawner);
+	if (!SpawnerPoints || SpawnerPoints->BuildId != BuildId || !SpawnerPoints->CandidateClear.IsValidIndex(int32(Datum.UserData)))
+	{
+		return;
+	}
+
+	SpawnerPoints->CandidateClear[Datum.UserData] = !Datum.OutOverlaps.ContainsByPredicate([](const FOverlapResult& Overlap) { return Overlap.bBlockingHit; });
+
+	if (--SpawnerPoints->PendingTests > 0)
+	{
+		return;
+	}
+
+	// all in: keep the clear ones, in candidate order
+	for (int32 CandidateIndex = 0; CandidateIndex < SpawnerPoints->Candidates.Num(); ++CandidateIndex)
+	{
+		if (SpawnerPoints->CandidateClear[CandidateIndex])
+		{
+			SpawnerPoints->Points.Add({ SpawnerPoints->Candidates[CandidateIndex] });
+		}
+	}
+
+	UE_LOG(LogCPPd1, Log, TEXT("CombatSpawnPlacement: %d of %d spawn points clear for %s"),
+		SpawnerPoints->Points.Num(), SpawnerPoints->Candidates.Num(), Spawner.IsValid() ? *Spawner->GetName() : TEXT("?"));
+
+	SpawnerPoints->Candidates.Empty();
+	SpawnerPoints->CandidateClear.Empty();
+}
+
+void UCombatSpawnPlacement::RemovePoints(const AActor* Spawner)
+{
+	Spawners.Remove(Spawner);
+}
+
+bool UCombatSpawnPlacement::TakePoint(const AActor* Spawner, ECombatSpawnPointOrder Order, FVector& OutLocation)
+{
+	FSpawnerPoints* SpawnerPoints = Spawners.Find(Spawner);
+	if (!SpawnerPoints || SpawnerPoints->PendingTests > 0 || SpawnerPoints->Points.IsEmpty())
+	{
+		return false;
+	}
+
+	int32 PointIndex = INDEX_NONE;
+	if (Order == ECombatSpawnPointOrder::FarthestFromPlayers)
+	{
+		PointIndex = PickFarthestFromPlayers(*SpawnerPoints, Spawner);
+	}
+	else
+	{
+		PointIndex = PickRoundRobin(*SpawnerPoints, Spawner);
+	}
+
+	if (PointIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FSpawnPoint& Point = SpawnerPoints->Points[PointIndex];
+	Point.LastUsedTime = GetWorld()->GetTimeSeconds();
+	OutLocation = Point.Location;
+	return true;
+}
+
+int32 UCombatSpawnPlacement::PickFarthestFromPlayers(const FSpawnerPoints& SpawnerPoints, const AActor* Spawner) const
+{
+	const UWorld* World = GetWorld();
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	const double Now = World->GetTimeSeconds();
+
+	// points off cooldown, ranked by distance to the nearest player
+	TArray<TPair<double, int32>, TInlineAllocator<16>> Ranked;
+	for (int32 PointIndex = 0; PointIndex < SpawnerPoints.Points.Num(); ++PointIndex)
+	{
+		const FSpawnPoint& Point = SpawnerPoints.Points[PointIndex];
+		if (Now - Point.LastUsedTime < PointReuseSeconds)
+		{
+			continue;
+		}
+
+		double Score = UE_BIG_NUMBER;
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			Score = FMath::Min(Score, FVector::DistSquared(Point.Location, PlayerLocation));
+		}
+		Ranked.Emplace(Score, PointIndex);
+	}
+
+	Ranked.Sort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; });
+
+	// farthest first; only the points actually tried pay for a pawn overlap
+	for (const TPair<double, int32>& Entry : Ranked)
+	{
+		if (IsPointFree(SpawnerPoints, SpawnerPoints.Points[Entry.Value], Spawner))
+		{
+			return Entry.Value;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int32 UCombatSpawnPlacement::PickRoundRobin(FSpawnerPoints& SpawnerPoints, const AActor* Spawner) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 NumPoints = SpawnerPoints.Points.Num();
+
+	for (int32 Step = 0; Step < NumPoints; ++Step)
+	{
+		const int32 PointIndex = (SpawnerPoints.NextPoint + Step) % NumPoints;
+		const FSpawnPoint& Point = SpawnerPoints.Points[PointIndex];
+
+		if (Now - Point.LastUsedTime >= PointReuseSeconds && IsPointFree(SpawnerPoints, Point, Spawner))
+		{
+			SpawnerPoints.NextPoint = PointIndex + 1;
+			return PointIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool UCombatSpawnPlacement::IsPointFree(const FSpawnerPoints& SpawnerPoints, const FSpawnPoint& Point, const AActor* Spawner) const
+{
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(SpawnerPoints.CapsuleRadius, SpawnerPoints.CapsuleHalfHeight);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatSpawnPointFree), false, Spawner);
+
+	return !GetWorld()->OverlapAnyTestByObjectType(Point.Location, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), Capsule, QueryParams);
+}
+
+bool UCombatSpawnPlacement::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpawnPlacement.generated.h"
+
+struct FTraceHandle;
+struct FOverlapDatum;
+
+/** How a spawner's validated points are handed out */
+UENUM(BlueprintType)
+enum class ECombatSpawnPointOrder : uint8
+{
+	/** In candidate order, wrapping around and skipping points used in the last few seconds */
+	RoundRobin,
+
+	/** The point farthest from every player, skipping points used in the last few seconds */
+	FarthestFromPlayers
+};
+
+/**
+ * Validated spawn points for enemy spawners.
+ *
+ * A spawner hands in its candidate points once, on BeginPlay. Each candidate is projected onto the navmesh and lifted
+ * to capsule height. Then an async capsule overlap checks it against level geometry; pawns and physics bodies are
+ * ignored because they move. Points that pass are kept, so a spawn only picks a point and never needs an
+ * encroachment fix-up. The overlap results arrive over the next frame or two. Until then TakePoint fails and
+ * the spawner falls back to its old placement.
+ *
+ * Enemies often stand where they spawned for a while, so taking a point also runs one quick pawn overlap on it.
+ * An occupied point is skipped, and TakePoint fails when no free point is left.
+ */
+UCLASS()
+class CPPd1_API UCombatSpawnPlacement : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Seconds before a point is reused, so enemies don't stack on the same one */
+	static constexpr double PointReuseSeconds = 2.0;
+
+	/** Start validating candidates for a spawner, replacing any points it had */
+	void BuildPoints(const AActor* Spawner, TConstArrayView<FVector> Candidates, float CapsuleRadius, float CapsuleHalfHeight);
+
+	/** Drop a spawner's points (EndPlay) */
+	void RemovePoints(const AActor* Spawner);
+
+	/** Next validated point for a spawner that no pawn stands on. False while validation is running, if no candidate passed, or if every point is taken */
+	bool TakePoint(const AActor* Spawner, ECombatSpawnPointOrder Order, FVector& OutLocation);
+
+	/** Shorthand for spawners */
+	static UCombatSpawnPlacement* Get(const UObject* WorldContextObject);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	struct FSpawnPoint
+	{
+		FVector Location = FVector::ZeroVector;
+		double LastUsedTime = -UE_BIG_NUMBER;
+	};
+
+	struct FSpawnerPoints
+	{
+		/** Projected candidates; false entries failed the overlap test */
+		TArray<FVector> Candidates;
+		TArray<bool> CandidateClear;
+
+		/** Validated points, in candidate order */
+		TArray<FSpawnPoint> Points;
+
+		/** Overlap tests still in flight */
+		int32 PendingTests = 0;
+
+		/** Bumped by every BuildPoints, so results of a replaced build are ignored */
+		uint32 BuildId = 0;
+
+		/** Next point for RoundRobin */
+		int32 NextPoint = 0;
+
+		/** Capsule the points were validated with, reused for the pawn check on take */
+		float CapsuleRadius = 0.0f;
+		float CapsuleHalfHeight = 0.0f;
+	};
+
+	/** Async overlap result for one candidate */
+	void HandleOverlapResult(const FTraceHandle& Handle, FOverlapDatum& Datum, TWeakObjectPtr<const AActor> Spawner, uint32 BuildId);
+
+	/** Point off cooldown and free of pawns that is farthest from the nearest player, INDEX_NONE if there's none */
+	int32 PickFarthestFromPlayers(const FSpawnerPoints& SpawnerPoints, const AActor* Spawner) const;
+
+	/** First point from NextPoint on that is off cooldown and free of pawns, INDEX_NONE if there's none */
+	int32 PickRoundRobin(FSpawnerPoints& SpawnerPoints, const AActor* Spawner) const;
+
+	/** True if no pawn overlaps a capsule standing on the point */
+	bool IsPointFree(const FSpawnerPoints& SpawnerPoints, const FSpawnPoint& Point, const AActor* Spawner) const;
+
+	TMap<TWeakObjectPtr<const AActor>, FSpawnerPoints> Spawners;
+
+	uint32 NextBuildId = 0;
+};
@@ -6,9 +6,16 @@
 #include "Components/CapsuleComponent.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
+#include "CombatInputRecorder.h"
+#include "CombatHitchDetector.h"
+#include "CombatAssetLoader.h"
+#include "CPPd1RoundSnapshot.h"
+#include "CombatSaveSystem.h"
 
 ACombatWaveSpawner::ACombatWaveSpawner()
 {
+	LLM_SCOPE_BYTAG(Combat_Spawners);
+
 	PrimaryActorTick.bCanEverTick = false;
 
 	RootSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootScene"));
@@ -24,11 +31,30 @@ ACombatWaveSpawner::ACombatWaveSpawner()
 
 void ACombatWaveSpawner::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Combat_Spawners);
+
 	Super::BeginPlay();
 
+	SpawnRandom.Initialize(UCombatInputRecorder::MakeRandomSeed(this));
+
+	PreloadEnemyAssets();
+	BuildSpawnPoints();
+
+	UCPPd1RoundSnapshot::Register(this);
+
 	if (bStartWavesOnBeginPlay && WaveConfigs.Num() > 0)
 	{
-		StartWaves();
+		// pick up at the wave a saved session was on
+		int32 SavedWaveIndex = 0;
+		if (UCombatSaveSystem::ConsumeWave(this, SavedWaveIndex) && SavedWaveIndex > 0)
+		{
+			CurrentWaveIndex = SavedWaveIndex;
+			SpawnNextWave();
+		}
+		else
+		{
+			StartWaves();
+		}
 	}
 }
 
@@ -36,8 +62,57 @@ void ACombatWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	UCPPd1RoundSnapshot::Unregister(this);
+
+	if (UCombatSpawnPlacement* Placement = UCombatSpawnPlacement::Get(this))
+	{
+		Placement->RemovePoints(this);
+	}
+
 	GetWorld()->GetTimerManager().ClearTimer(WaveStartTimer);
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	for (TSharedPtr<FStreamableHandle>* Handle : { &EnemyClassesHandle, &EnemyAssetsHandle })
+	{
+		if (Handle->IsValid())
+		{
+			(*Handle)->CancelHandle();
+			Handle->Reset();
+		}
+	}
+}
+
+void ACombatWaveSpawner::PreloadEnemyAssets()
+{
+	TArray<FSoftObjectPath> Paths;
+	for (const FCombatWaveConfig& Config : WaveConfigs)
+	{
+		Paths.AddUnique(Config.EnemyClass.ToSoftObjectPath());
+	}
+
+	EnemyClassesHandle = UCombatAssetLoader::RequestAssets(MoveTemp(Paths));
+	if (EnemyClassesHandle)
+	{
+		// an already-complete handle doesn't take a delegate; it's loaded, so go straight on
+		if (!EnemyClassesHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ACombatWaveSpawner::HandleEnemyClassesLoaded)))
+		{
+			HandleEnemyClassesLoaded();
+		}
+	}
+}
+
+void ACombatWaveSpawner::HandleEnemyClassesLoaded()
+{
+	TArray<FSoftObjectPath> Paths;
+	for (const FCombatWaveConfig& Config : WaveConfigs)
+	{
+		if (const UClass* Class = Config.EnemyClass.Get())
+		{
+			GetDefault<ACombatEnemy>(Class)->GatherPreloadAssets(Paths);
+		}
+	}
+
+	EnemyAssetsHandle = UCombatAssetLoader::RequestAssets(MoveTemp(Paths));
 }
 
 void ACombatWaveSpawner::StartWaves()
@@ -65,7 +140,9 @@ void ACombatWaveSpawner::SpawnNextWave()
 	CurrentSpawnIndex = 0;
 	CurrentWaveEnemies.Empty();
 
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WaveStarted, this, float(CurrentWaveIndex));
 	OnWaveStarted.Broadcast(CurrentWaveIndex);
+	OnWaveEnemiesChanged.Broadcast(CurrentWaveIndex, 0);
 
 	// Schedule first enemy spawn after delay
 	if (WaveConfig.WaveStartDelay > 0.0f)
@@ -86,6 +163,11 @@ void ACombatWaveSpawner::SpawnNextWave()
 
 void ACombatWaveSpawner::SpawnEnemyInWave()
 {
+	COMBAT_SCOPE(WaveSpawn);
+
+	// the spawned enemy and everything it allocates on spawn count as enemy memory
+	LLM_SCOPE_BYTAG(Combat_Enemies);
+
 	if (CurrentWaveIndex >= WaveConfigs.Num())
 	{
 		return;
@@ -100,27 +182,38 @@ void ACombatWaveSpawner::SpawnEnemyInWave()
 		return;
 	}
 
-	// Spawn enemy
-	if (WaveConfig.EnemyClass)
+	// Spawn enemy. The class was preloaded on BeginPlay; Resolve only loads it here if that hasn't finished
+	if (UClass* EnemyClass = UCombatAssetLoader::Resolve(WaveConfig.EnemyClass))
 	{
 		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-		FVector SpawnLocation = GetSpawnLocation();
+		FVector SpawnLocation;
 		FRotator SpawnRotation = SpawnCapsule->GetComponentRotation();
 
-		// Add some random offset to prevent overlapping (if using default spawn location)
-		if (SpawnLocation == SpawnCapsule->GetComponentLocation())
+		UCombatSpawnPlacement* Placement = UCombatSpawnPlacement::Get(this);
+		if (Placement && Placement->TakePoint(this, SpawnPointOrder, SpawnLocation))
+		{
+			// on the navmesh and clear of level geometry and pawns already, so no collision fix-up
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		}
+		else
 		{
-			SpawnLocation += FVector(
-				FMath::RandRange(-100.0f, 100.0f),
-				FMath::RandRange(-100.0f, 100.0f),
-				0.0f
-			);
+			// custom, not yet validated or all taken points: let the spawn resolve any overlap
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+			SpawnLocation = GetSpawnLocation();
+
+			// Add some random offset to prevent overlapping (if using default spawn location)
+			if (SpawnLocation == SpawnCapsule->GetComponentLocation())
+			{
+				SpawnLocation += FVector(
+					SpawnRandom.FRandRange(-SpawnScatterRadius, SpawnScatterRadius),
+					SpawnRandom.FRandRange(-SpawnScatterRadius, SpawnScatterRadius),
+					0.0f
+				);
+			}
 		}
 
 		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(
-			WaveConfig.EnemyClass,
+			EnemyClass,
 			SpawnLocation,
 			SpawnRotation,
 			SpawnParams
@@ -133,6 +226,8 @@ void ACombatWaveSpawner::SpawnEnemyInWave()
 
 			// Subscribe to death event
 			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatWaveSpawner::OnEnemyDied);
+
+			OnWaveEnemiesChanged.Broadcast(CurrentWaveIndex, CurrentWaveEnemies.Num());
 		}
 
 		// Notify that spawn location was used
@@ -163,6 +258,7 @@ void ACombatWaveSpawner::OnEnemyDied(ACombatEnemy* DeadEnemy)
 
 	// Remove from current wave
 	CurrentWaveEnemies.Remove(DeadEnemy);
+	OnWaveEnemiesChanged.Broadcast(CurrentWaveIndex, CurrentWaveEnemies.Num());
 
 	// Check if current wave is complete
 	if (CurrentWaveEnemies.Num() == 0)
@@ -170,6 +266,12 @@ void ACombatWaveSpawner::OnEnemyDied(ACombatEnemy* DeadEnemy)
 		OnWaveCompleted.Broadcast(CurrentWaveIndex);
 		CurrentWaveIndex++;
 
+		// scripted waves aren't progress
+		if (!bRunningScriptedWave)
+		{
+			UCombatSaveSystem::RequestSave(this);
+		}
+
 		// Start next wave
 		if (CurrentWaveIndex < WaveConfigs.Num())
 		{
@@ -222,6 +324,114 @@ void ACombatWaveSpawner::ResetWaves()
 
 	GetWorld()->GetTimerManager().ClearTimer(WaveStartTimer);
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	if (bRunningScriptedWave)
+	{
+		WaveConfigs = MoveTemp(ConfiguredWaveConfigs);
+		ConfiguredWaveConfigs.Reset();
+		bRunningScriptedWave = false;
+	}
+}
+
+void ACombatWaveSpawner::StartScriptedWave(int32 EnemyCount, float SpawnInterval, TSubclassOf<ACombatEnemy> EnemyClass)
+{
+	if (!EnemyClass)
+	{
+		for (const FCombatWaveConfig& Config : WaveConfigs)
+		{
+			if (!Config.EnemyClass.IsNull())
+			{
+				EnemyClass = UCombatAssetLoader::Resolve(Config.EnemyClass);
+				break;
+			}
+		}
+	}
+
+	ResetWaves();
+
+	FCombatWaveConfig WaveConfig;
+	WaveConfig.EnemyCount = EnemyCount;
+	WaveConfig.WaveStartDelay = 0.0f;
+	WaveConfig.SpawnInterval = SpawnInterval;
+	WaveConfig.EnemyClass = EnemyClass.Get();
+
+	// set the designer's waves aside until ResetWaves
+	ConfiguredWaveConfigs = MoveTemp(WaveConfigs);
+	WaveConfigs.Reset();
+	WaveConfigs.Add(WaveConfig);
+	bRunningScriptedWave = true;
+
+	SpawnNextWave();
+}
+
+void ACombatWaveSpawner::CaptureRoundState()
+{
+	RoundStartWaveIndex = CurrentWaveIndex;
+	bRoundStartWaveActive = WaveConfigs.IsValidIndex(CurrentWaveIndex)
+		&& (CurrentSpawnIndex > 0 || GetWorld()->GetTimerManager().IsTimerActive(WaveStartTimer));
+}
+
+void ACombatWaveSpawner::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	SetActorTransform(RoundStartTransform);
+
+	// this round's enemies go; stop listening first so their removal doesn't advance the waves
+	for (ACombatEnemy* Enemy : AllSpawnedEnemies)
+	{
+		if (IsValid(Enemy))
+		{
+			Enemy->OnEnemyDied.RemoveDynamic(this, &ACombatWaveSpawner::OnEnemyDied);
+			Enemy->Destroy();
+		}
+	}
+
+	ResetWaves();
+	CurrentWaveIndex = RoundStartWaveIndex;
+
+	if (bRoundStartWaveActive)
+	{
+		SpawnNextWave();
+	}
+}
+
+bool ACombatWaveSpawner::IsSpawningWave() const
+{
+	return WaveConfigs.IsValidIndex(CurrentWaveIndex) && CurrentSpawnIndex < WaveConfigs[CurrentWaveIndex].EnemyCount;
+}
+
+void ACombatWaveSpawner::BuildSpawnPoints()
+{
+	UCombatSpawnPlacement* Placement = UCombatSpawnPlacement::Get(this);
+	if (!Placement || GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ACombatWaveSpawner, GetSpawnLocation)))
+	{
+		return;
+	}
+
+	TArray<FVector> Candidates;
+	GatherSpawnCandidates(Candidates);
+
+	float CapsuleRadius = 0.0f;
+	float CapsuleHalfHeight = 0.0f;
+	SpawnCapsule->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	Placement->BuildPoints(this, Candidates, CapsuleRadius, CapsuleHalfHeight);
+}
+
+void ACombatWaveSpawner::GatherSpawnCandidates(TArray<FVector>& OutCandidates) const
+{
+	const FVector Center = SpawnCapsule->GetComponentLocation();
+	OutCandidates.Add(Center);
+
+	// one ring, spaced about a capsule diameter apart
+	if (SpawnScatterRadius > 0.0f)
+	{
+		const int32 NumRingPoints = FMath::Clamp(FMath::FloorToInt32(UE_TWO_PI * SpawnScatterRadius / (SpawnCapsule->GetScaledCapsuleRadius() * 2.0f)), 3, 16);
+		for (int32 PointIndex = 0; PointIndex < NumRingPoints; ++PointIndex)
+		{
+			const float Angle = UE_TWO_PI * PointIndex / NumRingPoints;
+			OutCandidates.Add(Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * SpawnScatterRadius);
+		}
+	}
 }
 
 FVector ACombatWaveSpawner::GetSpawnLocation_Implementation()
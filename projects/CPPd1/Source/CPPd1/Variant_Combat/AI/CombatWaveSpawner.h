@@ -5,11 +5,15 @@
 #include "CoreMinimal.h"
 #include "CPPd1.h"
 #include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
+#include "CPPd1RoundResettable.h"
+#include "CombatSpawnPlacement.h"
 #include "CombatWaveSpawner.generated.h"
 
 class ACombatEnemy;
 class USceneComponent;
 class UCapsuleComponent;
+struct FStreamableHandle;
 
 /**
  * Wave configuration structure
@@ -31,9 +35,9 @@ struct FCombatWaveConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave", meta = (ClampMin = 0.0f, Units = "s"))
 	float SpawnInterval = 1.0f;
 
-	/** Type of enemy to spawn in this wave */
+	/** Type of enemy to spawn in this wave. Soft: the spawner preloads it on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
-	TSubclassOf<ACombatEnemy> EnemyClass;
+	TSoftClassPtr<ACombatEnemy> EnemyClass;
 };
 
 /**
@@ -41,7 +45,7 @@ struct FCombatWaveConfig
  * Enemies spawn but only one engages at a time (managed by CombatEngagementManager)
  */
 UCLASS(BlueprintType, Blueprintable)
-class CPPd1_API ACombatWaveSpawner : public AActor
+class CPPd1_API ACombatWaveSpawner : public AActor, public ICPPd1RoundResettable
 {
 	GENERATED_BODY()
 
@@ -61,6 +65,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves")
 	TArray<FCombatWaveConfig> WaveConfigs;
 
+	/** How validated spawn points are handed out */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	ECombatSpawnPointOrder SpawnPointOrder = ECombatSpawnPointOrder::RoundRobin;
+
+	/** Radius around the spawn capsule that spawn points are spread over, so enemies don't spawn inside each other */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (ClampMin = 0.0f, Units = "cm"))
+	float SpawnScatterRadius = 100.0f;
+
 	/** If true, start spawning waves immediately on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waves")
 	bool bStartWavesOnBeginPlay = true;
@@ -84,6 +96,41 @@ protected:
 	/** Current spawn index within wave */
 	int32 CurrentSpawnIndex = 0;
 
+	/** Spawn offsets; seeded from the input recorder's session seed so replays spawn in the same places */
+	FRandomStream SpawnRandom;
+
+	/** Wave enemy classes and the montages they declare; held so they stay loaded while the spawner exists */
+	TSharedPtr<FStreamableHandle> EnemyClassesHandle;
+	TSharedPtr<FStreamableHandle> EnemyAssetsHandle;
+
+	/** Start loading every wave's enemy class in the background, then the soft assets those classes declare */
+	void PreloadEnemyAssets();
+
+	/** Class load finished; request the enemies' montages */
+	void HandleEnemyClassesLoaded();
+
+	/**
+	 * Hand candidate spawn points to UCombatSpawnPlacement for validation. Skipped when a Blueprint overrides
+	 * GetSpawnLocation, since its points can't be known up front. The capsule's size is used for the tests,
+	 * so size it to the largest enemy
+	 */
+	void BuildSpawnPoints();
+
+	/** Candidate spawn points at capsule center height: the spawn capsule and a ring of SpawnScatterRadius around it */
+	virtual void GatherSpawnCandidates(TArray<FVector>& OutCandidates) const;
+
+	/** The designer's wave list while a scripted wave has replaced it; put back by ResetWaves */
+	TArray<FCombatWaveConfig> ConfiguredWaveConfigs;
+
+	/** True while WaveConfigs holds a scripted wave */
+	bool bRunningScriptedWave = false;
+
+	/** Wave index when the round snapshot was taken */
+	int32 RoundStartWaveIndex = 0;
+
+	/** Whether that wave had started (spawning or fighting) when the round snapshot was taken */
+	bool bRoundStartWaveActive = false;
+
 public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -115,6 +162,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Waves")
 	TArray<ACombatEnemy*> GetCurrentWaveEnemies() const;
 
+	/** Number of enemies still alive in the current wave (no allocation) */
+	UFUNCTION(BlueprintPure, Category = "Waves")
+	int32 GetCurrentWaveEnemyCount() const { return CurrentWaveEnemies.Num(); }
+
 	/** Get all spawned enemies */
 	UFUNCTION(BlueprintPure, Category = "Waves")
 	TArray<ACombatEnemy*> GetAllSpawnedEnemies() const;
@@ -127,10 +178,25 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Waves")
 	bool AreAllWavesComplete() const;
 
-	/** Reset spawner to start from first wave */
+	/** Reset spawner to start from first wave. Ends a scripted wave and brings back the configured waves */
 	UFUNCTION(BlueprintCallable, Category = "Waves")
 	void ResetWaves();
 
+	/** Run a single wave in place of the wave list, starting right away (benchmarks, scripted encounters). ResetWaves brings the wave list back. Uses the first configured enemy class when none is given */
+	UFUNCTION(BlueprintCallable, Category = "Waves")
+	void StartScriptedWave(int32 EnemyCount, float SpawnInterval, TSubclassOf<ACombatEnemy> EnemyClass = nullptr);
+
+	/** True while the current wave still has enemies left to spawn */
+	UFUNCTION(BlueprintPure, Category = "Waves")
+	bool IsSpawningWave() const;
+
+	// ~begin ICPPd1RoundResettable interface
+	virtual void CaptureRoundState() override;
+
+	/** Removes this round's enemies and restarts the captured wave from its first spawn */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+	// ~end ICPPd1RoundResettable interface
+
 protected:
 	/** Delegate for when a wave starts */
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWaveStarted, int32, WaveIndex);
@@ -141,6 +207,9 @@ protected:
 	/** Delegate for when all waves complete */
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnAllWavesCompleted);
 
+	/** Delegate for when the current wave's enemy count changes (spawn, death, new wave) */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWaveEnemiesChanged, int32, WaveIndex, int32, EnemiesRemaining);
+
 public:
 	/** Event fired when a wave starts */
 	UPROPERTY(BlueprintAssignable, Category = "Events")
@@ -153,4 +222,8 @@ public:
 	/** Event fired when all waves complete */
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnAllWavesCompleted OnAllWavesCompleted;
+
+	/** Event fired when the current wave's enemy count changes */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnWaveEnemiesChanged OnWaveEnemiesChanged;
 };
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/Generators/EnvQueryGenerator_ProjectedPoints.h"
+#include "EnvQueryGenerator_CombatFlank.generated.h"
+
+/**
+ *  UEnvQueryGenerator_CombatFlank
+ *  Flanking slots on both sides of the player nearest the querier.
+ *  The slots are built once per frame by UCombatSpatialIndex and shared by every enemy asking for the same slots
+ */
+UCLASS(meta = (DisplayName = "Combat: Player Flank"))
+class UEnvQueryGenerator_CombatFlank : public UEnvQueryGenerator_ProjectedPoints
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnvQueryGenerator_CombatFlank();
+
+	/** Distance from the player */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 0, Units = "cm"))
+	float Distance = 250.0f;
+
+	/** Angle off the player's facing the slots are centered on. 90 is straight to the side */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 0, ClampMax = 180, Units = "Degrees"))
+	float FlankAngle = 90.0f;
+
+	/** Slots on each side */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 1))
+	int32 SlotsPerSide = 2;
+
+	/** Angle between neighbouring slots */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 0, Units = "Degrees"))
+	float SlotSpacing = 30.0f;
+
+	/** Adds the flanking slots to the query */
+	virtual void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+};
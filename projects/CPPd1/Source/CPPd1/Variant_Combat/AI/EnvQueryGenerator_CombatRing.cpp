@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "EnvQueryGenerator_CombatRing.h"
+#include "CombatSpatialIndex.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+
+UEnvQueryGenerator_CombatRing::UEnvQueryGenerator_CombatRing()
+{
+	// the points are shared between enemies, so don't trace per query unless asked to
+	ProjectionData.TraceMode = EEnvQueryTrace::None;
+}
+
+void UEnvQueryGenerator_CombatRing::GenerateItems(FEnvQueryInstance& QueryInstance) const
+{
+	UCombatSpatialIndex* Index = UCombatSpatialIndex::Get(QueryInstance.World);
+	const AActor* Querier = UCombatSpatialIndex::ResolveQuerier(QueryInstance.Owner.Get());
+	if (!Index || !Querier)
+	{
+		return;
+	}
+
+	// ring around the player this enemy is engaging
+	const int32 PlayerIndex = Index->FindNearestPlayer(Querier->GetActorLocation());
+
+	TArray<FNavLocation> Points;
+	for (const FVector& Point : Index->GetRingPoints(PlayerIndex, Radius, NumPoints))
+	{
+		Points.Add(FNavLocation(Point));
+	}
+
+	ProjectAndFilterNavPoints(Points, QueryInstance);
+	StoreNavPoints(Points, QueryInstance);
+}
@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/Generators/EnvQueryGenerator_ProjectedPoints.h"
+#include "EnvQueryGenerator_CombatRing.generated.h"
+
+/**
+ *  UEnvQueryGenerator_CombatRing
+ *  Points in a ring around the player nearest the querier.
+ *  The ring is built once per frame by UCombatSpatialIndex and shared by every enemy asking for the same ring
+ */
+UCLASS(meta = (DisplayName = "Combat: Player Ring"))
+class UEnvQueryGenerator_CombatRing : public UEnvQueryGenerator_ProjectedPoints
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnvQueryGenerator_CombatRing();
+
+	/** Distance from the player */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 0, Units = "cm"))
+	float Radius = 250.0f;
+
+	/** Points around the ring, the first one in front of the player */
+	UPROPERTY(EditDefaultsOnly, Category="Generator", meta = (ClampMin = 1))
+	int32 NumPoints = 12;
+
+	/** Adds the ring points to the query */
+	virtual void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+};
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "EnvQueryTest_CombatCrowding.h"
+#include "CombatSpatialIndex.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_VectorBase.h"
+
+UEnvQueryTest_CombatCrowding::UEnvQueryTest_CombatCrowding()
+{
+	ValidItemType = UEnvQueryItemType_VectorBase::StaticClass();
+	Cost = EEnvTestCost::Low;
+	SetWorkOnFloatValues(true);
+}
+
+void UEnvQueryTest_CombatCrowding::RunTest(FEnvQueryInstance& QueryInstance) const
+{
+	UObject* QueryOwner = QueryInstance.Owner.Get();
+	UCombatSpatialIndex* Index = UCombatSpatialIndex::Get(QueryInstance.World);
+	if (!QueryOwner || !Index)
+	{
+		return;
+	}
+
+	FloatValueMin.BindData(QueryOwner, QueryInstance.QueryID);
+	const float MinThresholdValue = FloatValueMin.GetValue();
+
+	FloatValueMax.BindData(QueryOwner, QueryInstance.QueryID);
+	const float MaxThresholdValue = FloatValueMax.GetValue();
+
+	// the querier doesn't crowd itself, if it's one of the counted enemies
+	const AActor* Querier = UCombatSpatialIndex::ResolveQuerier(QueryOwner);
+	const bool bQuerierCounted = Index->IsRegistered(Querier);
+	const FVector QuerierLocation = Querier ? Querier->GetActorLocation() : FVector::ZeroVector;
+	const double RadiusSq = FMath::Square(double(Radius));
+
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+	{
+		const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
+
+		int32 Crowding = Index->CountEnemiesNear(ItemLocation, Radius);
+		if (bQuerierCounted && FVector::DistSquared2D(QuerierLocation, ItemLocation) <= RadiusSq)
+		{
+			Crowding = FMath::Max(Crowding - 1, 0);
+		}
+
+		It.SetScore(TestPurpose, FilterType, float(Crowding), MinThresholdValue, MaxThresholdValue);
+	}
+}
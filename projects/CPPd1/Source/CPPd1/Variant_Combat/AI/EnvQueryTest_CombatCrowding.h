@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryTest.h"
+#include "EnvQueryTest_CombatCrowding.generated.h"
+
+/**
+ *  UEnvQueryTest_CombatCrowding
+ *  Scores items by the number of other enemies around them.
+ *  Reads the packed enemy positions in UCombatSpatialIndex instead of running an overlap per item
+ */
+UCLASS(meta = (DisplayName = "Combat: Enemy Crowding"))
+class UEnvQueryTest_CombatCrowding : public UEnvQueryTest
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnvQueryTest_CombatCrowding();
+
+	/** Enemies within this distance of an item count towards its score */
+	UPROPERTY(EditDefaultsOnly, Category="Crowding", meta = (ClampMin = 0, Units = "cm"))
+	float Radius = 150.0f;
+
+	/** Scores every item */
+	virtual void RunTest(FEnvQueryInstance& QueryInstance) const override;
+};
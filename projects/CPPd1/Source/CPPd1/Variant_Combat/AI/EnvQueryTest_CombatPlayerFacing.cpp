@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "EnvQueryTest_CombatPlayerFacing.h"
+#include "CombatSpatialIndex.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_VectorBase.h"
+
+UEnvQueryTest_CombatPlayerFacing::UEnvQueryTest_CombatPlayerFacing()
+{
+	ValidItemType = UEnvQueryItemType_VectorBase::StaticClass();
+	Cost = EEnvTestCost::Low;
+	SetWorkOnFloatValues(true);
+}
+
+void UEnvQueryTest_CombatPlayerFacing::RunTest(FEnvQueryInstance& QueryInstance) const
+{
+	UObject* QueryOwner = QueryInstance.Owner.Get();
+	UCombatSpatialIndex* Index = UCombatSpatialIndex::Get(QueryInstance.World);
+	const AActor* Querier = UCombatSpatialIndex::ResolveQuerier(QueryOwner);
+	if (!QueryOwner || !Index || !Querier)
+	{
+		return;
+	}
+
+	const int32 PlayerIndex = Index->FindNearestPlayer(Querier->GetActorLocation());
+	if (PlayerIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FloatValueMin.BindData(QueryOwner, QueryInstance.QueryID);
+	const float MinThresholdValue = FloatValueMin.GetValue();
+
+	FloatValueMax.BindData(QueryOwner, QueryInstance.QueryID);
+	const float MaxThresholdValue = FloatValueMax.GetValue();
+
+	const FVector PlayerLocation = Index->GetPlayerPositions()[PlayerIndex];
+	const FVector PlayerForward = Index->GetPlayerForwards()[PlayerIndex];
+
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+	{
+		const FVector ToItem = (GetItemLocation(QueryInstance, It.GetIndex()) - PlayerLocation).GetSafeNormal2D();
+		It.SetScore(TestPurpose, FilterType, float(FVector::DotProduct(PlayerForward, ToItem)), MinThresholdValue, MaxThresholdValue);
+	}
+}
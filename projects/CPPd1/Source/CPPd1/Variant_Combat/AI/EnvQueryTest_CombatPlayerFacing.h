@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryTest.h"
+#include "EnvQueryTest_CombatPlayerFacing.generated.h"
+
+/**
+ *  UEnvQueryTest_CombatPlayerFacing
+ *  Scores items by how far in front of the player nearest the querier they are:
+ *  1 straight ahead, 0 to the side, -1 behind.
+ *  Reads the packed player positions and facings in UCombatSpatialIndex
+ */
+UCLASS(meta = (DisplayName = "Combat: Player Facing"))
+class UEnvQueryTest_CombatPlayerFacing : public UEnvQueryTest
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnvQueryTest_CombatPlayerFacing();
+
+	/** Scores every item */
+	virtual void RunTest(FEnvQueryInstance& QueryInstance) const override;
+};
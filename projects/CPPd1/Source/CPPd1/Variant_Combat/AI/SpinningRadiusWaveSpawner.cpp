@@ -19,6 +19,16 @@ FVector ASpinningRadiusWaveSpawner::GetSpawnLocation_Implementation()
 	return GetActorLocation() + Offset;
 }
 
+void ASpinningRadiusWaveSpawner::GatherSpawnCandidates(TArray<FVector>& OutCandidates) const
+{
+	const int32 NumSteps = FMath::Max(1, FMath::CeilToInt32(360.0f / AngleStepPerSpawn));
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const float Rad = FMath::DegreesToRadians(CurrentSpawnAngle + Step * AngleStepPerSpawn);
+		OutCandidates.Add(GetActorLocation() + FVector(SpawnRadius * FMath::Cos(Rad), SpawnRadius * FMath::Sin(Rad), SpawnHeightOffset));
+	}
+}
+
 void ASpinningRadiusWaveSpawner::OnSpawnLocationUsed_Implementation()
 {
 	CurrentSpawnAngle += AngleStepPerSpawn;
@@ -36,6 +36,9 @@ public:
 	virtual void OnSpawnLocationUsed_Implementation() override;
 
 protected:
+	/** One point per angle step around the circle, in spawn order */
+	virtual void GatherSpawnCandidates(TArray<FVector>& OutCandidates) const override;
+
 	/** Current angle in degrees for the next spawn (0 = +X, 90 = +Y in Unreal). */
 	UPROPERTY()
 	float CurrentSpawnAngle = 0.0f;
@@ -3,109 +3,101 @@
 #include "CombatAdvancedMechanics.h"
 #include "CombatStaminaSystem.h"
 #include "CombatSkillSystem.h"
+#include "CombatRules.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UCombatAdvancedMechanics::UCombatAdvancedMechanics()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// windows are timestamps; block drain lives on the stamina system
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
-void UCombatAdvancedMechanics::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+EParryResult UCombatAdvancedMechanics::AttemptParry()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	const double Now = GetNow();
 
-	// Drain stamina while blocking
-	if (bIsBlocking)
+	if (!IsInParryWindow())
 	{
-		if (UCombatStaminaSystem* StaminaSystem = GetOwner()->FindComponentByClass<UCombatStaminaSystem>())
+		// open the window; it closes on its own after GoodParryWindow
+		ParryInputTime = Now;
+		if (UWorld* World = GetWorld())
 		{
-			StaminaSystem->DrainStamina(BlockStaminaDrain * DeltaTime);
-			
-			// Stop blocking if out of stamina
-			if (StaminaSystem->IsExhausted())
-			{
-				StopBlocking();
-			}
+			World->GetTimerManager().SetTimer(ParryWindowTimer, this, &UCombatAdvancedMechanics::CloseParryWindow, FMath::Max(GetTuning().GoodParryWindow, UE_KINDA_SMALL_NUMBER), false);
 		}
+		return EParryResult::Missed;
 	}
 
-	// Update parry timing
-	if (ParryInputTime >= 0.0f)
-	{
-		ParryInputTime += DeltaTime;
-		if (ParryInputTime > GoodParryWindow)
-		{
-			ParryInputTime = -1.0f;
-		}
-	}
+	const double Elapsed = Now - ParryInputTime;
+	CloseParryWindow();
 
-	// Update counter-attack window
-	if (bCanCounterAttack)
+	bCanCounterAttack = true;
+	LastParryTime = Now;
+	if (UWorld* World = GetWorld())
 	{
-		TimeSinceLastParry += DeltaTime;
-		if (TimeSinceLastParry > CounterAttackWindow)
-		{
-			bCanCounterAttack = false;
-		}
+		World->GetTimerManager().SetTimer(CounterWindowTimer, this, &UCombatAdvancedMechanics::CloseCounterWindow, FMath::Max(GetTuning().CounterAttackWindow, UE_KINDA_SMALL_NUMBER), false);
 	}
+
+	return CombatRules::ClassifyParry(float(Elapsed), GetTuning().PerfectParryWindow, GetTuning().GoodParryWindow) == CombatRules::EParryTiming::Perfect ? EParryResult::Perfect : EParryResult::Good;
 }
 
-EParryResult UCombatAdvancedMechanics::AttemptParry()
+void UCombatAdvancedMechanics::StartBlocking()
 {
-	if (ParryInputTime < 0.0f)
+	if (bIsBlocking)
 	{
-		ParryInputTime = 0.0f;
-		return EParryResult::Missed;
+		return;
 	}
 
-	if (ParryInputTime <= PerfectParryWindow)
-	{
-		bCanCounterAttack = true;
-		TimeSinceLastParry = 0.0f;
-		ParryInputTime = -1.0f;
-		return EParryResult::Perfect;
-	}
-	else if (ParryInputTime <= GoodParryWindow)
-	{
-		bCanCounterAttack = true;
-		TimeSinceLastParry = 0.0f;
-		ParryInputTime = -1.0f;
-		return EParryResult::Good;
-	}
+	bIsBlocking = true;
 
-	return EParryResult::Missed;
-}
+	// Drain stamina while blocking
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->StartContinuousDrain(GetBlockStaminaDrain());
 
-void UCombatAdvancedMechanics::StartBlocking()
-{
-	bIsBlocking = true;
+		// Can't hold a block while already out of stamina
+		if (StaminaSystem->IsExhausted())
+		{
+			StopBlocking();
+		}
+	}
 }
 
 void UCombatAdvancedMechanics::StopBlocking()
 {
+	if (!bIsBlocking)
+	{
+		return;
+	}
+
 	bIsBlocking = false;
+
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->StopContinuousDrain();
+	}
 }
 
 bool UCombatAdvancedMechanics::IsInParryWindow() const
 {
-	return ParryInputTime >= 0.0f && ParryInputTime <= GoodParryWindow;
+	return ParryInputTime >= 0.0 && GetNow() - ParryInputTime <= GetTuning().GoodParryWindow;
 }
 
 void UCombatAdvancedMechanics::PerformCounterAttack()
 {
-	if (bCanCounterAttack)
+	if (bCanCounterAttack && GetNow() - LastParryTime <= GetTuning().CounterAttackWindow)
 	{
 		// Counter-attack logic would trigger attack with multiplier
-		bCanCounterAttack = false;
-		TimeSinceLastParry = -1.0f;
+		CloseCounterWindow();
 	}
 }
 
 float UCombatAdvancedMechanics::GetBlockEffectiveness() const
 {
-	float Effectiveness = BaseBlockEffectiveness;
+	float Effectiveness = GetTuning().BaseBlockEffectiveness;
 	
 	// Improve with defense skill
-	if (UCombatSkillSystem* SkillSystem = GetOwner()->FindComponentByClass<UCombatSkillSystem>())
+	if (UCombatSkillSystem* SkillSystem = CombatComponents.Skill)
 	{
 		Effectiveness = SkillSystem->GetDefenseEffectiveness();
 	}
@@ -113,7 +105,70 @@ float UCombatAdvancedMechanics::GetBlockEffectiveness() const
 	return Effectiveness;
 }
 
+double UCombatAdvancedMechanics::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UCombatAdvancedMechanics::CloseParryWindow()
+{
+	ParryInputTime = -1.0;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ParryWindowTimer);
+	}
+}
+
+void UCombatAdvancedMechanics::CloseCounterWindow()
+{
+	bCanCounterAttack = false;
+	LastParryTime = -1.0;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(CounterWindowTimer);
+	}
+}
+
+void UCombatAdvancedMechanics::ResetForRespawn()
+{
+	StopBlocking();
+	CloseParryWindow();
+	CloseCounterWindow();
+}
+
+void UCombatAdvancedMechanics::HandleStaminaExhausted()
+{
+	// Stop blocking if out of stamina
+	StopBlocking();
+}
+
 void UCombatAdvancedMechanics::BeginPlay()
 {
 	Super::BeginPlay();
+
+	CombatComponents.ResolveIfUnwired(this);
+
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->OnStaminaExhausted.AddUniqueDynamic(this, &UCombatAdvancedMechanics::HandleStaminaExhausted);
+	}
+}
+
+void UCombatAdvancedMechanics::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->OnStaminaExhausted.RemoveDynamic(this, &UCombatAdvancedMechanics::HandleStaminaExhausted);
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ParryWindowTimer);
+		World->GetTimerManager().ClearTimer(CounterWindowTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
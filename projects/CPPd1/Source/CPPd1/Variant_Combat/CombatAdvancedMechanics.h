@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "CombatComponentSet.h"
+#include "CombatTuningProfile.h"
 #include "CombatAdvancedMechanics.generated.h"
 
 /** Parry timing window result */
@@ -19,6 +21,9 @@ enum class EParryResult : uint8
 /**
  * Advanced combat mechanics inspired by UFC 5
  * Handles parrying, blocking, counter-attacks, and timing-based mechanics
+ *
+ * Does not tick. Parry and counter windows are timestamps compared against world time;
+ * timers only close them, and blocking drains stamina through a continuous drain on the stamina system.
  */
 UCLASS(ClassGroup=(CPPd1), meta=(BlueprintSpawnableComponent))
 class UCombatAdvancedMechanics : public UActorComponent
@@ -29,7 +34,11 @@ public:
 
 	UCombatAdvancedMechanics();
 
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/** Receive direct pointers to the sibling combat components (set by the owning character) */
+	void SetCombatComponents(const FCombatComponentSet& InComponents) { CombatComponents = InComponents; }
+
+	/** Read tuning from the given profile (set by the owning character) */
+	void SetTuningProfile(UCombatTuningProfile* InProfile) { TuningProfile = InProfile; }
 
 	/** Attempt to parry an incoming attack */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Advanced")
@@ -59,44 +68,57 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Advanced")
 	float GetBlockEffectiveness() const;
 
+	/** Drop the block and close any parry or counter window (in-place respawn) */
+	void ResetForRespawn();
+
 protected:
 
 	/** Is currently blocking */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Advanced")
 	bool bIsBlocking = false;
 
-	/** Parry window duration (perfect timing) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float PerfectParryWindow = 0.1f;
+	/** World time of the parry input that opened the window, negative when closed */
+	double ParryInputTime = -1.0;
 
-	/** Good parry window duration */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float GoodParryWindow = 0.2f;
+	/** World time of the last successful parry, negative when no counter is available */
+	double LastParryTime = -1.0;
 
-	/** Time since parry input */
-	float ParryInputTime = -1.0f;
+	/** Can perform counter-attack */
+	bool bCanCounterAttack = false;
 
-	/** Block stamina drain per second */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float BlockStaminaDrain = 0.1f;
+	/** Closes the parry window */
+	FTimerHandle ParryWindowTimer;
 
-	/** Base block effectiveness (damage reduction) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float BaseBlockEffectiveness = 0.5f;
+	/** Closes the counter-attack window */
+	FTimerHandle CounterWindowTimer;
 
-	/** Perfect parry damage multiplier */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float PerfectParryDamageMultiplier = 2.0f;
+	/** Sibling combat components. Resolved from the owner on BeginPlay if nobody wired them */
+	UPROPERTY(Transient)
+	FCombatComponentSet CombatComponents;
 
-	/** Counter-attack window after parry */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Advanced")
-	float CounterAttackWindow = 1.0f;
+	/** Shared tuning. Null reads the profile defaults */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatTuningProfile> TuningProfile;
 
-	/** Time since last parry */
-	float TimeSinceLastParry = -1.0f;
+	/** Parry, counter and block section of the tuning profile */
+	const FCombatAdvancedTuning& GetTuning() const { return UCombatTuningProfile::GetOrDefault(TuningProfile)->Advanced; }
 
-	/** Can perform counter-attack */
-	bool bCanCounterAttack = false;
+	/** Block drain rate, from the stamina section of the tuning profile */
+	float GetBlockStaminaDrain() const { return UCombatTuningProfile::GetOrDefault(TuningProfile)->Stamina.BlockStaminaDrainRate; }
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Current world time, 0 without a world */
+	double GetNow() const;
+
+	/** ParryWindowTimer callback */
+	void CloseParryWindow();
+
+	/** CounterWindowTimer callback */
+	void CloseCounterWindow();
+
+	/** Stop blocking when the stamina system reports exhaustion */
+	UFUNCTION()
+	void HandleStaminaExhausted();
 };
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatAssetLoader.h"
+#include "CombatVariantAssets.h"
+#include "HAL/PlatformTime.h"
+
+void UCombatAssetLoader::LoadVariant(const FPrimaryAssetId& VariantId)
+{
+	if (!VariantId.IsValid() || VariantId == CurrentVariant)
+	{
+		return;
+	}
+
+	UnloadVariant();
+
+	if (!UAssetManager::Get().GetPrimaryAssetPath(VariantId).IsValid())
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("CombatAssetLoader: %s is not a registered primary asset; its assets will load on demand"), *VariantId.ToString());
+		return;
+	}
+
+	CurrentVariant = VariantId;
+	LoadStartTime = FPlatformTime::Seconds();
+
+	// menu widgets first so the input mode selection screen can come up while the rest streams in.
+	// The Asset Manager calls the delegate even when there is nothing left to load
+	MenuHandle = UAssetManager::Get().LoadPrimaryAsset(VariantId, { UCombatVariantAssets::MenuBundle },
+		FStreamableDelegate::CreateUObject(this, &UCombatAssetLoader::HandleMenuBundleLoaded));
+}
+
+void UCombatAssetLoader::HandleMenuBundleLoaded()
+{
+	GameHandle = UAssetManager::Get().ChangeBundleStateForPrimaryAssets({ CurrentVariant }, { UCombatVariantAssets::GameBundle }, {}, false,
+		FStreamableDelegate::CreateUObject(this, &UCombatAssetLoader::HandleGameBundleLoaded));
+}
+
+void UCombatAssetLoader::HandleGameBundleLoaded()
+{
+	// the classes are in; now the montages and other soft assets they declare
+	TArray<FSoftObjectPath> Paths;
+	if (const UCombatVariantAssets* Variant = UAssetManager::Get().GetPrimaryAssetObject<UCombatVariantAssets>(CurrentVariant))
+	{
+		Variant->GatherClassAssets(Paths);
+	}
+
+	ClassAssetsHandle = RequestAssets(MoveTemp(Paths));
+	if (!ClassAssetsHandle || !ClassAssetsHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &UCombatAssetLoader::HandleClassAssetsLoaded)))
+	{
+		HandleClassAssetsLoaded();
+	}
+}
+
+void UCombatAssetLoader::HandleClassAssetsLoaded()
+{
+	bVariantLoaded = true;
+	UE_LOG(LogCPPd1, Log, TEXT("CombatAssetLoader: %s loaded in %.2f s"), *CurrentVariant.ToString(), FPlatformTime::Seconds() - LoadStartTime);
+}
+
+void UCombatAssetLoader::UnloadVariant()
+{
+	// cancelled handles don't call their delegates, so a late load can't complete the next variant
+	for (TSharedPtr<FStreamableHandle>* Handle : { &MenuHandle, &GameHandle, &ClassAssetsHandle })
+	{
+		if (Handle->IsValid())
+		{
+			(*Handle)->CancelHandle();
+			Handle->Reset();
+		}
+	}
+
+	if (CurrentVariant.IsValid())
+	{
+		UAssetManager::Get().UnloadPrimaryAsset(CurrentVariant);
+		CurrentVariant = FPrimaryAssetId();
+	}
+
+	bVariantLoaded = false;
+}
+
+TSharedPtr<FStreamableHandle> UCombatAssetLoader::RequestAssets(TArray<FSoftObjectPath> Paths)
+{
+	Paths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+	if (Paths.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths));
+}
+
+void UCombatAssetLoader::WarnLoadOnDemand(const FSoftObjectPath& Path)
+{
+	UE_LOG(LogCPPd1, Warning, TEXT("CombatAssetLoader: %s was used before it was loaded; loading it now. Add it to the variant's bundles"), *Path.ToString());
+}
+
+void UCombatAssetLoader::Deinitialize()
+{
+	UnloadVariant();
+
+	Super::Deinitialize();
+}
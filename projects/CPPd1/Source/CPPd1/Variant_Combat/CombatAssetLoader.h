@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "CombatAssetLoader.generated.h"
+
+/**
+ * Loads the active combat variant's assets through the Asset Manager and keeps them resident.
+ * Lives on the game instance, so assets shared by consecutive maps of the same variant stay loaded.
+ *
+ * LoadVariant runs in the background while the map loads: the Menu bundle first, then the Game bundle, then the
+ * soft assets the loaded character and enemy classes declare. Switching variants releases the previous one.
+ *
+ * Anything that is used before its bundle has arrived is loaded on the spot by Resolve, with a warning, so a
+ * missing bundle entry costs a hitch instead of a broken attack.
+ */
+UCLASS()
+class CPPd1_API UCombatAssetLoader : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Start loading a variant's bundles. Does nothing for an invalid id or the variant already loading */
+	void LoadVariant(const FPrimaryAssetId& VariantId);
+
+	/** True once the Game bundle and its class assets are in */
+	bool IsVariantLoaded() const { return bVariantLoaded; }
+
+	/** Loaded asset, or a synchronous load if nothing has loaded it yet. Null for an empty reference */
+	template<typename T>
+	static T* Resolve(const TSoftObjectPtr<T>& Asset)
+	{
+		if (T* Loaded = Asset.Get())
+		{
+			return Loaded;
+		}
+		if (Asset.IsNull())
+		{
+			return nullptr;
+		}
+		WarnLoadOnDemand(Asset.ToSoftObjectPath());
+		return Asset.LoadSynchronous();
+	}
+
+	/** Loaded class, or a synchronous load if nothing has loaded it yet. Null for an empty reference */
+	template<typename T>
+	static UClass* Resolve(const TSoftClassPtr<T>& Class)
+	{
+		if (UClass* Loaded = Class.Get())
+		{
+			return Loaded;
+		}
+		if (Class.IsNull())
+		{
+			return nullptr;
+		}
+		WarnLoadOnDemand(Class.ToSoftObjectPath());
+		return Class.LoadSynchronous();
+	}
+
+	/** Call Callback with the class once it's loaded: right away if it already is, otherwise after an async load */
+	template<typename T>
+	static void LoadClassAsync(UObject* Requester, const TSoftClassPtr<T>& Class, TFunction<void(UClass*)>&& Callback)
+	{
+		if (UClass* Loaded = Class.Get())
+		{
+			Callback(Loaded);
+			return;
+		}
+		if (Class.IsNull())
+		{
+			return;
+		}
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(Class.ToSoftObjectPath(),
+			FStreamableDelegate::CreateWeakLambda(Requester, [Class, Callback = MoveTemp(Callback)]()
+			{
+				if (UClass* Loaded = Class.Get())
+				{
+					Callback(Loaded);
+				}
+			}));
+	}
+
+	/** Async load of the given paths (resident ones are just referenced). Hold the handle to keep them loaded; null if Paths is empty */
+	static TSharedPtr<FStreamableHandle> RequestAssets(TArray<FSoftObjectPath> Paths);
+
+protected:
+
+	virtual void Deinitialize() override;
+
+	/** Release the current variant's bundles */
+	void UnloadVariant();
+
+	void HandleMenuBundleLoaded();
+	void HandleGameBundleLoaded();
+	void HandleClassAssetsLoaded();
+
+	static void WarnLoadOnDemand(const FSoftObjectPath& Path);
+
+	FPrimaryAssetId CurrentVariant;
+
+	/** In-flight or completed bundle and class asset loads; holding them keeps the assets resident */
+	TSharedPtr<FStreamableHandle> MenuHandle;
+	TSharedPtr<FStreamableHandle> GameHandle;
+	TSharedPtr<FStreamableHandle> ClassAssetsHandle;
+
+	bool bVariantLoaded = false;
+
+	/** FPlatformTime::Seconds when LoadVariant started, for the log */
+	double LoadStartTime = 0.0;
+};
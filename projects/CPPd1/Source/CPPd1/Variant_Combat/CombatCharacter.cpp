@@ -2,15 +2,15 @@
 
 
 #include "CombatCharacter.h"
+#include "CPPd1.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
-#include "CombatLifeBar.h"
+#include "CombatLifeBarOverlay.h"
 #include "Engine/DamageEvents.h"
 #include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
@@ -20,6 +20,12 @@
 #include "CombatFlowSystem.h"
 #include "CombatAdvancedMechanics.h"
 #include "CombatSkillSystem.h"
+#include "CombatSimulation.h"
+#include "CombatInputRecorder.h"
+#include "CombatHitchDetector.h"
+#include "CombatAssetLoader.h"
+#include "CPPd1RoundSnapshot.h"
+#include "CombatSaveSystem.h"
 
 ACombatCharacter::ACombatCharacter()
 {
@@ -31,11 +37,12 @@ ACombatCharacter::ACombatCharacter()
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(35.0f, 90.0f);
 
-	// Configure character movement (will be overridden by tuning variables in BeginPlay)
-	GetCharacterMovement()->MaxWalkSpeed = MovementSpeed;
-	GetCharacterMovement()->JumpZVelocity = JumpVelocity;
-	GetCharacterMovement()->AirControl = AirControl;
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, RotationRate, 0.0f);
+	// Configure character movement (overridden by the tuning profile in BeginPlay)
+	const FCombatMovementTuning DefaultMovement;
+	GetCharacterMovement()->MaxWalkSpeed = DefaultMovement.MovementSpeed;
+	GetCharacterMovement()->JumpZVelocity = DefaultMovement.JumpVelocity;
+	GetCharacterMovement()->AirControl = DefaultMovement.AirControl;
+	GetCharacterMovement()->RotationRate = FRotator(0.0f, DefaultMovement.RotationRate, 0.0f);
 
 	// create the camera boom
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -51,9 +58,10 @@ ACombatCharacter::ACombatCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
 
-	// create the life bar widget component
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
+	// create the life bar anchor (drawn by the life bar overlay)
+	LifeBar = CreateDefaultSubobject<USceneComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
+	LifeBar->SetRelativeLocation(FVector(0.0f, 0.0f, 110.0f));
 
 	// set the player tag
 	Tags.Add(FName("Player"));
@@ -64,6 +72,11 @@ void ACombatCharacter::Move(const FInputActionValue& Value)
 	// input is a Vector2D
 	FVector2D MovementVector = Value.Get<FVector2D>();
 
+	if (!CaptureInput(ECombatRecordedInput::Move, MovementVector))
+	{
+		return;
+	}
+
 	// route the input
 	DoMove(MovementVector.X, MovementVector.Y);
 }
@@ -72,30 +85,49 @@ void ACombatCharacter::Look(const FInputActionValue& Value)
 {
 	FVector2D LookAxisVector = Value.Get<FVector2D>();
 
+	if (!CaptureInput(ECombatRecordedInput::Look, LookAxisVector))
+	{
+		return;
+	}
+
 	// route the input
 	DoLook(LookAxisVector.X, LookAxisVector.Y);
 }
 
 void ACombatCharacter::ComboAttackPressed()
 {
-	// route the input
-	DoComboAttackStart();
+	if (CaptureInput(ECombatRecordedInput::ComboAttack))
+	{
+		// route the input
+		DoComboAttackStart();
+	}
 }
 
 void ACombatCharacter::ChargedAttackPressed()
 {
-	// route the input
-	DoChargedAttackStart();
+	if (CaptureInput(ECombatRecordedInput::ChargedAttackStart))
+	{
+		// route the input
+		DoChargedAttackStart();
+	}
 }
 
 void ACombatCharacter::ChargedAttackReleased()
 {
-	// route the input
-	DoChargedAttackEnd();
+	if (CaptureInput(ECombatRecordedInput::ChargedAttackEnd))
+	{
+		// route the input
+		DoChargedAttackEnd();
+	}
 }
 
 void ACombatCharacter::LockOnPressed()
 {
+	if (!CaptureInput(ECombatRecordedInput::LockOn))
+	{
+		return;
+	}
+
 	if (LockOnTarget)
 	{
 		DoClearLockOn();
@@ -106,6 +138,57 @@ void ACombatCharacter::LockOnPressed()
 	}
 }
 
+bool ACombatCharacter::CaptureInput(ECombatRecordedInput Input, const FVector2D& Value)
+{
+	UCombatInputRecorder* Recorder = GetWorld()->GetSubsystem<UCombatInputRecorder>();
+	if (!Recorder)
+	{
+		return true;
+	}
+
+	if (Recorder->IsReplaying())
+	{
+		return false;
+	}
+
+	Recorder->RecordInput(this, Input, Value);
+	return true;
+}
+
+void ACombatCharacter::DispatchRecordedInput(ECombatRecordedInput Input, const FVector2D& Value)
+{
+	switch (Input)
+	{
+	case ECombatRecordedInput::Move:
+		DoMove(Value.X, Value.Y);
+		break;
+	case ECombatRecordedInput::Look:
+		DoLook(Value.X, Value.Y);
+		break;
+	case ECombatRecordedInput::ComboAttack:
+		DoComboAttackStart();
+		break;
+	case ECombatRecordedInput::ChargedAttackStart:
+		DoChargedAttackStart();
+		break;
+	case ECombatRecordedInput::ChargedAttackEnd:
+		DoChargedAttackEnd();
+		break;
+	case ECombatRecordedInput::LockOn:
+		if (LockOnTarget)
+		{
+			DoClearLockOn();
+		}
+		else
+		{
+			DoLockOn();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
 void ACombatCharacter::DoLockOn()
 {
 	TArray<AActor*> Targets;
@@ -243,7 +326,12 @@ void ACombatCharacter::ResetHP()
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->SetBarPercent(LifeBarHandle, 1.0f);
+	}
+
+	OnHealthChanged.Broadcast(CurrentHP, MaxHP);
 }
 
 void ACombatCharacter::ComboAttack()
@@ -257,13 +345,14 @@ void ACombatCharacter::ComboAttack()
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ComboAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		UAnimMontage* Montage = UCombatAssetLoader::Resolve(ComboAttackMontage);
+		const float MontageLength = AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, Montage);
 		}
 	}
 
@@ -280,13 +369,14 @@ void ACombatCharacter::ChargedAttack()
 	// play the charged attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		UAnimMontage* Montage = UCombatAssetLoader::Resolve(ChargedAttackMontage);
+		const float MontageLength = AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, Montage);
 		}
 	}
 }
@@ -315,6 +405,9 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
+	COMBAT_SCOPE(AttackTrace);
+	INC_DWORD_STAT(STAT_CombatAttackTraces);
+
 	// sweep for objects in front of the character to be hit by the attack
 	TArray<FHitResult> OutHits;
 
@@ -349,7 +442,7 @@ void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
 
 				// Apply global damage multiplier
-				float FinalDamage = MeleeDamage * GlobalDamageMultiplier;
+				float FinalDamage = MeleeDamage * GetTuningProfile()->Combat.GlobalDamageMultiplier;
 
 				// pass the damage event to the actor
 				Damageable->ApplyDamage(FinalDamage, this, CurrentHit.ImpactPoint, Impulse);
@@ -381,7 +474,7 @@ void ACombatCharacter::CheckCombo()
 				// jump to the next combo section
 				if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 				{
-					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage);
+					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage.Get());
 				}
 			}
 		}
@@ -396,12 +489,14 @@ void ACombatCharacter::CheckChargedAttack()
 	// jump to either the loop or the attack section depending on whether we're still holding the charge button
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage);
+		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage.Get());
 	}
 }
 
 void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	COMBAT_SCOPE(ApplyDamage);
+
 	// pass the damage event to the actor
 	FDamageEvent DamageEvent;
 	const float ActualDamage = TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
@@ -432,9 +527,15 @@ void ACombatCharacter::HandleDeath()
 
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
+	INC_DWORD_STAT(STAT_CombatActiveRagdolls);
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::PlayerDied, this);
+	UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::RagdollOn, this);
 
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->SetBarHidden(LifeBarHandle, true);
+	}
 
 	// pull back the camera
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
@@ -448,10 +549,119 @@ void ACombatCharacter::ApplyHealing(float Healing, AActor* Healer)
 	// stub
 }
 
+void ACombatCharacter::ApplyHazardDamage(float Damage, AActor* Hazard, const FVector& DamageLocation)
+{
+	TGuardValue<bool> HazardGuard(bTakingHazardDamage, true);
+	ApplyDamage(Damage, Hazard, DamageLocation, FVector::ZeroVector);
+}
+
 void ACombatCharacter::RespawnCharacter()
 {
-	// destroy the character and let it be respawned by the Player Controller
-	Destroy();
+	// without a combat controller there's no checkpoint to return to; destroy and let whoever owns us handle it
+	ACombatPlayerController* PC = Cast<ACombatPlayerController>(GetController());
+	if (!PC)
+	{
+		UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::RagdollOff, this);
+		UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::PlayerRespawned, this);
+		Destroy();
+		return;
+	}
+
+	ResetForRespawn(PC->GetRespawnTransform());
+
+	// the ghost mirrors our inputs, so bring it along to the checkpoint
+	if (GhostCharacter)
+	{
+		GhostCharacter->ResetForRespawn(PC->GetRespawnTransform());
+	}
+}
+
+void ACombatCharacter::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	ResetForRespawn(RoundStartTransform);
+}
+
+void ACombatCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	const bool bWasDead = CurrentHP <= 0.0f;
+
+	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// leave ragdoll: stop simulating, snap the mesh back under the capsule
+	USkeletalMeshComponent* CharacterMesh = GetMesh();
+	CharacterMesh->SetSimulatePhysics(false);
+	CharacterMesh->SetPhysicsBlendWeight(0.0f);
+	CharacterMesh->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	CharacterMesh->SetRelativeTransform(MeshStartingTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (bWasDead)
+	{
+		DEC_DWORD_STAT(STAT_CombatActiveRagdolls);
+		UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::RagdollOff, this);
+	}
+
+	// drop any attack in progress
+	if (UAnimInstance* AnimInstance = CharacterMesh->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+	bIsAttacking = false;
+	bIsChargingAttack = false;
+	bHasLoopedChargedAttack = false;
+	ComboCount = 0;
+	CachedAttackInputTime = 0.0f;
+	LockOnTarget = nullptr;
+
+	// same invincibility window a freshly spawned character gets
+	TimeSinceLastDamage = 0.0f;
+
+	// movement back on, at the checkpoint
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	Movement->StopMovementImmediately();
+	Movement->SetDefaultMovementMode();
+	ConsumeMovementInputVector();
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	if (AController* CurrentController = GetController())
+	{
+		CurrentController->SetControlRotation(SpawnTransform.Rotator());
+	}
+	StoredControlRotation = SpawnTransform.Rotator();
+
+	// camera back in
+	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
+
+	// combat components start over; skills first, stamina reads its efficiency from them
+	if (UCombatSkillSystem* SkillSystem = CombatComponents.Skill)
+	{
+		SkillSystem->ResetForRespawn();
+	}
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->ResetForRespawn();
+	}
+	if (UCombatFlowSystem* FlowSystem = CombatComponents.Flow)
+	{
+		FlowSystem->ResetForRespawn();
+	}
+	if (UCombatAdvancedMechanics* AdvancedMech = CombatComponents.AdvancedMechanics)
+	{
+		AdvancedMech->ResetForRespawn();
+	}
+
+	// full HP and the life bar back on screen
+	ResetHP();
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->SetBarHidden(LifeBarHandle, false);
+	}
+
+	if (bWasDead)
+	{
+		UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::PlayerRespawned, this);
+	}
+
+	Respawned();
 }
 
 float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -462,14 +672,16 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 		return 0.0f;
 	}
 
+	const FCombatGeneralTuning& Tuning = GetTuningProfile()->Combat;
+
 	// Check invincibility frames
-	if (TimeSinceLastDamage < InvincibilityFrames)
+	if (!bTakingHazardDamage && TimeSinceLastDamage < Tuning.InvincibilityFrames)
 	{
 		return 0.0f;
 	}
 
 	// Apply global defense multiplier
-	Damage *= GlobalDefenseMultiplier;
+	Damage *= Tuning.GlobalDefenseMultiplier;
 
 	// only process damage if the character is still alive
 	if (CurrentHP <= 0.0f)
@@ -479,6 +691,7 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 
 	// reduce the current HP
 	CurrentHP -= Damage;
+	OnHealthChanged.Broadcast(CurrentHP, MaxHP);
 
 	// have we run out of HP?
 	if (CurrentHP <= 0.0f)
@@ -489,15 +702,21 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+		{
+			Overlay->SetBarPercent(LifeBarHandle, CurrentHP / MaxHP);
+		}
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
 		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
 	}
 
-	// Reset invincibility timer
-	TimeSinceLastDamage = 0.0f;
+	// Reset invincibility timer. Hazards tick steadily and would otherwise shield the character from attacks
+	if (!bTakingHazardDamage)
+	{
+		TimeSinceLastDamage = 0.0f;
+	}
 
 	// return the received damage amount
 	return Damage;
@@ -519,15 +738,26 @@ void ACombatCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Apply tuning variables to character movement
-	GetCharacterMovement()->MaxWalkSpeed = MovementSpeed;
-	GetCharacterMovement()->JumpZVelocity = JumpVelocity;
-	GetCharacterMovement()->AirControl = AirControl;
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, RotationRate, 0.0f);
+	// normally already resident from the variant's bundles; this keeps them loaded either way
+	TArray<FSoftObjectPath> PreloadPaths;
+	GatherPreloadAssets(PreloadPaths);
+	PreloadHandle = UCombatAssetLoader::RequestAssets(MoveTemp(PreloadPaths));
+
+	ApplyMovementTuning();
 
-	// get the life bar from the widget component
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
+#if WITH_EDITOR
+	// balance edits made while PIE is running apply on the spot
+	TuningProfileChangedHandle = UCombatTuningProfile::OnProfileChanged.AddUObject(this, &ACombatCharacter::HandleTuningProfileChanged);
+#endif // WITH_EDITOR
+
+	// register the life bar with the overlay (ghosts don't get one)
+	if (!bIsGhost)
+	{
+		if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+		{
+			LifeBarHandle = Overlay->RegisterBar(LifeBar, LifeBarColor);
+		}
+	}
 
 	// initialize the camera
 	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
@@ -535,18 +765,14 @@ void ACombatCharacter::BeginPlay()
 	// save the relative transform for the mesh so we can reset the ragdoll later
 	MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
-	// set the life bar color
-	LifeBarWidget->SetBarColor(LifeBarColor);
-
 	// reset HP to maximum
 	ResetHP();
 
-	// Initialize tuning variables for component systems
-	InitializeTuningVariables();
+	// round resets revive us in place
+	UCPPd1RoundSnapshot::Register(this);
 
 	if (bIsGhost)
 	{
-		if (LifeBar) LifeBar->SetHiddenInGame(true);
 		if (CameraBoom) CameraBoom->SetHiddenInGame(true);
 		if (FollowCamera) FollowCamera->SetHiddenInGame(true);
 	}
@@ -591,43 +817,184 @@ void ACombatCharacter::Tick(float DeltaTime)
 	}
 }
 
+void ACombatCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// one pass over the component list; everything after this uses direct pointers
+	CombatComponents.Resolve(this);
+	CombatComponents.Wire();
+
+	// components read the profile in their own BeginPlay, so hand it over first
+	InitializeTuningVariables();
+}
+
 void ACombatCharacter::InitializeTuningVariables()
 {
-	// Initialize component systems with tuning variables if they exist
-	// This allows the tuning variables to be set in the inspector and applied to components
-	
-	// Stamina System
-	if (UCombatStaminaSystem* StaminaSystem = FindComponentByClass<UCombatStaminaSystem>())
+	// components read the shared profile directly; only per-instance state is set here
+	const UCombatTuningProfile* Profile = GetTuningProfile();
+
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
 	{
-		// Note: These would need setters in the component, or we set them via reflection
-		// For now, the component uses its own defaults, but you can override in Blueprint
+		StaminaSystem->SetTuningProfile(TuningProfile);
+		StaminaSystem->CurrentStamina = Profile->Stamina.MaxStamina;
 	}
 
-	// Flow System
-	if (UCombatFlowSystem* FlowSystem = FindComponentByClass<UCombatFlowSystem>())
+	if (UCombatFlowSystem* FlowSystem = CombatComponents.Flow)
 	{
-		// Same note as above
+		FlowSystem->SetTuningProfile(TuningProfile);
 	}
 
-	// Advanced Mechanics
-	if (UCombatAdvancedMechanics* AdvancedMech = FindComponentByClass<UCombatAdvancedMechanics>())
+	if (UCombatAdvancedMechanics* AdvancedMech = CombatComponents.AdvancedMechanics)
 	{
-		// Same note as above
+		AdvancedMech->SetTuningProfile(TuningProfile);
 	}
 
-	// Skill System
-	if (UCombatSkillSystem* SkillSystem = FindComponentByClass<UCombatSkillSystem>())
+	if (UCombatSkillSystem* SkillSystem = CombatComponents.Skill)
 	{
-		// Same note as above
+		SkillSystem->SetTuningProfile(TuningProfile);
+		for (FCombatSkillData& Skill : SkillSystem->Skills)
+		{
+			Skill.SkillLevel = Profile->Skill.StartingSkillLevel;
+		}
+
+		// siblings read the cached multipliers in their BeginPlay
+		SkillSystem->RefreshDerivedValues();
 	}
 }
 
+void ACombatCharacter::ApplyMovementTuning()
+{
+	const FCombatMovementTuning& Movement = GetTuningProfile()->Movement;
+	GetCharacterMovement()->MaxWalkSpeed = Movement.MovementSpeed;
+	GetCharacterMovement()->JumpZVelocity = Movement.JumpVelocity;
+	GetCharacterMovement()->AirControl = Movement.AirControl;
+	GetCharacterMovement()->RotationRate = FRotator(0.0f, Movement.RotationRate, 0.0f);
+}
+
+void ACombatCharacter::HandleTuningProfileChanged(const UCombatTuningProfile* Profile)
+{
+	if (Profile != GetTuningProfile())
+	{
+		return;
+	}
+
+	ApplyMovementTuning();
+
+	if (UCombatSkillSystem* SkillSystem = CombatComponents.Skill)
+	{
+		SkillSystem->RefreshDerivedValues();
+	}
+
+	if (UCombatStaminaSystem* StaminaSystem = CombatComponents.Stamina)
+	{
+		StaminaSystem->RefreshTuning();
+	}
+
+	if (UCombatFlowSystem* FlowSystem = CombatComponents.Flow)
+	{
+		FlowSystem->RefreshTuning();
+	}
+
+	UE_LOG(LogCombatCharacter, Log, TEXT("%s: re-applied tuning profile %s"), *GetName(), *GetNameSafe(Profile));
+}
+
+#if WITH_EDITOR
+void ACombatCharacter::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ACombatCharacter, TuningProfile) && HasActorBegunPlay())
+	{
+		// point the components at the new profile without resetting stamina or skill progress
+		const FCombatComponentSet& Components = CombatComponents;
+		if (Components.Stamina) Components.Stamina->SetTuningProfile(TuningProfile);
+		if (Components.Flow) Components.Flow->SetTuningProfile(TuningProfile);
+		if (Components.AdvancedMechanics) Components.AdvancedMechanics->SetTuningProfile(TuningProfile);
+		if (Components.Skill) Components.Skill->SetTuningProfile(TuningProfile);
+
+		HandleTuningProfileChanged(GetTuningProfile());
+	}
+}
+#endif // WITH_EDITOR
+
+void ACombatCharacter::GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	OutPaths.Add(ComboAttackMontage.ToSoftObjectPath());
+	OutPaths.Add(ChargedAttackMontage.ToSoftObjectPath());
+}
+
+void ACombatCharacter::ExportSimulationTuning(FCombatSimFighterTuning& Out) const
+{
+	const UCombatTuningProfile* Profile = GetTuningProfile();
+
+	Out.bHasCombatSystems = true;
+
+	Out.MaxHP = MaxHP;
+	Out.MeleeDamage = MeleeDamage;
+	Out.GlobalDamageMultiplier = Profile->Combat.GlobalDamageMultiplier;
+	Out.GlobalDefenseMultiplier = Profile->Combat.GlobalDefenseMultiplier;
+	Out.InvincibilityFrames = Profile->Combat.InvincibilityFrames;
+	Out.ComboStages = FMath::Max(1, ComboSectionNames.Num());
+
+	const FCombatStaminaTuning& Stamina = Profile->Stamina;
+	Out.MaxStamina = Stamina.MaxStamina;
+	Out.LightAttackStaminaCost = Stamina.LightAttackStaminaCost;
+	Out.HeavyAttackStaminaCost = Stamina.HeavyAttackStaminaCost;
+	Out.BlockStaminaDrainRate = Stamina.BlockStaminaDrainRate;
+	Out.BaseStaminaRecoveryRate = Stamina.BaseRecoveryRate;
+	Out.ExhaustedStaminaRecoveryRate = Stamina.ExhaustedRecoveryRate;
+	Out.StaminaRecoveryDelay = Stamina.RecoveryDelay;
+	Out.ExhaustionThreshold = Stamina.ExhaustionThreshold;
+
+	const FCombatFlowTuning& Flow = Profile->Flow;
+	Out.MaxFlow = Flow.MaxFlow;
+	Out.FlowDecayRate = Flow.FlowDecayRate;
+	Out.FlowStateThreshold = Flow.FlowStateThreshold;
+	Out.FlowStateMultiplier = Flow.FlowStateMultiplier;
+	Out.ComboFlowPoints = Flow.GetComboFlowPoints();
+	Out.ComboResetTime = Flow.ComboResetTime;
+
+	const FCombatAdvancedTuning& Advanced = Profile->Advanced;
+	Out.PerfectParryWindow = Advanced.PerfectParryWindow;
+	Out.GoodParryWindow = Advanced.GoodParryWindow;
+	Out.PerfectParryDamageMultiplier = Advanced.PerfectParryDamageMultiplier;
+	Out.CounterAttackWindow = Advanced.CounterAttackWindow;
+
+	const FCombatSkillTuning& Skill = Profile->Skill;
+	Out.StartingSkillLevel = Skill.StartingSkillLevel;
+	Out.BaseDamageMultiplier = Skill.BaseDamageMultiplier;
+	Out.MaxDamageMultiplier = Skill.MaxDamageMultiplier;
+	Out.BaseDefenseEffectiveness = Skill.BaseDefenseEffectiveness;
+	Out.MaxDefenseEffectiveness = Skill.MaxDefenseEffectiveness;
+	Out.ExperienceMultiplier = Skill.ExperienceMultiplier;
+}
+
 void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+#if WITH_EDITOR
+	UCombatTuningProfile::OnProfileChanged.Remove(TuningProfileChangedHandle);
+#endif // WITH_EDITOR
+
+	UCPPd1RoundSnapshot::Unregister(this);
+
+	// release the life bar
+	if (UCombatLifeBarOverlay* Overlay = GetWorld()->GetSubsystem<UCombatLifeBarOverlay>())
+	{
+		Overlay->UnregisterBar(LifeBarHandle);
+	}
+	LifeBarHandle = INDEX_NONE;
+
 	// clear the respawn timer
 	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// dead characters leave as ragdolls
+	if (CurrentHP <= 0.0f)
+	{
+		DEC_DWORD_STAT(STAT_CombatActiveRagdolls);
+	}
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -664,6 +1031,9 @@ void ACombatCharacter::NotifyControllerChanged()
 	if (ACombatPlayerController* PC = Cast<ACombatPlayerController>(GetController()))
 	{
 		PC->SetRespawnTransform(GetActorTransform());
+
+		// continue a saved session: progression, flow and the saved checkpoint
+		UCombatSaveSystem::Restore(this);
 	}
 }
 
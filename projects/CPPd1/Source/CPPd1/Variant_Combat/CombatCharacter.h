@@ -6,18 +6,25 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CPPd1RoundResettable.h"
 #include "Animation/AnimInstance.h"
+#include "CombatComponentSet.h"
+#include "CombatTuningProfile.h"
 #include "CombatCharacter.generated.h"
 
 class USpringArmComponent;
 class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
-class UCombatLifeBar;
-class UWidgetComponent;
+struct FCombatSimFighterTuning;
+struct FStreamableHandle;
+enum class ECombatRecordedInput : uint8;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
+/** HP changed delegate (damage, reset) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatHealthChanged, float, CurrentHP, float, MaxHP);
+
 /**
  *  An enhanced Third Person Character with melee combat capabilities:
  *  - Combo attack string
@@ -27,7 +34,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
  *  - Respawning
  */
 UCLASS(BlueprintType, Blueprintable)
-class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable
+class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable, public ICPPd1RoundResettable
 {
 	GENERATED_BODY()
 
@@ -39,9 +46,9 @@ class ACombatCharacter : public ACharacter, public ICombatAttacker, public IComb
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
 
-	/** Life bar widget component */
+	/** Life bar anchor. The bar itself is drawn by the UCombatLifeBarOverlay subsystem */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
+	USceneComponent* LifeBar;
 	
 protected:
 
@@ -117,9 +124,8 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
-	UPROPERTY(EditAnywhere, Category="Damage")
-	TObjectPtr<UCombatLifeBar> LifeBarWidget;
+	/** Handle of this character's bar in the life bar overlay (INDEX_NONE if not shown) */
+	int32 LifeBarHandle = INDEX_NONE;
 
 	/** Max amount of time that may elapse for a non-combo attack input to not be considered stale */
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
@@ -151,9 +157,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 300.0f;
 
-	/** AnimMontage that will play for combo attacks */
+	/** AnimMontage that will play for combo attacks. Soft: loaded with the variant's bundles or on BeginPlay */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
-	UAnimMontage* ComboAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ComboAttackMontage;
 
 	/** Names of the AnimMontage sections that correspond to each stage of the combo attack */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
@@ -166,9 +172,9 @@ protected:
 	/** Index of the current stage of the melee attack combo */
 	int32 ComboCount = 0;
 
-	/** AnimMontage that will play for charged attacks */
+	/** AnimMontage that will play for charged attacks. Soft: loaded with the variant's bundles or on BeginPlay */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
-	UAnimMontage* ChargedAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ChargedAttackMontage;
 
 	/** Name of the AnimMontage section that corresponds to the charge loop */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
@@ -196,145 +202,20 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Respawn", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float RespawnTime = 3.0f;
 
-	// ========== TUNING VARIABLES - EXPOSED FOR INSPECTOR ==========
-
-	/** Character movement speed (walk speed) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Movement", meta = (ClampMin = 0, Units = "cm/s"))
-	float MovementSpeed = 400.0f;
-
-	/** Character jump velocity */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Movement", meta = (ClampMin = 0, Units = "cm/s"))
-	float JumpVelocity = 500.0f;
-
-	/** Air control amount (0.0 = no control, 1.0 = full control) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Movement", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float AirControl = 0.35f;
-
-	/** Character rotation rate (how fast character turns) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Movement", meta = (ClampMin = 0, Units = "deg/s"))
-	float RotationRate = 500.0f;
-
-	// Trick System Tuning
-	/** Maximum time between trick inputs to maintain combo (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Trick System", meta = (ClampMin = 0.0f, ClampMax = 2.0f, Units = "s"))
-	float TrickInputGapTime = 0.5f;
-
-	/** Base flow points awarded for any trick */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Trick System", meta = (ClampMin = 0.0f))
-	float BaseTrickFlowPoints = 10.0f;
-
-	/** Flow point multiplier for complex tricks */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Trick System", meta = (ClampMin = 1.0f))
-	float ComplexTrickMultiplier = 1.5f;
-
-	// Skill System Tuning
-	/** Starting skill level for all skills (0-100) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Skill System", meta = (ClampMin = 0.0f, ClampMax = 100.0f))
-	float StartingSkillLevel = 0.0f;
-
-	/** Experience multiplier for skill gains (1.0 = normal, 2.0 = double) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Skill System", meta = (ClampMin = 0.1f, ClampMax = 10.0f))
-	float SkillExperienceMultiplier = 1.0f;
-
-	/** Base damage multiplier at skill level 0 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Skill System", meta = (ClampMin = 0.1f))
-	float BaseDamageMultiplier = 0.5f;
-
-	/** Maximum damage multiplier at skill level 100 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Skill System", meta = (ClampMin = 1.0f))
-	float MaxDamageMultiplier = 2.0f;
-
-	// Stamina System Tuning
-	/** Maximum stamina (0.0 to 1.0) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float MaxStamina = 1.0f;
-
-	/** Stamina drain per light attack */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float LightAttackStaminaCost = 0.10f;
-
-	/** Stamina drain per heavy attack */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float HeavyAttackStaminaCost = 0.25f;
-
-	/** Stamina drain per second while blocking */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float BlockStaminaDrainRate = 0.15f;
-
-	/** Base stamina recovery rate per second */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f))
-	float BaseStaminaRecoveryRate = 0.2f;
-
-	/** Time delay before stamina starts recovering after drain */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, Units = "s"))
-	float StaminaRecoveryDelay = 1.0f;
-
-	/** Stamina threshold for exhaustion (below this = exhausted) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float ExhaustionThreshold = 0.2f;
-
-	// Flow System Tuning
-	/** Maximum flow meter (0.0 to 1.0) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float MaxFlow = 1.0f;
-
-	/** Flow decay rate per second */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 0.0f))
-	float FlowDecayRate = 0.1f;
-
-	/** Flow threshold to enter flow state (0.0 to 1.0) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float FlowStateThreshold = 0.7f;
-
-	/** Damage/speed multiplier when in flow state */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 1.0f))
-	float FlowStateMultiplier = 1.5f;
-
-	/** Flow points per combo hit */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 0.0f))
-	float FlowPointsPerCombo = 5.0f;
-
-	/** Time before combo resets (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Flow System", meta = (ClampMin = 0.0f, Units = "s"))
-	float ComboResetTime = 3.0f;
-
-	// Advanced Mechanics Tuning
-	/** Perfect parry window duration (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Advanced Mechanics", meta = (ClampMin = 0.0f, ClampMax = 1.0f, Units = "s"))
-	float PerfectParryWindow = 0.1f;
-
-	/** Good parry window duration (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Advanced Mechanics", meta = (ClampMin = 0.0f, ClampMax = 1.0f, Units = "s"))
-	float GoodParryWindow = 0.2f;
-
-	/** Perfect parry damage multiplier */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Advanced Mechanics", meta = (ClampMin = 1.0f))
-	float PerfectParryDamageMultiplier = 2.0f;
-
-	/** Counter-attack window after parry (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Advanced Mechanics", meta = (ClampMin = 0.0f, Units = "s"))
-	float CounterAttackWindow = 1.0f;
-
-	/** Base block effectiveness (damage reduction, 0.0 to 1.0) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Advanced Mechanics", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float BaseBlockEffectiveness = 0.5f;
-
-	// General Combat Tuning
-	/** Global damage multiplier (affects all damage dealt) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Combat", meta = (ClampMin = 0.0f))
-	float GlobalDamageMultiplier = 1.0f;
-
-	/** Global defense multiplier (affects all damage received) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Combat", meta = (ClampMin = 0.0f))
-	float GlobalDefenseMultiplier = 1.0f;
-
-	/** Invincibility frames after taking damage (in seconds) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Combat", meta = (ClampMin = 0.0f, Units = "s"))
-	float InvincibilityFrames = 0.5f;
+	/** Shared balance values for this character and its combat components. Empty uses the profile defaults */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Tuning")
+	TObjectPtr<UCombatTuningProfile> TuningProfile;
 
 	/** Time since last damage taken */
 	float TimeSinceLastDamage = 0.0f;
 
+	/** Set while ApplyHazardDamage runs, so TakeDamage skips the invincibility frames */
+	bool bTakingHazardDamage = false;
+
+	/** Combat components on this character, resolved once in PostInitializeComponents */
+	UPROPERTY(Transient)
+	FCombatComponentSet CombatComponents;
+
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
 
@@ -369,8 +250,14 @@ protected:
 	/** Called when lock-on input is triggered */
 	void LockOnPressed();
 
+	/** Hands a live input to the input recorder. Returns false while a replay drives this character, so the live input is dropped */
+	bool CaptureInput(ECombatRecordedInput Input, const FVector2D& Value = FVector2D::ZeroVector);
+
 public:
 
+	/** Routes a recorded input to the same handler the live binding would. Override to route subclass actions */
+	virtual void DispatchRecordedInput(ECombatRecordedInput Input, const FVector2D& Value);
+
 	/** Handles move inputs from either controls or UI interfaces */
 	UFUNCTION(BlueprintCallable, Category="Input")
 	virtual void DoMove(float Right, float Forward);
@@ -427,6 +314,25 @@ public:
 	UFUNCTION(BlueprintPure, Category="Damage")
 	float GetMaxHP() const { return MaxHP; }
 
+	/** Current lock-on target, or null */
+	AActor* GetLockOnTarget() const { return LockOnTarget; }
+
+	/** Cached combat components (stamina, flow, skill, advanced mechanics); entries may be null */
+	const FCombatComponentSet& GetCombatComponents() const { return CombatComponents; }
+
+	/** Tuning this character reads at runtime: its profile, or the profile defaults */
+	const UCombatTuningProfile* GetTuningProfile() const { return UCombatTuningProfile::GetOrDefault(TuningProfile); }
+
+	/** Soft assets this class needs during play; preloaded by UCombatAssetLoader with the variant's Game bundle */
+	virtual void GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
+	/** Copies this character's tuning into the headless combat simulator's fighter description */
+	void ExportSimulationTuning(FCombatSimFighterTuning& Out) const;
+
+	/** HP changed delegate. Lets the HUD update without polling */
+	UPROPERTY(BlueprintAssignable, Category="Events")
+	FOnCombatHealthChanged OnHealthChanged;
+
 protected:
 
 	/** Resets the character's current HP to maximum */
@@ -468,11 +374,33 @@ public:
 	/** Handles healing events */
 	virtual void ApplyHealing(float Healing, AActor* Healer) override;
 
+	/** Hazard damage ignores invincibility frames and doesn't start them */
+	virtual void ApplyHazardDamage(float Damage, AActor* Hazard, const FVector& DamageLocation) override;
+
 	// ~end CombatDamageable interface
 
-	/** Called from the respawn timer to destroy and re-create the character */
+	/** Called from the respawn timer to bring the character back at the controller's checkpoint */
 	void RespawnCharacter();
 
+	// ~begin ICPPd1RoundResettable interface
+
+	/** Nothing beyond the transform: a character starts every round fresh */
+	virtual void CaptureRoundState() override {}
+
+	/** Revive in place at the round start transform */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+
+	// ~end ICPPd1RoundResettable interface
+
+protected:
+
+	/**
+	 *  Revive in place at the given transform: HP, ragdoll, mesh, camera, movement, attack state and combat
+	 *  components go back to how a freshly spawned character starts. Keeps the components, widgets and ghost,
+	 *  so it allocates nothing. Subclasses reset their own state and call Super
+	 */
+	virtual void ResetForRespawn(const FTransform& SpawnTransform);
+
 public:
 
 	/** Overrides the default TakeDamage functionality */
@@ -491,17 +419,41 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat")
 	void ReceivedDamage(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection);
 
+	/** Blueprint handler for an in-place respawn. BeginPlay doesn't run again, so reset Blueprint state here */
+	UFUNCTION(BlueprintImplementableEvent, Category="Combat")
+	void Respawned();
+
 protected:
 
+	/** Resolves and wires the combat components, then pushes tuning into them (before any BeginPlay) */
+	virtual void PostInitializeComponents() override;
+
 	/** Initialization */
 	virtual void BeginPlay() override;
 
 	/** Called every frame */
 	virtual void Tick(float DeltaTime) override;
 
-	/** Initialize tuning variables for component systems */
+	/** Hand the tuning profile to the combat components and set the starting stamina and skill levels */
 	void InitializeTuningVariables();
 
+	/** Copy the movement tuning into the character movement component. Also runs whenever the profile is edited */
+	virtual void ApplyMovementTuning();
+
+	/** Re-apply cached tuning after a profile was edited (PIE hot reload) */
+	void HandleTuningProfileChanged(const UCombatTuningProfile* Profile);
+
+#if WITH_EDITOR
+	/** Re-apply tuning when the profile is swapped on a playing instance */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif // WITH_EDITOR
+
+	/** Subscription to UCombatTuningProfile::OnProfileChanged */
+	FDelegateHandle TuningProfileChangedHandle;
+
+	/** Keeps this character's soft assets loaded while it plays */
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
 	/** Cleanup */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
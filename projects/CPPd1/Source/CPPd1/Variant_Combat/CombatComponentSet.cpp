@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatComponentSet.h"
+#include "CombatStaminaSystem.h"
+#include "CombatFlowSystem.h"
+#include "CombatSkillSystem.h"
+#include "CombatAdvancedMechanics.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+void FCombatComponentSet::Resolve(const AActor* Owner)
+{
+	*this = FCombatComponentSet();
+
+	if (!Owner)
+	{
+		return;
+	}
+
+	Owner->ForEachComponent(false, [this](UActorComponent* Component)
+	{
+		if (UCombatStaminaSystem* AsStamina = Cast<UCombatStaminaSystem>(Component))
+		{
+			if (!Stamina) Stamina = AsStamina;
+		}
+		else if (UCombatFlowSystem* AsFlow = Cast<UCombatFlowSystem>(Component))
+		{
+			if (!Flow) Flow = AsFlow;
+		}
+		else if (UCombatSkillSystem* AsSkill = Cast<UCombatSkillSystem>(Component))
+		{
+			if (!Skill) Skill = AsSkill;
+		}
+		else if (UCombatAdvancedMechanics* AsAdvanced = Cast<UCombatAdvancedMechanics>(Component))
+		{
+			if (!AdvancedMechanics) AdvancedMechanics = AsAdvanced;
+		}
+	});
+}
+
+void FCombatComponentSet::ResolveIfUnwired(const UActorComponent* Component)
+{
+	if (!Component || Stamina.Get() == Component || Flow.Get() == Component || Skill.Get() == Component || AdvancedMechanics.Get() == Component)
+	{
+		return;
+	}
+
+	Resolve(Component->GetOwner());
+}
+
+void FCombatComponentSet::Wire() const
+{
+	if (Stamina) Stamina->SetCombatComponents(*this);
+	if (Flow) Flow->SetCombatComponents(*this);
+	if (Skill) Skill->SetCombatComponents(*this);
+	if (AdvancedMechanics) AdvancedMechanics->SetCombatComponents(*this);
+}
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatComponentSet.generated.h"
+
+class AActor;
+class UActorComponent;
+class UCombatStaminaSystem;
+class UCombatFlowSystem;
+class UCombatSkillSystem;
+class UCombatAdvancedMechanics;
+
+/**
+ * Typed pointers to an actor's combat components, resolved once.
+ * ACombatCharacter fills this after its components initialize and hands a copy to each component,
+ * so hot paths use direct pointers instead of searching the component list by class.
+ * Any entry may be null if the actor doesn't have that component.
+ */
+USTRUCT()
+struct FCombatComponentSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatStaminaSystem> Stamina;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatFlowSystem> Flow;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatSkillSystem> Skill;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatAdvancedMechanics> AdvancedMechanics;
+
+	/** Fill every entry with a single pass over the owner's components */
+	void Resolve(const AActor* Owner);
+
+	/**
+	 * For a component's BeginPlay: resolve from its owner unless the set already lists that component.
+	 * A combat character wires its components before they begin play; a component used on any other actor
+	 * is never wired and resolves its siblings here instead.
+	 */
+	void ResolveIfUnwired(const UActorComponent* Component);
+
+	/** Give each resolved component its siblings */
+	void Wire() const;
+};
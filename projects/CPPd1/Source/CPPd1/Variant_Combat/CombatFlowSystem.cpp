@@ -1,61 +1,173 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatFlowSystem.h"
+#include "CombatRules.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UCombatFlowSystem::UCombatFlowSystem()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// flow is evaluated on demand; decay and combo timeouts are timers
+	PrimaryComponentTick.bCanEverTick = false;
 	CurrentFlow = 0.0f;
 }
 
-void UCombatFlowSystem::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCombatFlowSystem::AddFlowPoints(float Amount)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	const double Now = GetNow();
+
+	CurrentFlow = FMath::Min(GetTuning().MaxFlow, EvaluateFlow(Now) + Amount);
+	FlowAnchorTime = Now;
+	OnFlowChanged.Broadcast(CurrentFlow);
 
-	// Decay flow over time
-	if (CurrentFlow > 0.0f)
+	SetFlowStateActive(CurrentFlow >= GetTuning().FlowStateThreshold);
+	ScheduleDecayTransition();
+}
+
+float UCombatFlowSystem::GetFlowMultiplier() const
+{
+	const FCombatFlowTuning& Tuning = GetTuning();
+	return CombatRules::FlowMultiplier(GetFlowMeter(), Tuning.FlowStateThreshold, Tuning.FlowStateMultiplier);
+}
+
+void UCombatFlowSystem::IncrementCombo()
+{
+	ComboCount++;
+
+	// Reset combo if too much time passes before the next hit
+	if (UWorld* World = GetWorld())
 	{
-		CurrentFlow = FMath::Max(0.0f, CurrentFlow - (FlowDecayRate * DeltaTime));
+		World->GetTimerManager().SetTimer(ComboResetTimer, this, &UCombatFlowSystem::ResetCombo, GetTuning().ComboResetTime, false);
 	}
+	
+	// Add flow points for combos
+	AddFlowPoints(CombatRules::ComboFlowGain(ComboCount, GetTuning().GetComboFlowPoints())); // More flow for longer combos
+}
 
-	// Reset combo if too much time has passed
-	TimeSinceLastCombo += DeltaTime;
-	if (TimeSinceLastCombo > ComboResetTime && ComboCount > 0)
+void UCombatFlowSystem::ResetCombo()
+{
+	ComboCount = 0;
+
+	if (UWorld* World = GetWorld())
 	{
-		ResetCombo();
+		World->GetTimerManager().ClearTimer(ComboResetTimer);
 	}
 }
 
-void UCombatFlowSystem::AddFlowPoints(float Amount)
+double UCombatFlowSystem::GetNow() const
 {
-	CurrentFlow = FMath::Min(MaxFlow, CurrentFlow + Amount);
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
 }
 
-float UCombatFlowSystem::GetFlowMultiplier() const
+float UCombatFlowSystem::EvaluateFlow(double Time) const
 {
-	if (IsInFlowState())
+	return CombatRules::DecayFlow(CurrentFlow, GetTuning().FlowDecayRate, float(Time - FlowAnchorTime));
+}
+
+void UCombatFlowSystem::ScheduleDecayTransition()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(DecayTimer);
+
+	const FCombatFlowTuning& Tuning = GetTuning();
+	if (Tuning.FlowDecayRate <= 0.0f || CurrentFlow <= 0.0f)
 	{
-		return FlowStateMultiplier;
+		return;
 	}
-	return 1.0f;
+
+	// next stop: dropping out of flow state, otherwise empty
+	TransitionFlow = bFlowStateActive && Tuning.FlowStateThreshold > 0.0f ? Tuning.FlowStateThreshold : 0.0f;
+	const float Delay = (CurrentFlow - TransitionFlow) / Tuning.FlowDecayRate;
+
+	// a zero delay would clear the timer instead of firing it
+	TimerManager.SetTimer(DecayTimer, this, &UCombatFlowSystem::HandleDecayTransition, FMath::Max(Delay, UE_KINDA_SMALL_NUMBER), false);
 }
 
-void UCombatFlowSystem::IncrementCombo()
+void UCombatFlowSystem::HandleDecayTransition()
 {
-	ComboCount++;
-	TimeSinceLastCombo = 0.0f;
-	
-	// Add flow points for combos
-	AddFlowPoints(0.05f * ComboCount); // More flow for longer combos
+	// land exactly on the transition value so float drift can't schedule a near-zero follow-up
+	CurrentFlow = TransitionFlow;
+	FlowAnchorTime = GetNow();
+	OnFlowChanged.Broadcast(CurrentFlow);
+
+	// decaying from here on, so we're leaving flow state either way
+	SetFlowStateActive(false);
+	ScheduleDecayTransition();
 }
 
-void UCombatFlowSystem::ResetCombo()
+void UCombatFlowSystem::SetFlowStateActive(bool bActive)
 {
-	ComboCount = 0;
-	TimeSinceLastCombo = 0.0f;
+	if (bFlowStateActive != bActive)
+	{
+		bFlowStateActive = bActive;
+		OnFlowStateChanged.Broadcast(bActive);
+	}
+}
+
+void UCombatFlowSystem::RefreshTuning()
+{
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	const double Now = GetNow();
+	CurrentFlow = FMath::Min(GetTuning().MaxFlow, EvaluateFlow(Now));
+	FlowAnchorTime = Now;
+	OnFlowChanged.Broadcast(CurrentFlow);
+
+	SetFlowStateActive(CurrentFlow >= GetTuning().FlowStateThreshold);
+	ScheduleDecayTransition();
+}
+
+void UCombatFlowSystem::ResetForRespawn()
+{
+	ResetCombo();
+
+	CurrentFlow = 0.0f;
+	FlowAnchorTime = GetNow();
+	OnFlowChanged.Broadcast(CurrentFlow);
+
+	SetFlowStateActive(false);
+	ScheduleDecayTransition();
+}
+
+void UCombatFlowSystem::RestoreFlow(float SavedFlow)
+{
+	ResetCombo();
+
+	CurrentFlow = FMath::Clamp(SavedFlow, 0.0f, GetTuning().MaxFlow);
+	FlowAnchorTime = GetNow();
+	OnFlowChanged.Broadcast(CurrentFlow);
+
+	SetFlowStateActive(CurrentFlow >= GetTuning().FlowStateThreshold);
+	ScheduleDecayTransition();
 }
 
 void UCombatFlowSystem::BeginPlay()
 {
 	Super::BeginPlay();
+
+	CombatComponents.ResolveIfUnwired(this);
+
+	FlowAnchorTime = GetNow();
+	ScheduleDecayTransition();
+}
+
+void UCombatFlowSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(DecayTimer);
+		World->GetTimerManager().ClearTimer(ComboResetTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
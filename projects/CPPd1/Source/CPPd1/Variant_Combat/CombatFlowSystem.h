@@ -4,11 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "CombatComponentSet.h"
+#include "CombatTuningProfile.h"
 #include "CombatFlowSystem.generated.h"
 
+/** Flow meter changed delegate (0.0 to 1.0) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFlowChanged, float, NewFlow);
+
+/** Entered or left flow state */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFlowStateChanged, bool, bInFlowState);
+
 /**
  * Flow/Style meter system inspired by Skate 4
  * Tracks combo chains, style points, and flow state
+ *
+ * Does not tick. Flow is stored as a value at a timestamp and decays linearly when queried.
+ * Timers fire only when flow state ends, the meter empties, or the combo times out.
  */
 UCLASS(ClassGroup=(CPPd1), meta=(BlueprintSpawnableComponent))
 class UCombatFlowSystem : public UActorComponent
@@ -19,7 +30,20 @@ public:
 
 	UCombatFlowSystem();
 
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/** Receive direct pointers to the sibling combat components (set by the owning character) */
+	void SetCombatComponents(const FCombatComponentSet& InComponents) { CombatComponents = InComponents; }
+
+	/** Read tuning from the given profile (set by the owning character) */
+	void SetTuningProfile(UCombatTuningProfile* InProfile) { TuningProfile = InProfile; }
+
+	/** Re-anchor and reschedule after the tuning profile was edited */
+	void RefreshTuning();
+
+	/** Empty meter, no combo, as on a fresh spawn (in-place respawn) */
+	void ResetForRespawn();
+
+	/** Set the meter to a saved value. The combo is not saved and starts from zero */
+	void RestoreFlow(float SavedFlow);
 
 	/** Add flow points (from tricks, combos, style moves) */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Flow")
@@ -27,15 +51,19 @@ public:
 
 	/** Get current flow meter (0.0 to 1.0) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Flow")
-	float GetFlowMeter() const { return CurrentFlow; }
+	float GetFlowMeter() const { return EvaluateFlow(GetNow()); }
 
 	/** Get flow percentage (0-100) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Flow")
-	float GetFlowPercentage() const { return CurrentFlow * 100.0f; }
+	float GetFlowPercentage() const { return GetFlowMeter() * 100.0f; }
 
 	/** Check if in flow state (high flow meter) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Flow")
-	bool IsInFlowState() const { return CurrentFlow >= FlowStateThreshold; }
+	bool IsInFlowState() const { return GetFlowMeter() >= GetTuning().FlowStateThreshold; }
+
+	/** True while the meter is decaying, i.e. GetFlowMeter() differs frame to frame */
+	UFUNCTION(BlueprintPure, Category = "Combat|Flow")
+	bool IsFlowDecaying() const { return GetTuning().FlowDecayRate > 0.0f && GetFlowMeter() > 0.0f; }
 
 	/** Get flow multiplier (affects damage, speed, etc.) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Flow")
@@ -53,38 +81,65 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Flow")
 	void ResetCombo();
 
-protected:
+	/** Fired whenever CurrentFlow changes (points added or decay) */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnFlowChanged OnFlowChanged;
+
+	/** Fired when the meter crosses FlowStateThreshold in either direction */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnFlowStateChanged OnFlowStateChanged;
 
-	/** Maximum flow */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Flow", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float MaxFlow = 1.0f;
+protected:
 
-	/** Current flow */
+	/** Flow at FlowAnchorTime. Use GetFlowMeter() for the current value */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Flow", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
 	float CurrentFlow = 0.0f;
 
-	/** Flow decay rate per second */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Flow")
-	float FlowDecayRate = 0.1f;
-
-	/** Flow threshold for flow state */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Flow", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float FlowStateThreshold = 0.7f;
-
-	/** Flow multiplier when in flow state */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Flow")
-	float FlowStateMultiplier = 1.5f;
-
 	/** Current combo count */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Flow")
 	int32 ComboCount = 0;
 
-	/** Time since last combo increment */
-	float TimeSinceLastCombo = 0.0f;
+	/** Shared tuning. Null reads the profile defaults */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatTuningProfile> TuningProfile;
+
+	/** World time CurrentFlow was sampled at */
+	double FlowAnchorTime = 0.0;
+
+	/** Last flow state reported through OnFlowStateChanged */
+	bool bFlowStateActive = false;
+
+	/** Flow value the pending decay timer lands on */
+	float TransitionFlow = 0.0f;
+
+	/** Fires when decay leaves flow state or empties the meter */
+	FTimerHandle DecayTimer;
+
+	/** Fires ComboResetTime after the last combo increment */
+	FTimerHandle ComboResetTimer;
 
-	/** Time before combo resets */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Flow")
-	float ComboResetTime = 3.0f;
+	/** Sibling combat components. Resolved from the owner on BeginPlay if nobody wired them */
+	UPROPERTY(Transient)
+	FCombatComponentSet CombatComponents;
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Flow section of the tuning profile */
+	const FCombatFlowTuning& GetTuning() const { return UCombatTuningProfile::GetOrDefault(TuningProfile)->Flow; }
+
+	/** Current world time, 0 without a world */
+	double GetNow() const;
+
+	/** Closed-form flow at the given world time */
+	float EvaluateFlow(double Time) const;
+
+	/** Schedule DecayTimer for the next threshold crossing after the current anchor */
+	void ScheduleDecayTransition();
+
+	/** DecayTimer callback */
+	void HandleDecayTransition();
+
+	/** Update bFlowStateActive and broadcast OnFlowStateChanged on change */
+	void SetFlowStateActive(bool bActive);
 };
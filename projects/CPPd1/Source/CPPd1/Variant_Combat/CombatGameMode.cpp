@@ -13,6 +13,7 @@
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
+#include "CombatAssetLoader.h"
 
 ACombatGameMode::ACombatGameMode()
 {
@@ -29,6 +30,17 @@ ACombatGameMode::ACombatGameMode()
 	SplitScreenManager = CreateDefaultSubobject<UCPPd1SplitScreenManager>(TEXT("SplitScreenManager"));
 }
 
+void ACombatGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// start streaming the variant's bundles before any actor begins play
+	if (UCombatAssetLoader* AssetLoader = GetGameInstance()->GetSubsystem<UCombatAssetLoader>())
+	{
+		AssetLoader->LoadVariant(VariantAssets);
+	}
+}
+
 void ACombatGameMode::BeginPlay()
 {
 	Super::BeginPlay();
@@ -24,8 +24,14 @@ public:
 
 	ACombatGameMode();
 
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
 	virtual void BeginPlay() override;
 
+	/** Variant asset bundles (a UCombatVariantAssets) to start streaming while the map loads */
+	UPROPERTY(EditDefaultsOnly, Category = "CPPd1|Assets", meta = (AllowedTypes = "CombatVariant"))
+	FPrimaryAssetId VariantAssets;
+
 	/** Enable split-screen (vertical by default, always on even for solo) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CPPd1|Split Screen")
 	bool bEnableSplitScreen = true;
@@ -56,7 +62,7 @@ public:
 
 	/** HUD widget class to spawn for players */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CPPd1|UI")
-	TSubclassOf<class UCombatHUD> HUDWidgetClass;
+	TSoftClassPtr<class UCombatHUD> HUDWidgetClass;
 
 	/** Setup split-screen viewports */
 	UFUNCTION(BlueprintCallable, Category = "CPPd1|Split Screen")
@@ -11,6 +11,8 @@
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
 #include "CPPd1.h"
+#include "CombatHitchDetector.h"
+#include "CombatAssetLoader.h"
 #include "Widgets/Input/SVirtualJoystick.h"
 
 void ACombatPlayerController::BeginPlay()
@@ -20,30 +22,41 @@ void ACombatPlayerController::BeginPlay()
 	// only spawn touch controls on local player controllers
 	if (SVirtualJoystick::ShouldDisplayTouchInterface() && IsLocalPlayerController())
 	{
-		// spawn the mobile controls widget
-		MobileControlsWidget = CreateWidget<UUserWidget>(this, MobileControlsWidgetClass);
-
-		if (MobileControlsWidget)
+		// spawn the mobile controls widget once its class has loaded
+		UCombatAssetLoader::LoadClassAsync(this, MobileControlsWidgetClass, [this](UClass* WidgetClass)
 		{
-			// add the controls to the player screen
-			MobileControlsWidget->AddToPlayerScreen(0);
+			MobileControlsWidget = CreateWidget<UUserWidget>(this, WidgetClass);
 
-		} else {
+			if (MobileControlsWidget)
+			{
+				UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WidgetCreated, MobileControlsWidget);
 
-			UE_LOG(LogCPPd1, Error, TEXT("Could not spawn mobile controls widget."));
+				// add the controls to the player screen
+				MobileControlsWidget->AddToPlayerScreen(0);
 
-		}
+			} else {
+
+				UE_LOG(LogCPPd1, Error, TEXT("Could not spawn mobile controls widget."));
+
+			}
+		});
 
 	}
 
 	// Spawn HUD widget for local players
-	if (IsLocalPlayerController() && HUDWidgetClass)
+	if (IsLocalPlayerController())
 	{
-		HUDWidget = CreateWidget<UUserWidget>(this, HUDWidgetClass);
-		if (HUDWidget)
+		UCombatAssetLoader::LoadClassAsync(this, HUDWidgetClass, [this](UClass* WidgetClass)
 		{
-			HUDWidget->AddToPlayerScreen();
-		}
+			LLM_SCOPE_BYTAG(Combat_HUD);
+
+			HUDWidget = CreateWidget<UUserWidget>(this, WidgetClass);
+			if (HUDWidget)
+			{
+				UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WidgetCreated, HUDWidget);
+				HUDWidget->AddToPlayerScreen();
+			}
+		});
 	}
 }
 
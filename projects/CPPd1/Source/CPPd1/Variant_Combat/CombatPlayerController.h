@@ -12,7 +12,7 @@ class ACombatCharacter;
 /**
  *  Simple Player Controller for a third person combat game
  *  Manages input mappings
- *  Respawns the player character at the checkpoint when it's destroyed
+ *  Holds the checkpoint the character respawns at, and spawns a new character there if the pawn is destroyed
  */
 UCLASS(abstract)
 class ACombatPlayerController : public APlayerController
@@ -29,16 +29,16 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input|Input Mappings")
 	TArray<UInputMappingContext*> MobileExcludedMappingContexts;
 
-	/** Mobile controls widget to spawn */
+	/** Mobile controls widget to spawn. Soft: loaded in the background and created once it arrives */
 	UPROPERTY(EditAnywhere, Category="Input|Touch Controls")
-	TSubclassOf<UUserWidget> MobileControlsWidgetClass;
+	TSoftClassPtr<UUserWidget> MobileControlsWidgetClass;
 
 	/** Pointer to the mobile controls widget */
 	TObjectPtr<UUserWidget> MobileControlsWidget;
 
-	/** HUD widget class to spawn */
+	/** HUD widget class to spawn. Soft: loaded in the background and created once it arrives */
 	UPROPERTY(EditAnywhere, Category="UI|HUD")
-	TSubclassOf<class UUserWidget> HUDWidgetClass;
+	TSoftClassPtr<class UUserWidget> HUDWidgetClass;
 
 	/** Pointer to the HUD widget */
 	TObjectPtr<UUserWidget> HUDWidget;
@@ -66,6 +66,9 @@ public:
 	/** Updates the character respawn transform */
 	void SetRespawnTransform(const FTransform& NewRespawn);
 
+	/** Checkpoint the character respawns at */
+	const FTransform& GetRespawnTransform() const { return RespawnTransform; }
+
 protected:
 
 	/** Called if the possessed pawn is destroyed */
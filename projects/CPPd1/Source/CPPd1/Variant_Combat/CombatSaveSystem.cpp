@@ -0,0 +1,362 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSaveSystem.h"
+#include "CombatCharacter.h"
+#include "CombatPlayerController.h"
+#include "CombatStaminaSystem.h"
+#include "CombatFlowSystem.h"
+#include "Variant_Combat/AI/CombatWaveSpawner.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** 'CBSV' */
+	const uint32 SaveMagic = 0x43425356;
+	const uint16 SaveVersion = 1;
+
+	int32 GetLocalPlayerIndex(const AController* Controller)
+	{
+		const APlayerController* PC = Cast<APlayerController>(Controller);
+		const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+		return LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : INDEX_NONE;
+	}
+
+	/** Map name without the PIE prefix, so editor and packaged sessions share saves */
+	FString GetSaveMapName(const UWorld* World)
+	{
+		return UWorld::RemovePIEPrefix(World->GetMapName());
+	}
+}
+
+void UCombatSaveSystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// a few hundred bytes, read once before any map plays
+	TArray<uint8> Bytes;
+	if (FFileHelper::LoadFileToArray(Bytes, *GetSavePath(), FILEREAD_Silent))
+	{
+		bHasLoadedSave = DeserializeSnapshot(Bytes, LoadedSave);
+	}
+}
+
+void UCombatSaveSystem::Deinitialize()
+{
+	// let the last save finish writing before the process can exit
+	PendingSave.Wait();
+
+	Super::Deinitialize();
+}
+
+void UCombatSaveSystem::SaveProgress(UWorld* World)
+{
+	COMBAT_SCOPE(SaveCapture);
+
+	if (!World || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	FCombatSaveSnapshot Snapshot = Capture(World);
+
+	// anything restored later this session should see the newest progress
+	LoadedSave = Snapshot;
+	bHasLoadedSave = true;
+
+	WriteAsync(MoveTemp(Snapshot));
+}
+
+void UCombatSaveSystem::RequestSave(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (UCombatSaveSystem* SaveSystem = GameInstance ? GameInstance->GetSubsystem<UCombatSaveSystem>() : nullptr)
+	{
+		SaveSystem->SaveProgress(World);
+	}
+}
+
+FCombatSaveSnapshot UCombatSaveSystem::Capture(UWorld* World)
+{
+	FCombatSaveSnapshot Snapshot;
+	Snapshot.MapName = GetSaveMapName(World);
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		ACombatPlayerController* PC = Cast<ACombatPlayerController>(It->Get());
+		ACombatCharacter* Character = PC ? Cast<ACombatCharacter>(PC->GetPawn()) : nullptr;
+		const int32 PlayerIndex = GetLocalPlayerIndex(PC);
+		if (!Character || PlayerIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FCombatSavePlayer& Player = Snapshot.Players.AddDefaulted_GetRef();
+		Player.PlayerIndex = uint8(PlayerIndex);
+
+		const FTransform& Checkpoint = PC->GetRespawnTransform();
+		Player.CheckpointLocation = FVector3f(Checkpoint.GetLocation());
+		Player.CheckpointYaw = float(Checkpoint.Rotator().Yaw);
+
+		const FCombatComponentSet& Components = Character->GetCombatComponents();
+		if (Components.Skill)
+		{
+			for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
+			{
+				Player.Skills[static_cast<uint8>(SkillType)] = Components.Skill->GetSkillData(SkillType);
+			}
+		}
+		if (Components.Flow)
+		{
+			Player.Flow = Components.Flow->GetFlowMeter();
+		}
+	}
+
+	for (TActorIterator<ACombatWaveSpawner> It(World); It; ++It)
+	{
+		Snapshot.Waves.Add({ It->GetName(), It->GetCurrentWaveIndex() });
+	}
+
+	return Snapshot;
+}
+
+void UCombatSaveSystem::WriteAsync(FCombatSaveSnapshot&& Snapshot)
+{
+	// the task owns the snapshot; nothing on the game thread touches it again
+	auto Write = [Snapshot = MoveTemp(Snapshot), Path = GetSavePath()]()
+	{
+		TArray<uint8> Bytes;
+		SerializeSnapshot(Snapshot, Bytes);
+
+		// write next to the save and swap it in, so a crash mid-write keeps the previous save
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true))
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("CombatSaveSystem: could not write %s"), *Path);
+			return;
+		}
+
+		UE_LOG(LogCPPd1, Log, TEXT("CombatSaveSystem: saved %d bytes to %s"), Bytes.Num(), *Path);
+	};
+
+	// one writer at a time, in request order
+	PendingSave = PendingSave.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Write), UE::Tasks::Prerequisites(PendingSave), UE::Tasks::ETaskPriority::BackgroundNormal)
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Write), UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void UCombatSaveSystem::SerializeSnapshot(const FCombatSaveSnapshot& Snapshot, TArray<uint8>& OutBytes)
+{
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 Magic = SaveMagic;
+	uint16 Version = SaveVersion;
+	uint32 NumPlayers = Snapshot.Players.Num();
+
+	// FArchive only takes mutable references; a saving archive doesn't write through them, so strings are
+	// passed as they are and only scalars are copied
+	Writer << Magic << Version << const_cast<FString&>(Snapshot.MapName);
+	Writer.SerializeIntPacked(NumPlayers);
+
+	// per player: index, checkpoint, packed skill count, then level/experience/next per skill, then flow
+	for (const FCombatSavePlayer& Player : Snapshot.Players)
+	{
+		uint8 PlayerIndex = Player.PlayerIndex;
+		FVector3f CheckpointLocation = Player.CheckpointLocation;
+		float CheckpointYaw = Player.CheckpointYaw;
+		uint32 NumSkills = static_cast<uint8>(ECombatSkillType::Count);
+		Writer << PlayerIndex << CheckpointLocation << CheckpointYaw;
+		Writer.SerializeIntPacked(NumSkills);
+		for (const FCombatSkillData& Skill : Player.Skills)
+		{
+			float SkillLevel = Skill.SkillLevel;
+			float Experience = Skill.Experience;
+			float ExperienceToNextLevel = Skill.ExperienceToNextLevel;
+			Writer << SkillLevel << Experience << ExperienceToNextLevel;
+		}
+		float Flow = Player.Flow;
+		Writer << Flow;
+	}
+
+	uint32 NumWaves = Snapshot.Waves.Num();
+	Writer.SerializeIntPacked(NumWaves);
+	for (const FCombatSaveWave& Wave : Snapshot.Waves)
+	{
+		uint32 WaveIndex = uint32(FMath::Max(Wave.WaveIndex, 0));
+		Writer << const_cast<FString&>(Wave.SpawnerName);
+		Writer.SerializeIntPacked(WaveIndex);
+	}
+}
+
+bool UCombatSaveSystem::DeserializeSnapshot(const TArray<uint8>& Bytes, FCombatSaveSnapshot& OutSnapshot)
+{
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != SaveMagic || Version != SaveVersion)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatSaveSystem: %s is not a version %d save; starting fresh"), *GetSavePath(), SaveVersion);
+		return false;
+	}
+
+	uint32 NumPlayers = 0;
+	Reader << OutSnapshot.MapName;
+	Reader.SerializeIntPacked(NumPlayers);
+
+	OutSnapshot.Players.Reset();
+	for (uint32 PlayerIndex = 0; PlayerIndex < NumPlayers && !Reader.IsError(); ++PlayerIndex)
+	{
+		FCombatSavePlayer& Player = OutSnapshot.Players.AddDefaulted_GetRef();
+		uint32 NumSkills = 0;
+		Reader << Player.PlayerIndex << Player.CheckpointLocation << Player.CheckpointYaw;
+		Reader.SerializeIntPacked(NumSkills);
+
+		// skills added since the save start from zero; skills since removed are read and dropped
+		for (uint32 SkillIndex = 0; SkillIndex < NumSkills && !Reader.IsError(); ++SkillIndex)
+		{
+			FCombatSkillData Skill;
+			Reader << Skill.SkillLevel << Skill.Experience << Skill.ExperienceToNextLevel;
+			if (SkillIndex < static_cast<uint8>(ECombatSkillType::Count))
+			{
+				Player.Skills[SkillIndex] = Skill;
+			}
+		}
+		Reader << Player.Flow;
+	}
+
+	uint32 NumWaves = 0;
+	Reader.SerializeIntPacked(NumWaves);
+	OutSnapshot.Waves.Reset();
+	for (uint32 WaveIndex = 0; WaveIndex < NumWaves && !Reader.IsError(); ++WaveIndex)
+	{
+		FCombatSaveWave& Wave = OutSnapshot.Waves.AddDefaulted_GetRef();
+		uint32 SavedIndex = 0;
+		Reader << Wave.SpawnerName;
+		Reader.SerializeIntPacked(SavedIndex);
+		Wave.WaveIndex = int32(SavedIndex);
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatSaveSystem: %s is truncated; starting fresh"), *GetSavePath());
+		OutSnapshot = FCombatSaveSnapshot();
+		return false;
+	}
+
+	return true;
+}
+
+void UCombatSaveSystem::RestorePlayer(ACombatCharacter* Character)
+{
+	const int32 PlayerIndex = Character ? GetLocalPlayerIndex(Character->GetController()) : INDEX_NONE;
+	if (PlayerIndex == INDEX_NONE || !IsSavedMap(Character->GetWorld()) || RestoredPlayers.Contains(PlayerIndex))
+	{
+		return;
+	}
+
+	const FCombatSavePlayer* Player = LoadedSave.FindPlayer(PlayerIndex);
+	if (!Player)
+	{
+		return;
+	}
+
+	RestoredPlayers.Add(PlayerIndex);
+
+	const FCombatComponentSet& Components = Character->GetCombatComponents();
+	if (Components.Skill)
+	{
+		for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
+		{
+			Components.Skill->RestoreSkill(SkillType, Player->Skills[static_cast<uint8>(SkillType)]);
+		}
+	}
+
+	// picks up the restored stamina efficiency
+	if (Components.Stamina)
+	{
+		Components.Stamina->ResetForRespawn();
+	}
+
+	if (Components.Flow)
+	{
+		Components.Flow->RestoreFlow(Player->Flow);
+	}
+
+	// continue from the saved checkpoint
+	const FRotator Rotation(0.0f, Player->CheckpointYaw, 0.0f);
+	const FVector Location(Player->CheckpointLocation);
+	Character->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (ACombatPlayerController* PC = Cast<ACombatPlayerController>(Character->GetController()))
+	{
+		PC->SetControlRotation(Rotation);
+		PC->SetRespawnTransform(FTransform(Rotation, Location));
+	}
+}
+
+bool UCombatSaveSystem::ConsumeSavedWave(const ACombatWaveSpawner* Spawner, int32& OutWaveIndex)
+{
+	if (!Spawner || !IsSavedMap(Spawner->GetWorld()))
+	{
+		return false;
+	}
+
+	const FString SpawnerName = Spawner->GetName();
+	const FCombatSaveWave* Wave = LoadedSave.Waves.FindByPredicate([&SpawnerName](const FCombatSaveWave& Saved) { return Saved.SpawnerName == SpawnerName; });
+	if (!Wave || RestoredSpawners.Contains(SpawnerName))
+	{
+		return false;
+	}
+
+	RestoredSpawners.Add(SpawnerName);
+	OutWaveIndex = Wave->WaveIndex;
+	return true;
+}
+
+void UCombatSaveSystem::Restore(ACombatCharacter* Character)
+{
+	const UGameInstance* GameInstance = Character ? Character->GetGameInstance() : nullptr;
+	if (UCombatSaveSystem* SaveSystem = GameInstance ? GameInstance->GetSubsystem<UCombatSaveSystem>() : nullptr)
+	{
+		SaveSystem->RestorePlayer(Character);
+	}
+}
+
+bool UCombatSaveSystem::ConsumeWave(const ACombatWaveSpawner* Spawner, int32& OutWaveIndex)
+{
+	const UGameInstance* GameInstance = Spawner ? Spawner->GetGameInstance() : nullptr;
+	UCombatSaveSystem* SaveSystem = GameInstance ? GameInstance->GetSubsystem<UCombatSaveSystem>() : nullptr;
+	return SaveSystem && SaveSystem->ConsumeSavedWave(Spawner, OutWaveIndex);
+}
+
+void UCombatSaveSystem::ClearSave()
+{
+	PendingSave.Wait();
+	IFileManager::Get().Delete(*GetSavePath(), false, false, true);
+
+	LoadedSave = FCombatSaveSnapshot();
+	bHasLoadedSave = false;
+	RestoredPlayers.Reset();
+	RestoredSpawners.Reset();
+}
+
+FString UCombatSaveSystem::GetSavePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("CombatProgress.sav"));
+}
+
+bool UCombatSaveSystem::IsSavedMap(const UWorld* World) const
+{
+	return bHasLoadedSave && World && World->IsGameWorld() && LoadedSave.MapName == GetSaveMapName(World);
+}
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "CombatSkillSystem.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "CombatSaveSystem.generated.h"
+
+class ACombatCharacter;
+class ACombatWaveSpawner;
+
+/** Progression of one local player at save time */
+struct FCombatSavePlayer
+{
+	/** Local player index */
+	uint8 PlayerIndex = 0;
+
+	/** Respawn checkpoint. Characters stand upright, so location and yaw are enough */
+	FVector3f CheckpointLocation = FVector3f::ZeroVector;
+	float CheckpointYaw = 0.0f;
+
+	/** Skill data, indexed by ECombatSkillType */
+	FCombatSkillData Skills[static_cast<uint8>(ECombatSkillType::Count)];
+
+	/** Flow meter (0.0 to 1.0) */
+	float Flow = 0.0f;
+};
+
+/** Progress of one wave spawner, keyed by the spawner's name in the level */
+struct FCombatSaveWave
+{
+	FString SpawnerName;
+	int32 WaveIndex = 0;
+};
+
+/**
+ * Everything a combat save holds. Plain data, captured on the game thread and then only read,
+ * so it can be serialized on a worker while play continues
+ */
+struct FCombatSaveSnapshot
+{
+	/** Map the progress belongs to; checkpoints and waves only apply to that map */
+	FString MapName;
+
+	TArray<FCombatSavePlayer> Players;
+	TArray<FCombatSaveWave> Waves;
+
+	const FCombatSavePlayer* FindPlayer(int32 PlayerIndex) const
+	{
+		return Players.FindByPredicate([PlayerIndex](const FCombatSavePlayer& Player) { return Player.PlayerIndex == PlayerIndex; });
+	}
+};
+
+/**
+ * Saves combat progression (checkpoint, skill experience, flow, wave progress) to a compact versioned binary file,
+ * and restores it once per session when the saved map is played again.
+ *
+ * A save copies the state into an FCombatSaveSnapshot on the game thread, which costs a few hundred bytes of copying.
+ * Serializing and writing the file happen on a worker task, so checkpoints never stall a frame on disk I/O.
+ * Saves run one after another in request order, and each writes a temporary file that replaces the old save
+ * only once it's complete. An interrupted save leaves the previous one intact.
+ */
+UCLASS()
+class CPPd1_API UCombatSaveSystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Capture the world's combat progression and write it in the background */
+	void SaveProgress(UWorld* World);
+
+	/** SaveProgress through the game instance of the given object's world. Does nothing outside a game */
+	static void RequestSave(const UObject* WorldContextObject);
+
+	/** Apply the saved progression and checkpoint to a player's character, once per session per player */
+	void RestorePlayer(ACombatCharacter* Character);
+
+	/** Saved wave index for a spawner in the saved map, once per session per spawner. False if there is none */
+	bool ConsumeSavedWave(const ACombatWaveSpawner* Spawner, int32& OutWaveIndex);
+
+	/** Static helpers for actors, tolerant of a missing game instance */
+	static void Restore(ACombatCharacter* Character);
+	static bool ConsumeWave(const ACombatWaveSpawner* Spawner, int32& OutWaveIndex);
+
+	/** Delete the save file and forget the loaded progression */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Save")
+	void ClearSave();
+
+protected:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Build a snapshot of the world's players and wave spawners */
+	static FCombatSaveSnapshot Capture(UWorld* World);
+
+	/** Serialize a snapshot. Safe to call from any thread */
+	static void SerializeSnapshot(const FCombatSaveSnapshot& Snapshot, TArray<uint8>& OutBytes);
+
+	/** Read a save file's contents. False on a bad magic, version or truncated file */
+	static bool DeserializeSnapshot(const TArray<uint8>& Bytes, FCombatSaveSnapshot& OutSnapshot);
+
+	/** Serialize and write a snapshot on a worker, after any save already in flight */
+	void WriteAsync(FCombatSaveSnapshot&& Snapshot);
+
+	/** Full path of the save file */
+	static FString GetSavePath();
+
+	/** True if the loaded save belongs to the given world's map */
+	bool IsSavedMap(const UWorld* World) const;
+
+	/** Progression read from disk at startup */
+	FCombatSaveSnapshot LoadedSave;
+	bool bHasLoadedSave = false;
+
+	/** Players and spawners already restored this session, so respawns and reloads don't roll progress back */
+	TSet<int32> RestoredPlayers;
+	TSet<FString> RestoredSpawners;
+
+	/** Last save task launched; the next one waits for it */
+	UE::Tasks::FTask PendingSave;
+};
@@ -1,88 +1,164 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatSkillSystem.h"
+#include "CPPd1.h"
+#include "CombatRules.h"
 
 UCombatSkillSystem::UCombatSkillSystem()
 {
+	LLM_SCOPE_BYTAG(Combat_TricksSkills);
+
 	PrimaryComponentTick.bCanEverTick = false;
 
-	// Initialize all skill types
-	for (int32 i = 0; i < static_cast<int32>(ECombatSkillType::Flow) + 1; ++i)
-	{
-		ECombatSkillType SkillType = static_cast<ECombatSkillType>(i);
-		Skills.Add(SkillType, FCombatSkillData());
-	}
+	RefreshDerivedValues();
 }
 
 float UCombatSkillSystem::GetSkillLevel(ECombatSkillType SkillType) const
 {
-	if (const FCombatSkillData* SkillData = Skills.Find(SkillType))
+	return GetSkillData(SkillType).SkillLevel;
+}
+
+void UCombatSkillSystem::AddExperience(ECombatSkillType SkillType, float Amount)
+{
+	if (SkillType >= ECombatSkillType::Count)
 	{
-		return SkillData->SkillLevel;
+		return;
+	}
+
+	Skills[static_cast<uint8>(SkillType)].Experience += Amount * GetTuning().ExperienceMultiplier;
+	if (CheckSkillLevelUp(SkillType))
+	{
+		RefreshDerivedValue(SkillType);
 	}
-	return 0.0f;
 }
 
-void UCombatSkillSystem::AddExperience(ECombatSkillType SkillType, float Amount)
+void UCombatSkillSystem::AddExperienceBatch(const TArray<FCombatSkillExperienceGain>& Gains)
 {
-	if (FCombatSkillData* SkillData = Skills.Find(SkillType))
+	AddExperienceBatch(TConstArrayView<FCombatSkillExperienceGain>(Gains));
+}
+
+void UCombatSkillSystem::AddExperienceBatch(TConstArrayView<FCombatSkillExperienceGain> Gains)
+{
+	// sum per skill first so each skill levels and refreshes once
+	float Totals[(uint8)ECombatSkillType::Count] = {};
+	for (const FCombatSkillExperienceGain& Gain : Gains)
+	{
+		if (Gain.SkillType < ECombatSkillType::Count)
+		{
+			Totals[static_cast<uint8>(Gain.SkillType)] += Gain.Amount;
+		}
+	}
+
+	for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
 	{
-		SkillData->Experience += Amount;
-		CheckSkillLevelUp(SkillType);
+		const float Total = Totals[static_cast<uint8>(SkillType)];
+		if (Total == 0.0f)
+		{
+			continue;
+		}
+
+		Skills[static_cast<uint8>(SkillType)].Experience += Total * GetTuning().ExperienceMultiplier;
+		if (CheckSkillLevelUp(SkillType))
+		{
+			RefreshDerivedValue(SkillType);
+		}
 	}
 }
 
-float UCombatSkillSystem::GetStrikingDamageMultiplier() const
+TMap<ECombatSkillType, FCombatSkillData> UCombatSkillSystem::GetAllSkills() const
 {
-	float SkillLevel = GetSkillLevel(ECombatSkillType::Striking);
-	float Normalized = SkillLevel / 100.0f;
-	return FMath::Lerp(BaseDamageMultiplier, MaxDamageMultiplier, Normalized);
+	TMap<ECombatSkillType, FCombatSkillData> Result;
+	Result.Reserve((uint8)ECombatSkillType::Count);
+	for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
+	{
+		Result.Add(SkillType, GetSkillData(SkillType));
+	}
+	return Result;
 }
 
-float UCombatSkillSystem::GetDefenseEffectiveness() const
+void UCombatSkillSystem::ResetForRespawn()
 {
-	float SkillLevel = GetSkillLevel(ECombatSkillType::Defense);
-	float Normalized = SkillLevel / 100.0f;
-	return FMath::Lerp(BaseDefenseEffectiveness, MaxDefenseEffectiveness, Normalized);
+	const UCombatSkillSystem* Archetype = CastChecked<UCombatSkillSystem>(GetArchetype());
+	for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
+	{
+		const uint8 Index = static_cast<uint8>(SkillType);
+		Skills[Index] = Archetype->Skills[Index];
+		Skills[Index].SkillLevel = GetTuning().StartingSkillLevel;
+	}
+
+	RefreshDerivedValues();
 }
 
-float UCombatSkillSystem::GetStaminaEfficiency() const
+void UCombatSkillSystem::RestoreSkill(ECombatSkillType SkillType, const FCombatSkillData& SavedData)
 {
-	float SkillLevel = GetSkillLevel(ECombatSkillType::Stamina);
-	// Higher stamina skill = less stamina drain
-	return 1.0f - (SkillLevel / 200.0f); // 0.5x drain at max level
+	if (SkillType >= ECombatSkillType::Count)
+	{
+		return;
+	}
+
+	Skills[static_cast<uint8>(SkillType)] = SavedData;
+	RefreshDerivedValue(SkillType);
 }
 
-float UCombatSkillSystem::GetTechniqueAccuracy() const
+void UCombatSkillSystem::RefreshDerivedValues()
 {
-	float SkillLevel = GetSkillLevel(ECombatSkillType::Technique);
-	// Higher technique = better combo execution window
-	return SkillLevel / 100.0f; // 0.0 to 1.0
+	for (ECombatSkillType SkillType : TEnumRange<ECombatSkillType>())
+	{
+		RefreshDerivedValue(SkillType);
+	}
 }
 
-float UCombatSkillSystem::GetFlowMultiplier() const
+void UCombatSkillSystem::RefreshDerivedValue(ECombatSkillType SkillType)
 {
-	float SkillLevel = GetSkillLevel(ECombatSkillType::Flow);
-	// Higher flow = better trick chaining
-	return 1.0f + (SkillLevel / 50.0f); // 1.0x to 3.0x at max
+	const float SkillLevel = GetSkillLevel(SkillType);
+	const FCombatSkillTuning& Tuning = GetTuning();
+	float& Value = DerivedValues[static_cast<uint8>(SkillType)];
+
+	switch (SkillType)
+	{
+	case ECombatSkillType::Striking:
+		Value = CombatRules::StrikingDamageMultiplier(SkillLevel, Tuning.BaseDamageMultiplier, Tuning.MaxDamageMultiplier);
+		break;
+
+	case ECombatSkillType::Defense:
+		Value = CombatRules::DefenseEffectiveness(SkillLevel, Tuning.BaseDefenseEffectiveness, Tuning.MaxDefenseEffectiveness);
+		break;
+
+	case ECombatSkillType::Stamina:
+		// Higher stamina skill = less stamina drain
+		Value = CombatRules::StaminaEfficiency(SkillLevel);
+		break;
+
+	case ECombatSkillType::Technique:
+		// Higher technique = better combo execution window
+		Value = CombatRules::TechniqueAccuracy(SkillLevel);
+		break;
+
+	case ECombatSkillType::Flow:
+		// Higher flow = better trick chaining
+		Value = CombatRules::FlowSkillMultiplier(SkillLevel);
+		break;
+
+	default:
+		Value = 1.0f;
+		break;
+	}
 }
 
 void UCombatSkillSystem::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Combat_TricksSkills);
+
 	Super::BeginPlay();
+
+	CombatComponents.ResolveIfUnwired(this);
+
+	// the tuning profile may have been set since construction
+	RefreshDerivedValues();
 }
 
-void UCombatSkillSystem::CheckSkillLevelUp(ECombatSkillType SkillType)
+bool UCombatSkillSystem::CheckSkillLevelUp(ECombatSkillType SkillType)
 {
-	if (FCombatSkillData* SkillData = Skills.Find(SkillType))
-	{
-		while (SkillData->Experience >= SkillData->ExperienceToNextLevel && SkillData->SkillLevel < 100.0f)
-		{
-			SkillData->Experience -= SkillData->ExperienceToNextLevel;
-			SkillData->SkillLevel = FMath::Min(100.0f, SkillData->SkillLevel + 1.0f);
-			
-			// Increase XP needed for next level (exponential)
-			SkillData->ExperienceToNextLevel *= 1.1f;
-		}
-	}
+	FCombatSkillData& SkillData = Skills[static_cast<uint8>(SkillType)];
+	return CombatRules::ApplySkillLevelUps(SkillData.SkillLevel, SkillData.Experience, SkillData.ExperienceToNextLevel) > 0;
 }
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "CombatComponentSet.h"
+#include "CombatTuningProfile.h"
 #include "CombatSkillSystem.generated.h"
 
 /** Combat skill types (inspired by UFC 5) */
@@ -15,8 +17,11 @@ enum class ECombatSkillType : uint8
 	Defense,		// Blocking, parrying, dodging
 	Stamina,		// Endurance and recovery
 	Technique,		// Combo execution, timing
-	Flow			// Style points, trick chaining (Skate-inspired)
+	Flow,			// Style points, trick chaining (Skate-inspired)
+
+	Count			UMETA(Hidden)
 };
+ENUM_RANGE_BY_COUNT(ECombatSkillType, ECombatSkillType::Count);
 
 /** Skill level data */
 USTRUCT(BlueprintType)
@@ -43,9 +48,33 @@ struct FCombatSkillData
 	{}
 };
 
+/** One experience gain, for batching several skills into a single AddExperienceBatch call */
+USTRUCT(BlueprintType)
+struct FCombatSkillExperienceGain
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ECombatSkillType SkillType = ECombatSkillType::Striking;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Amount = 0.0f;
+
+	FCombatSkillExperienceGain() {}
+
+	FCombatSkillExperienceGain(ECombatSkillType InSkillType, float InAmount)
+		: SkillType(InSkillType)
+		, Amount(InAmount)
+	{}
+};
+
 /**
  * Skill-based combat system inspired by UFC 5
  * Tracks player skill progression and affects combat effectiveness
+ *
+ * Skills live in a fixed array indexed by ECombatSkillType. Level-ups use a precomputed XP curve so any
+ * number of levels is resolved in one lookup, and the derived multipliers are cached per skill and only
+ * recomputed when that skill's level changes.
  */
 UCLASS(ClassGroup=(CPPd1), meta=(BlueprintSpawnableComponent))
 class UCombatSkillSystem : public UActorComponent
@@ -56,6 +85,12 @@ public:
 
 	UCombatSkillSystem();
 
+	/** Receive direct pointers to the sibling combat components (set by the owning character) */
+	void SetCombatComponents(const FCombatComponentSet& InComponents) { CombatComponents = InComponents; }
+
+	/** Read tuning from the given profile (set by the owning character) */
+	void SetTuningProfile(UCombatTuningProfile* InProfile) { TuningProfile = InProfile; }
+
 	/** Get skill level for a specific skill type */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
 	float GetSkillLevel(ECombatSkillType SkillType) const;
@@ -64,54 +99,77 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Skill")
 	void AddExperience(ECombatSkillType SkillType, float Amount);
 
+	/** Add a batch of experience gains (e.g. everything a combo earned) with one level-up pass per skill */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Skill")
+	void AddExperienceBatch(const TArray<FCombatSkillExperienceGain>& Gains);
+
+	/** Native batch overload */
+	void AddExperienceBatch(TConstArrayView<FCombatSkillExperienceGain> Gains);
+
 	/** Get damage multiplier based on striking skill */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	float GetStrikingDamageMultiplier() const;
+	float GetStrikingDamageMultiplier() const { return DerivedValues[static_cast<uint8>(ECombatSkillType::Striking)]; }
 
 	/** Get defense effectiveness based on defense skill */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	float GetDefenseEffectiveness() const;
+	float GetDefenseEffectiveness() const { return DerivedValues[static_cast<uint8>(ECombatSkillType::Defense)]; }
 
 	/** Get stamina efficiency based on stamina skill */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	float GetStaminaEfficiency() const;
+	float GetStaminaEfficiency() const { return DerivedValues[static_cast<uint8>(ECombatSkillType::Stamina)]; }
 
 	/** Get technique accuracy (affects combo execution) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	float GetTechniqueAccuracy() const;
+	float GetTechniqueAccuracy() const { return DerivedValues[static_cast<uint8>(ECombatSkillType::Technique)]; }
 
 	/** Get flow multiplier (affects trick chaining) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	float GetFlowMultiplier() const;
+	float GetFlowMultiplier() const { return DerivedValues[static_cast<uint8>(ECombatSkillType::Flow)]; }
 
-	/** Get all skill data */
+	/** Get all skill data (Blueprint convenience, builds a map; native code should use GetSkillData) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Skill")
-	TMap<ECombatSkillType, FCombatSkillData> GetAllSkills() const { return Skills; }
+	TMap<ECombatSkillType, FCombatSkillData> GetAllSkills() const;
+
+	/** Get the data for one skill */
+	const FCombatSkillData& GetSkillData(ECombatSkillType SkillType) const { return Skills[static_cast<uint8>(SkillType)]; }
+
+	/** Recompute every cached multiplier. Call after the tuning profile changed at runtime */
+	void RefreshDerivedValues();
+
+	/** Back to the archetype's skills at the profile's starting level, as on a fresh spawn (in-place respawn) */
+	void ResetForRespawn();
+
+	/** Replace one skill's level and experience with saved progress */
+	void RestoreSkill(ECombatSkillType SkillType, const FCombatSkillData& SavedData);
 
 protected:
 
-	/** Skill data map */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Skill")
-	TMap<ECombatSkillType, FCombatSkillData> Skills;
+	/** Skill data, indexed by ECombatSkillType */
+	UPROPERTY(VisibleAnywhere, Category = "Combat|Skill")
+	FCombatSkillData Skills[(uint8)ECombatSkillType::Count];
+
+	/** Cached per-skill derived value (damage multiplier, defense effectiveness, ...), indexed by ECombatSkillType */
+	float DerivedValues[static_cast<uint8>(ECombatSkillType::Count)] = {};
 
-	/** Base damage multiplier at skill level 0 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Skill")
-	float BaseDamageMultiplier = 0.5f;
+	/** Shared tuning. Null reads the profile defaults */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatTuningProfile> TuningProfile;
 
-	/** Max damage multiplier at skill level 100 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Skill")
-	float MaxDamageMultiplier = 2.0f;
+	/** Sibling combat components. Resolved from the owner on BeginPlay if nobody wired them */
+	UPROPERTY(Transient)
+	FCombatComponentSet CombatComponents;
 
-	/** Base defense effectiveness at skill level 0 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Skill")
-	float BaseDefenseEffectiveness = 0.3f;
+	/** The owning character sets the starting skill levels */
+	friend class ACombatCharacter;
 
-	/** Max defense effectiveness at skill level 100 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Skill")
-	float MaxDefenseEffectiveness = 0.9f;
+	/** Skill section of the tuning profile */
+	const FCombatSkillTuning& GetTuning() const { return UCombatTuningProfile::GetOrDefault(TuningProfile)->Skill; }
 
 	virtual void BeginPlay() override;
 
-	/** Check and level up skills */
-	void CheckSkillLevelUp(ECombatSkillType SkillType);
+	/** Apply every level the skill's banked experience pays for, in one step. Returns true if the level changed */
+	bool CheckSkillLevelUp(ECombatSkillType SkillType);
+
+	/** Recompute the cached derived value of one skill from its level */
+	void RefreshDerivedValue(ECombatSkillType SkillType);
 };
@@ -2,41 +2,69 @@
 
 #include "CombatStaminaSystem.h"
 #include "CombatSkillSystem.h"
+#include "CombatRules.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UCombatStaminaSystem::UCombatStaminaSystem()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	CurrentStamina = MaxStamina;
+	// stamina is evaluated on demand; state changes come from TransitionTimer
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
-void UCombatStaminaSystem::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCombatStaminaSystem::DrainStamina(float Amount)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	const double Now = GetNow();
+	const bool bWasExhausted = IsExhausted();
+	Rebase(Now);
 
-	TimeSinceLastDrain += DeltaTime;
+	// Apply stamina efficiency (higher skill = less drain)
+	float ActualDrain = CombatRules::StaminaDrainCost(GetStaminaParams(), Amount);
+	
+	CurrentStamina = FMath::Max(0.0f, CurrentStamina - ActualDrain);
+	RecoveryStartTime = Now + GetTuning().RecoveryDelay;
+	CommitChange(bWasExhausted);
+}
+
+void UCombatStaminaSystem::StartContinuousDrain(float AmountPerSecond)
+{
+	const double Now = GetNow();
+	const bool bWasExhausted = IsExhausted();
+	Rebase(Now);
 
-	// Recover stamina if enough time has passed
-	if (TimeSinceLastDrain >= RecoveryDelay && CurrentStamina < MaxStamina)
+	ContinuousDrainRate = FMath::Max(0.0f, AmountPerSecond);
+	CommitChange(bWasExhausted);
+}
+
+void UCombatStaminaSystem::StopContinuousDrain()
+{
+	if (ContinuousDrainRate <= 0.0f)
 	{
-		float RecoveryRate = IsExhausted() ? ExhaustedRecoveryRate : BaseRecoveryRate;
-		RecoveryRate *= GetRecoveryRate(); // Apply efficiency multiplier
-		
-		CurrentStamina = FMath::Min(MaxStamina, CurrentStamina + (RecoveryRate * DeltaTime));
+		return;
 	}
+
+	const double Now = GetNow();
+	const bool bWasExhausted = IsExhausted();
+	Rebase(Now);
+
+	ContinuousDrainRate = 0.0f;
+	RecoveryStartTime = Now + GetTuning().RecoveryDelay;
+	CommitChange(bWasExhausted);
 }
 
-void UCombatStaminaSystem::DrainStamina(float Amount)
+bool UCombatStaminaSystem::IsStaminaChanging() const
 {
-	// Apply stamina efficiency (higher skill = less drain)
-	float ActualDrain = Amount * (1.0f / StaminaEfficiency);
-	
-	CurrentStamina = FMath::Max(0.0f, CurrentStamina - ActualDrain);
-	TimeSinceLastDrain = 0.0f;
+	const float Stamina = GetStamina();
+	if (ContinuousDrainRate > 0.0f)
+	{
+		return Stamina > 0.0f;
+	}
+	return Stamina < GetTuning().MaxStamina && GetNow() >= RecoveryStartTime;
 }
 
 bool UCombatStaminaSystem::HasStamina(float RequiredAmount) const
 {
-	return CurrentStamina >= RequiredAmount;
+	return GetStamina() >= RequiredAmount;
 }
 
 float UCombatStaminaSystem::GetRecoveryRate() const
@@ -44,16 +72,191 @@ float UCombatStaminaSystem::GetRecoveryRate() const
 	return StaminaEfficiency;
 }
 
+double UCombatStaminaSystem::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+float UCombatStaminaSystem::EvaluateStamina(double Time) const
+{
+	const CombatRules::FStaminaParams Params = GetStaminaParams();
+
+	// continuous drain: straight line down, no recovery
+	if (ContinuousDrainRate > 0.0f)
+	{
+		const float Elapsed = float(FMath::Max(0.0, Time - StaminaAnchorTime));
+		return FMath::Max(0.0f, CurrentStamina - CombatRules::StaminaDrainCost(Params, ContinuousDrainRate * Elapsed));
+	}
+
+	const double RecoveryFrom = FMath::Max(StaminaAnchorTime, RecoveryStartTime);
+	if (Time <= RecoveryFrom)
+	{
+		return CurrentStamina;
+	}
+
+	return CombatRules::RecoverStamina(Params, CurrentStamina, float(Time - RecoveryFrom));
+}
+
+CombatRules::FStaminaParams UCombatStaminaSystem::GetStaminaParams() const
+{
+	const FCombatStaminaTuning& Tuning = GetTuning();
+
+	CombatRules::FStaminaParams Params;
+	Params.MaxStamina = Tuning.MaxStamina;
+	Params.BaseRecoveryRate = Tuning.BaseRecoveryRate;
+	Params.ExhaustedRecoveryRate = Tuning.ExhaustedRecoveryRate;
+	Params.ExhaustionThreshold = Tuning.ExhaustionThreshold;
+	Params.Efficiency = GetRecoveryRate();
+	return Params;
+}
+
+void UCombatStaminaSystem::Rebase(double Time)
+{
+	CurrentStamina = EvaluateStamina(Time);
+	StaminaAnchorTime = Time;
+}
+
+void UCombatStaminaSystem::ScheduleNextTransition()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(TransitionTimer);
+
+	const FCombatStaminaTuning& Tuning = GetTuning();
+	const float MaxStamina = Tuning.MaxStamina;
+	const float ExhaustionThreshold = Tuning.ExhaustionThreshold;
+
+	// work out the next point where the piecewise-linear curve changes slope or ends
+	float Delay = -1.0f;
+	if (ContinuousDrainRate > 0.0f)
+	{
+		const float Rate = ContinuousDrainRate / StaminaEfficiency;
+		if (CurrentStamina > ExhaustionThreshold)
+		{
+			TransitionStamina = ExhaustionThreshold;
+			Delay = (CurrentStamina - ExhaustionThreshold) / Rate;
+		}
+		else if (CurrentStamina > 0.0f)
+		{
+			TransitionStamina = 0.0f;
+			Delay = CurrentStamina / Rate;
+		}
+	}
+	else if (CurrentStamina < MaxStamina)
+	{
+		const double Now = World->GetTimeSeconds();
+		const float ExhaustedRate = Tuning.ExhaustedRecoveryRate * GetRecoveryRate();
+		const float BaseRate = Tuning.BaseRecoveryRate * GetRecoveryRate();
+
+		if (Now < RecoveryStartTime)
+		{
+			TransitionStamina = CurrentStamina;
+			Delay = float(RecoveryStartTime - Now);
+		}
+		else if (CurrentStamina < ExhaustionThreshold && ExhaustedRate > 0.0f)
+		{
+			TransitionStamina = ExhaustionThreshold;
+			Delay = (ExhaustionThreshold - CurrentStamina) / ExhaustedRate;
+		}
+		else if (BaseRate > 0.0f)
+		{
+			TransitionStamina = MaxStamina;
+			Delay = (MaxStamina - CurrentStamina) / BaseRate;
+		}
+	}
+
+	if (Delay >= 0.0f)
+	{
+		// a zero delay would clear the timer instead of firing it
+		TimerManager.SetTimer(TransitionTimer, this, &UCombatStaminaSystem::HandleTransition, FMath::Max(Delay, UE_KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void UCombatStaminaSystem::HandleTransition()
+{
+	// segments are split at the threshold, so the anchor tells which side we were on
+	const bool bWasExhausted = CurrentStamina <= GetTuning().ExhaustionThreshold;
+
+	// land exactly on the transition value so float drift can't schedule a near-zero follow-up
+	StaminaAnchorTime = GetNow();
+	CurrentStamina = TransitionStamina;
+	CommitChange(bWasExhausted);
+}
+
+void UCombatStaminaSystem::CommitChange(bool bWasExhausted)
+{
+	OnStaminaChanged.Broadcast(CurrentStamina);
+
+	if (!bWasExhausted && CurrentStamina <= GetTuning().ExhaustionThreshold)
+	{
+		OnStaminaExhausted.Broadcast();
+	}
+
+	ScheduleNextTransition();
+}
+
+void UCombatStaminaSystem::RefreshTuning()
+{
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	// the anchor is evaluated with the new rates; close enough for a live edit
+	const double Now = GetNow();
+	const bool bWasExhausted = IsExhausted();
+	Rebase(Now);
+	CurrentStamina = FMath::Min(CurrentStamina, GetTuning().MaxStamina);
+	CommitChange(bWasExhausted);
+}
+
+void UCombatStaminaSystem::ResetForRespawn()
+{
+	const bool bWasExhausted = IsExhausted();
+
+	// skill levels may have been reset along with us
+	if (CombatComponents.Skill)
+	{
+		StaminaEfficiency = CombatComponents.Skill->GetStaminaEfficiency();
+	}
+
+	const double Now = GetNow();
+	ContinuousDrainRate = 0.0f;
+	CurrentStamina = GetTuning().MaxStamina;
+	StaminaAnchorTime = Now;
+	RecoveryStartTime = Now;
+	CommitChange(bWasExhausted);
+}
+
 void UCombatStaminaSystem::BeginPlay()
 {
 	Super::BeginPlay();
 
+	CombatComponents.ResolveIfUnwired(this);
+
 	// Get stamina efficiency from skill system if available
-	if (AActor* Owner = GetOwner())
+	if (CombatComponents.Skill)
 	{
-		if (UCombatSkillSystem* SkillSystem = Owner->FindComponentByClass<UCombatSkillSystem>())
-		{
-			StaminaEfficiency = SkillSystem->GetStaminaEfficiency();
-		}
+		StaminaEfficiency = CombatComponents.Skill->GetStaminaEfficiency();
+	}
+
+	CurrentStamina = FMath::Min(CurrentStamina, GetTuning().MaxStamina);
+	Rebase(GetNow());
+	ScheduleNextTransition();
+}
+
+void UCombatStaminaSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(TransitionTimer);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
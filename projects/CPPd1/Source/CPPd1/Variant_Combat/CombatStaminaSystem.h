@@ -4,11 +4,25 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "CombatComponentSet.h"
+#include "CombatTuningProfile.h"
 #include "CombatStaminaSystem.generated.h"
 
+namespace CombatRules { struct FStaminaParams; }
+
+/** Stamina changed delegate (0.0 to 1.0) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStaminaChanged, float, NewStamina);
+
+/** Stamina dropped to the exhaustion threshold */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStaminaExhausted);
+
 /**
  * Stamina system inspired by UFC 5
  * Manages stamina drain, recovery, and exhaustion states
+ *
+ * Does not tick. Stamina is stored as a value at a timestamp and evaluated analytically
+ * (delay, then exhausted-rate recovery up to the threshold, then base-rate recovery up to max).
+ * A single timer fires on the next real transition: recovery start, leaving or entering exhaustion, full, empty.
  */
 UCLASS(ClassGroup=(CPPd1), meta=(BlueprintSpawnableComponent))
 class UCombatStaminaSystem : public UActorComponent
@@ -19,63 +33,121 @@ public:
 
 	UCombatStaminaSystem();
 
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/** Receive direct pointers to the sibling combat components (set by the owning character) */
+	void SetCombatComponents(const FCombatComponentSet& InComponents) { CombatComponents = InComponents; }
+
+	/** Read tuning from the given profile (set by the owning character) */
+	void SetTuningProfile(UCombatTuningProfile* InProfile) { TuningProfile = InProfile; }
+
+	/** Re-anchor and reschedule after the tuning profile was edited */
+	void RefreshTuning();
+
+	/** Back to full stamina with no drain running, as on a fresh spawn (in-place respawn) */
+	void ResetForRespawn();
 
 	/** Get current stamina (0.0 to 1.0) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
-	float GetStamina() const { return CurrentStamina; }
+	float GetStamina() const { return EvaluateStamina(GetNow()); }
 
 	/** Get stamina percentage (0-100) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
-	float GetStaminaPercentage() const { return CurrentStamina * 100.0f; }
+	float GetStaminaPercentage() const { return GetStamina() * 100.0f; }
 
 	/** Drain stamina */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Stamina")
 	void DrainStamina(float Amount);
 
+	/** Drain stamina continuously (per second) until StopContinuousDrain. Recovery is held off while draining */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Stamina")
+	void StartContinuousDrain(float AmountPerSecond);
+
+	/** Stop a continuous drain. The recovery delay starts now */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Stamina")
+	void StopContinuousDrain();
+
+	/** True while stamina is moving (draining continuously or recovering), i.e. GetStamina() differs frame to frame */
+	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
+	bool IsStaminaChanging() const;
+
 	/** Check if has enough stamina for an action */
 	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
 	bool HasStamina(float RequiredAmount) const;
 
 	/** Check if exhausted (stamina too low) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
-	bool IsExhausted() const { return CurrentStamina <= ExhaustionThreshold; }
+	bool IsExhausted() const { return GetStamina() <= GetTuning().ExhaustionThreshold; }
 
 	/** Get stamina recovery rate multiplier */
 	UFUNCTION(BlueprintPure, Category = "Combat|Stamina")
 	float GetRecoveryRate() const;
 
-protected:
+	/** Fired whenever CurrentStamina changes (drain or recovery) */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnStaminaChanged OnStaminaChanged;
 
-	/** Maximum stamina */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float MaxStamina = 1.0f;
+	/** Fired when stamina reaches the exhaustion threshold */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnStaminaExhausted OnStaminaExhausted;
 
-	/** Current stamina */
+protected:
+
+	/** Stamina at StaminaAnchorTime. Use GetStamina() for the current value */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
 	float CurrentStamina = 1.0f;
 
-	/** Base recovery rate per second */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stamina")
-	float BaseRecoveryRate = 0.2f;
+	/** Shared tuning. Null reads the profile defaults */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatTuningProfile> TuningProfile;
 
-	/** Recovery rate when exhausted (slower) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stamina")
-	float ExhaustedRecoveryRate = 0.05f;
+	/** World time CurrentStamina was sampled at */
+	double StaminaAnchorTime = 0.0;
 
-	/** Stamina threshold for exhaustion */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stamina", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
-	float ExhaustionThreshold = 0.2f;
+	/** World time recovery may begin (last drain + RecoveryDelay) */
+	double RecoveryStartTime = 0.0;
 
-	/** Time before stamina starts recovering after drain */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stamina")
-	float RecoveryDelay = 1.0f;
+	/** Active continuous drain per second (before efficiency), 0 when not draining */
+	float ContinuousDrainRate = 0.0f;
 
-	/** Time since last stamina drain */
-	float TimeSinceLastDrain = 0.0f;
+	/** Stamina value the pending transition timer lands on */
+	float TransitionStamina = 1.0f;
+
+	/** Fires on the next stamina state transition */
+	FTimerHandle TransitionTimer;
 
 	/** Stamina efficiency multiplier (from skill system) */
 	float StaminaEfficiency = 1.0f;
 
+	/** Sibling combat components. Resolved from the owner on BeginPlay if nobody wired them */
+	UPROPERTY(Transient)
+	FCombatComponentSet CombatComponents;
+
+	/** The owning character sets the starting stamina */
+	friend class ACombatCharacter;
+
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Stamina section of the tuning profile */
+	const FCombatStaminaTuning& GetTuning() const { return UCombatTuningProfile::GetOrDefault(TuningProfile)->Stamina; }
+
+	/** Current world time, 0 without a world */
+	double GetNow() const;
+
+	/** Closed-form stamina at the given world time */
+	float EvaluateStamina(double Time) const;
+
+	/** Current tuning in the shape the shared combat rules take */
+	CombatRules::FStaminaParams GetStaminaParams() const;
+
+	/** Re-anchor CurrentStamina at the given time */
+	void Rebase(double Time);
+
+	/** Schedule TransitionTimer for the next state change after the current anchor */
+	void ScheduleNextTransition();
+
+	/** TransitionTimer callback */
+	void HandleTransition();
+
+	/** Broadcast change/exhaustion events and reschedule after the anchor changed */
+	void CommitChange(bool bWasExhausted);
 };
@@ -1,20 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTrickSystem.h"
+#include "CPPd1.h"
 #include "Animation/AnimMontage.h"
 
 UCombatTrickSystem::UCombatTrickSystem()
 {
+	LLM_SCOPE_BYTAG(Combat_TricksSkills);
+
 	MaxInputGap = 0.5f;
 }
 
 void UCombatTrickSystem::RegisterTrick(const FCombatTrick& Trick)
 {
 	RegisteredTricks.Add(Trick);
+	bMatcherDirty = true;
 }
 
 bool UCombatTrickSystem::CheckTrickInput(const FCombatTrickInput& Input, float DeltaTime)
 {
+	EnsureMatcher();
+
 	TimeSinceLastInput += DeltaTime;
 
 	// If too much time has passed, reset sequence
@@ -23,84 +29,227 @@ bool UCombatTrickSystem::CheckTrickInput(const FCombatTrickInput& Input, float D
 		ClearInputSequence();
 	}
 
-	// Add new input
-	CurrentInputSequence.Add(Input);
+	// Add new input, overwriting the oldest once the history is full
+	InputHistory[InputHistoryHead] = Input;
+	InputHistoryHead = (InputHistoryHead + 1) % MaxInputHistory;
+	InputHistoryNum = FMath::Min(InputHistoryNum + 1, MaxInputHistory);
 	TimeSinceLastInput = 0.0f;
 
-	// Limit sequence length
-	if (CurrentInputSequence.Num() > 10)
-	{
-		CurrentInputSequence.RemoveAt(0);
-	}
+	CurrentState = Advance(CurrentState, Input);
 
 	return true;
 }
 
 FCombatTrick UCombatTrickSystem::GetBestMatchingTrick(int32 CurrentSkillLevel) const
 {
-	FCombatTrick BestTrick;
-	float BestMatchScore = 0.0f;
+	const FCombatTrick* Trick = GetTrick(GetBestMatchingTrickHandle(CurrentSkillLevel));
+	return Trick ? *Trick : FCombatTrick();
+}
 
-	for (const FCombatTrick& Trick : RegisteredTricks)
+FCombatTrickHandle UCombatTrickSystem::GetBestMatchingTrickHandle(int32 CurrentSkillLevel) const
+{
+	EnsureMatcher();
+
+	FCombatTrickHandle Handle;
+
+	// matches are stored longest first, so the first one the skill level allows wins
+	const int32 Start = StateMatchStart[CurrentState];
+	for (int32 i = 0; i < StateMatchCount[CurrentState]; ++i)
 	{
-		// Check skill requirement
-		if (Trick.RequiredSkillLevel > CurrentSkillLevel)
+		const int32 TrickIndex = StateMatches[Start + i];
+		if (RegisteredTricks[TrickIndex].RequiredSkillLevel <= CurrentSkillLevel)
 		{
-			continue;
+			Handle.Index = TrickIndex;
+			break;
 		}
+	}
+
+	return Handle;
+}
+
+const FCombatTrick* UCombatTrickSystem::GetTrick(FCombatTrickHandle Handle) const
+{
+	return RegisteredTricks.IsValidIndex(Handle.Index) ? &RegisteredTricks[Handle.Index] : nullptr;
+}
+
+void UCombatTrickSystem::ClearInputSequence()
+{
+	InputHistoryHead = 0;
+	InputHistoryNum = 0;
+	CurrentState = 0;
+	TimeSinceLastInput = 0.0f;
+	TrickChainCount = 0;
+}
+
+void UCombatTrickSystem::RebuildMatcher()
+{
+	LLM_SCOPE_BYTAG(Combat_TricksSkills);
 
-		// Check if input sequence matches
-		if (Trick.InputSequence.Num() > CurrentInputSequence.Num())
+	bMatcherDirty = true;
+	EnsureMatcher();
+}
+
+TArray<FCombatTrickInput> UCombatTrickSystem::GetCurrentInputSequence() const
+{
+	TArray<FCombatTrickInput> Sequence;
+	Sequence.Reserve(InputHistoryNum);
+
+	const int32 Oldest = (InputHistoryHead - InputHistoryNum + MaxInputHistory) % MaxInputHistory;
+	for (int32 i = 0; i < InputHistoryNum; ++i)
+	{
+		Sequence.Add(InputHistory[(Oldest + i) % MaxInputHistory]);
+	}
+
+	return Sequence;
+}
+
+float UCombatTrickSystem::GetFlowMultiplier() const
+{
+	// Flow multiplier increases with trick chain
+	return 1.0f + (TrickChainCount * 0.1f);
+}
+
+void UCombatTrickSystem::EnsureMatcher() const
+{
+	if (bMatcherDirty)
+	{
+		BuildMatcher();
+	}
+}
+
+int32 UCombatTrickSystem::Advance(int32 State, const FCombatTrickInput& Input) const
+{
+	// inputs no trick uses can't continue any match
+	const int32* Symbol = SymbolIds.Find(MakeSymbolKey(Input));
+	return Symbol ? StateTransitions[State * NumSymbols + *Symbol] : 0;
+}
+
+void UCombatTrickSystem::BuildMatcher() const
+{
+	bMatcherDirty = false;
+
+	SymbolIds.Reset();
+	StateTransitions.Reset();
+	StateMatchStart.Reset();
+	StateMatchCount.Reset();
+	StateMatches.Reset();
+
+	// tricks longer than the history could never match
+	auto IsMatchable = [](const FCombatTrick& Trick)
+	{
+		return Trick.InputSequence.Num() > 0 && Trick.InputSequence.Num() <= MaxInputHistory;
+	};
+
+	// alphabet: only the symbols some trick uses
+	int32 NumNodes = 1;
+	for (const FCombatTrick& Trick : RegisteredTricks)
+	{
+		if (!IsMatchable(Trick)) continue;
+
+		for (const FCombatTrickInput& Input : Trick.InputSequence)
 		{
-			continue;
+			if (!SymbolIds.Contains(MakeSymbolKey(Input)))
+			{
+				SymbolIds.Add(MakeSymbolKey(Input), SymbolIds.Num());
+			}
 		}
+		NumNodes += Trick.InputSequence.Num();
+	}
+	NumSymbols = FMath::Max(1, SymbolIds.Num());
+
+	// trie, stored straight into the transition table (INDEX_NONE = no child yet)
+	StateTransitions.Init(INDEX_NONE, NumNodes * NumSymbols);
+	TArray<TArray<int32>> NodeMatches;
+	NodeMatches.SetNum(NumNodes);
+	int32 NextNode = 1;
 
-		// Calculate match score
-		float MatchScore = 0.0f;
-		bool bMatches = true;
+	for (int32 TrickIndex = 0; TrickIndex < RegisteredTricks.Num(); ++TrickIndex)
+	{
+		const FCombatTrick& Trick = RegisteredTricks[TrickIndex];
+		if (!IsMatchable(Trick)) continue;
 
-		for (int32 i = 0; i < Trick.InputSequence.Num(); ++i)
+		int32 Node = 0;
+		for (const FCombatTrickInput& Input : Trick.InputSequence)
 		{
-			int32 SequenceIndex = CurrentInputSequence.Num() - Trick.InputSequence.Num() + i;
-			if (SequenceIndex < 0 || SequenceIndex >= CurrentInputSequence.Num())
+			int32& Child = StateTransitions[Node * NumSymbols + SymbolIds.FindChecked(MakeSymbolKey(Input))];
+			if (Child == INDEX_NONE)
 			{
-				bMatches = false;
-				break;
+				Child = NextNode++;
 			}
+			Node = Child;
+		}
+		NodeMatches[Node].Add(TrickIndex);
+	}
+
+	// breadth-first failure links; missing edges borrow the failure state's edge so the table becomes a full DFA
+	TArray<int32> Fail;
+	Fail.Init(0, NextNode);
+	TArray<int32> Queue;
+	Queue.Reserve(NextNode);
+
+	for (int32 Symbol = 0; Symbol < NumSymbols; ++Symbol)
+	{
+		int32& Child = StateTransitions[Symbol];
+		if (Child == INDEX_NONE)
+		{
+			Child = 0;
+		}
+		else
+		{
+			Queue.Add(Child);
+		}
+	}
+
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 Node = Queue[QueueIndex];
 
-			const FCombatTrickInput& TrickInput = Trick.InputSequence[i];
-			const FCombatTrickInput& CurrentInput = CurrentInputSequence[SequenceIndex];
+		// everything the failure state matches also ends here (failure states are shallower, so already final)
+		NodeMatches[Node].Append(NodeMatches[Fail[Node]]);
 
-			if (TrickInput.Direction == CurrentInput.Direction && TrickInput.Button == CurrentInput.Button)
+		for (int32 Symbol = 0; Symbol < NumSymbols; ++Symbol)
+		{
+			int32& Child = StateTransitions[Node * NumSymbols + Symbol];
+			const int32 FailTarget = StateTransitions[Fail[Node] * NumSymbols + Symbol];
+			if (Child == INDEX_NONE)
 			{
-				MatchScore += 1.0f;
+				Child = FailTarget;
 			}
 			else
 			{
-				bMatches = false;
-				break;
+				Fail[Child] = FailTarget;
+				Queue.Add(Child);
 			}
 		}
+	}
 
-		if (bMatches && MatchScore > BestMatchScore)
+	// flatten the per-state match lists, longest trick first, then registration order
+	StateTransitions.SetNum(NextNode * NumSymbols);
+	StateMatchStart.SetNumUninitialized(NextNode);
+	StateMatchCount.SetNumUninitialized(NextNode);
+
+	for (int32 Node = 0; Node < NextNode; ++Node)
+	{
+		TArray<int32>& Matches = NodeMatches[Node];
+		Matches.Sort([this](int32 A, int32 B)
 		{
-			BestMatchScore = MatchScore;
-			BestTrick = Trick;
-		}
+			const int32 LengthA = RegisteredTricks[A].InputSequence.Num();
+			const int32 LengthB = RegisteredTricks[B].InputSequence.Num();
+			return LengthA != LengthB ? LengthA > LengthB : A < B;
+		});
+
+		StateMatchStart[Node] = StateMatches.Num();
+		StateMatchCount[Node] = Matches.Num();
+		StateMatches.Append(Matches);
 	}
 
-	return BestTrick;
-}
-
-void UCombatTrickSystem::ClearInputSequence()
-{
-	CurrentInputSequence.Empty();
-	TimeSinceLastInput = 0.0f;
-	TrickChainCount = 0;
-}
+	// replay the history so the current state is valid for the new automaton
+	CurrentState = 0;
+	const int32 Oldest = (InputHistoryHead - InputHistoryNum + MaxInputHistory) % MaxInputHistory;
+	for (int32 i = 0; i < InputHistoryNum; ++i)
+	{
+		CurrentState = Advance(CurrentState, InputHistory[(Oldest + i) % MaxInputHistory]);
+	}
 
-float UCombatTrickSystem::GetFlowMultiplier() const
-{
-	// Flow multiplier increases with trick chain
-	return 1.0f + (TrickChainCount * 0.1f);
+	UE_LOG(LogCPPd1, Verbose, TEXT("TrickSystem: compiled %d tricks into %d states over %d symbols"), RegisteredTricks.Num(), NextNode, SymbolIds.Num());
 }
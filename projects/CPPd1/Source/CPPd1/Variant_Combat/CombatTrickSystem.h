@@ -86,9 +86,25 @@ struct FCombatTrick
 	{}
 };
 
+/** Stable reference to a registered trick (index into RegisteredTricks) */
+USTRUCT(BlueprintType)
+struct FCombatTrickHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Index = INDEX_NONE;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+};
+
 /**
  * Trick system for combat - inspired by Skate 4's trick system
  * Allows chaining directional inputs + buttons to create combos
+ *
+ * Registered tricks are compiled into an Aho-Corasick automaton over (direction, button) symbols.
+ * Each input advances the automaton by one table lookup, and every state already knows which tricks
+ * end there (longest first), so matching does not depend on how many tricks are registered.
  */
 UCLASS(BlueprintType, Blueprintable)
 class UCombatTrickSystem : public UObject
@@ -107,17 +123,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Trick")
 	bool CheckTrickInput(const FCombatTrickInput& Input, float DeltaTime);
 
-	/** Get the best matching trick from current input sequence */
+	/** Get the best matching trick from current input sequence (Blueprint convenience, copies the trick) */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Trick")
 	FCombatTrick GetBestMatchingTrick(int32 CurrentSkillLevel) const;
 
+	/** Longest registered trick the recent inputs end with, that the skill level allows. Invalid if none */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Trick")
+	FCombatTrickHandle GetBestMatchingTrickHandle(int32 CurrentSkillLevel) const;
+
+	/** Resolve a handle returned by GetBestMatchingTrickHandle. Null if the handle is invalid */
+	const FCombatTrick* GetTrick(FCombatTrickHandle Handle) const;
+
 	/** Clear the current input sequence */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Trick")
 	void ClearInputSequence();
 
-	/** Get current input sequence (for debugging) */
+	/** Recompile the matcher. Needed only after editing RegisteredTricks directly (RegisterTrick does it for you) */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Trick")
+	void RebuildMatcher();
+
+	/** Get current input sequence, oldest first (for debugging) */
 	UFUNCTION(BlueprintPure, Category = "Combat|Trick")
-	TArray<FCombatTrickInput> GetCurrentInputSequence() const { return CurrentInputSequence; }
+	TArray<FCombatTrickInput> GetCurrentInputSequence() const;
+
+	/** Number of inputs kept in the history */
+	static constexpr int32 MaxInputHistory = 10;
 
 	/** Get flow multiplier based on trick chain */
 	UFUNCTION(BlueprintPure, Category = "Combat|Trick")
@@ -129,8 +159,47 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Trick")
 	TArray<FCombatTrick> RegisteredTricks;
 
-	/** Current input sequence being built */
-	TArray<FCombatTrickInput> CurrentInputSequence;
+	/** Ring buffer of the most recent inputs */
+	FCombatTrickInput InputHistory[MaxInputHistory];
+
+	/** Slot the next input is written to */
+	int32 InputHistoryHead = 0;
+
+	/** Number of valid inputs in the ring buffer */
+	int32 InputHistoryNum = 0;
+
+	/** Packed (button, direction) -> symbol column in StateTransitions. The automaton is compiled lazily, hence mutable */
+	mutable TMap<uint32, int32> SymbolIds;
+
+	/** Dense transition table: StateTransitions[State * NumSymbols + Symbol] */
+	mutable TArray<int32> StateTransitions;
+
+	/** Per state: range into StateMatches of the tricks ending there, longest first */
+	mutable TArray<int32> StateMatchStart;
+	mutable TArray<int32> StateMatchCount;
+
+	/** Trick indices referenced by StateMatchStart/StateMatchCount */
+	mutable TArray<int32> StateMatches;
+
+	mutable int32 NumSymbols = 0;
+
+	/** Automaton state after the inputs in the history (0 = root) */
+	mutable int32 CurrentState = 0;
+
+	/** RegisteredTricks changed since the automaton was built */
+	mutable bool bMatcherDirty = true;
+
+	/** Pack an input into the key used by SymbolIds */
+	static uint32 MakeSymbolKey(const FCombatTrickInput& Input) { return (static_cast<uint32>(Input.Button) << 8) | static_cast<uint32>(Input.Direction); }
+
+	/** Build the automaton if RegisteredTricks changed */
+	void EnsureMatcher() const;
+
+	/** Compile RegisteredTricks into the automaton and replay the history through it */
+	void BuildMatcher() const;
+
+	/** Follow one input from a state */
+	int32 Advance(int32 State, const FCombatTrickInput& Input) const;
 
 	/** Time since last input */
 	float TimeSinceLastInput = 0.0f;
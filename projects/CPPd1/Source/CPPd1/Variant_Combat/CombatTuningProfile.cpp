@@ -0,0 +1,15 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTuningProfile.h"
+
+FOnCombatTuningProfileChanged UCombatTuningProfile::OnProfileChanged;
+
+#if WITH_EDITOR
+void UCombatTuningProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// characters in a running PIE world re-apply whatever they cache from the profile
+	OnProfileChanged.Broadcast(this);
+}
+#endif // WITH_EDITOR
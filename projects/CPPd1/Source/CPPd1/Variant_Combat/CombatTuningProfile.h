@@ -0,0 +1,254 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatTuningProfile.generated.h"
+
+class UCombatTuningProfile;
+
+/** A profile was edited. Fired in the editor, including while PIE is running */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatTuningProfileChanged, const UCombatTuningProfile*);
+
+/** Character movement tuning */
+USTRUCT(BlueprintType)
+struct FCombatMovementTuning
+{
+	GENERATED_BODY()
+
+	/** Character movement speed (walk speed) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, Units = "cm/s"))
+	float MovementSpeed = 400.0f;
+
+	/** Character jump velocity */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, Units = "cm/s"))
+	float JumpVelocity = 500.0f;
+
+	/** Air control amount (0.0 = no control, 1.0 = full control) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float AirControl = 0.35f;
+
+	/** Character rotation rate (how fast character turns) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, Units = "deg/s"))
+	float RotationRate = 500.0f;
+};
+
+/** Trick system tuning */
+USTRUCT(BlueprintType)
+struct FCombatTrickTuning
+{
+	GENERATED_BODY()
+
+	/** Maximum time between trick inputs to maintain combo (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 2.0f, Units = "s"))
+	float TrickInputGapTime = 0.5f;
+
+	/** Base flow points awarded for any trick */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float BaseTrickFlowPoints = 10.0f;
+
+	/** Flow point multiplier for complex tricks */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1.0f))
+	float ComplexTrickMultiplier = 1.5f;
+};
+
+/** Skill system tuning */
+USTRUCT(BlueprintType)
+struct FCombatSkillTuning
+{
+	GENERATED_BODY()
+
+	/** Starting skill level for all skills (0-100) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 100.0f))
+	float StartingSkillLevel = 0.0f;
+
+	/** Experience multiplier for skill gains (1.0 = normal, 2.0 = double) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.1f, ClampMax = 10.0f))
+	float ExperienceMultiplier = 1.0f;
+
+	/** Base damage multiplier at skill level 0 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.1f))
+	float BaseDamageMultiplier = 0.5f;
+
+	/** Maximum damage multiplier at skill level 100 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1.0f))
+	float MaxDamageMultiplier = 2.0f;
+
+	/** Base defense effectiveness at skill level 0 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float BaseDefenseEffectiveness = 0.3f;
+
+	/** Max defense effectiveness at skill level 100 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float MaxDefenseEffectiveness = 0.9f;
+};
+
+/** Stamina system tuning */
+USTRUCT(BlueprintType)
+struct FCombatStaminaTuning
+{
+	GENERATED_BODY()
+
+	/** Maximum stamina (0.0 to 1.0) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float MaxStamina = 1.0f;
+
+	/** Stamina drain per light attack */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float LightAttackStaminaCost = 0.10f;
+
+	/** Stamina drain per heavy attack */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float HeavyAttackStaminaCost = 0.25f;
+
+	/** Stamina drain per second while blocking */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float BlockStaminaDrainRate = 0.15f;
+
+	/** Base stamina recovery rate per second */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float BaseRecoveryRate = 0.2f;
+
+	/** Recovery rate per second below the exhaustion threshold (slower) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float ExhaustedRecoveryRate = 0.05f;
+
+	/** Time delay before stamina starts recovering after drain */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, Units = "s"))
+	float RecoveryDelay = 1.0f;
+
+	/** Stamina threshold for exhaustion (below this = exhausted) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float ExhaustionThreshold = 0.2f;
+};
+
+/** Flow system tuning */
+USTRUCT(BlueprintType)
+struct FCombatFlowTuning
+{
+	GENERATED_BODY()
+
+	/** Maximum flow meter (0.0 to 1.0) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float MaxFlow = 1.0f;
+
+	/** Flow decay rate per second */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float FlowDecayRate = 0.1f;
+
+	/** Flow threshold to enter flow state (0.0 to 1.0) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float FlowStateThreshold = 0.7f;
+
+	/** Damage/speed multiplier when in flow state */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1.0f))
+	float FlowStateMultiplier = 1.5f;
+
+	/** Flow points per combo hit (100 = full meter), multiplied by the combo count */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float FlowPointsPerCombo = 5.0f;
+
+	/** Time before combo resets (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, Units = "s"))
+	float ComboResetTime = 3.0f;
+
+	/** Flow added per combo hit on the 0-1 meter */
+	float GetComboFlowPoints() const { return FlowPointsPerCombo * 0.01f; }
+};
+
+/** Parry, counter and block tuning */
+USTRUCT(BlueprintType)
+struct FCombatAdvancedTuning
+{
+	GENERATED_BODY()
+
+	/** Perfect parry window duration (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f, Units = "s"))
+	float PerfectParryWindow = 0.1f;
+
+	/** Good parry window duration (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f, Units = "s"))
+	float GoodParryWindow = 0.2f;
+
+	/** Perfect parry damage multiplier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1.0f))
+	float PerfectParryDamageMultiplier = 2.0f;
+
+	/** Counter-attack window after parry (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, Units = "s"))
+	float CounterAttackWindow = 1.0f;
+
+	/** Base block effectiveness (damage reduction, 0.0 to 1.0) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float BaseBlockEffectiveness = 0.5f;
+};
+
+/** General damage tuning */
+USTRUCT(BlueprintType)
+struct FCombatGeneralTuning
+{
+	GENERATED_BODY()
+
+	/** Global damage multiplier (affects all damage dealt) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float GlobalDamageMultiplier = 1.0f;
+
+	/** Global defense multiplier (affects all damage received) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f))
+	float GlobalDefenseMultiplier = 1.0f;
+
+	/** Invincibility frames after taking damage (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0f, Units = "s"))
+	float InvincibilityFrames = 0.5f;
+};
+
+/**
+ * Shared combat tuning.
+ * One asset holds the balance values every combat character and its stamina, flow, skill and advanced mechanics
+ * components read at runtime. Instances only keep a pointer, so characters using the same profile share one copy,
+ * and a character without a profile reads the class defaults below.
+ *
+ * Editing a profile while PIE is running applies to every character using it on the spot (OnProfileChanged).
+ */
+UCLASS(BlueprintType)
+class UCombatTuningProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (ShowOnlyInnerProperties))
+	FCombatMovementTuning Movement;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trick System", meta = (ShowOnlyInnerProperties))
+	FCombatTrickTuning Trick;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill System", meta = (ShowOnlyInnerProperties))
+	FCombatSkillTuning Skill;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina", meta = (ShowOnlyInnerProperties))
+	FCombatStaminaTuning Stamina;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow System", meta = (ShowOnlyInnerProperties))
+	FCombatFlowTuning Flow;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Advanced Mechanics", meta = (ShowOnlyInnerProperties))
+	FCombatAdvancedTuning Advanced;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat", meta = (ShowOnlyInnerProperties))
+	FCombatGeneralTuning Combat;
+
+	/** The given profile, or the class defaults if there is none */
+	static const UCombatTuningProfile* GetOrDefault(const UCombatTuningProfile* Profile)
+	{
+		return Profile ? Profile : GetDefault<UCombatTuningProfile>();
+	}
+
+	/** Fired after any profile is edited */
+	static FOnCombatTuningProfileChanged OnProfileChanged;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif // WITH_EDITOR
+};
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatVariantAssets.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+
+const FPrimaryAssetType UCombatVariantAssets::PrimaryAssetType(TEXT("CombatVariant"));
+const FName UCombatVariantAssets::MenuBundle(TEXT("Menu"));
+const FName UCombatVariantAssets::GameBundle(TEXT("Game"));
+
+void UCombatVariantAssets::GatherClassAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const TSoftClassPtr<ACombatCharacter>& Character : Characters)
+	{
+		if (const UClass* Class = Character.Get())
+		{
+			GetDefault<ACombatCharacter>(Class)->GatherPreloadAssets(OutPaths);
+		}
+	}
+
+	for (const TSoftClassPtr<ACombatEnemy>& Enemy : Enemies)
+	{
+		if (const UClass* Class = Enemy.Get())
+		{
+			GetDefault<ACombatEnemy>(Class)->GatherPreloadAssets(OutPaths);
+		}
+	}
+}
+
+FPrimaryAssetId UCombatVariantAssets::GetPrimaryAssetId() const
+{
+	// one type for every variant asset, including Blueprint subclasses of this class
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatVariantAssets.generated.h"
+
+class ACombatCharacter;
+class ACombatEnemy;
+class UUserWidget;
+
+/**
+ * Everything one combat variant (Combat, Ninja, ...) needs at runtime, as soft references grouped into
+ * Asset Manager bundles:
+ *  - Menu: widgets shown while the map is still loading, e.g. the input mode selection screen
+ *  - Game: characters, enemies and in-game widgets
+ *
+ * The Game bundle only names classes. Once they are loaded, UCombatAssetLoader also loads the soft assets those
+ * classes declare (attack montages), so they don't have to be listed twice.
+ *
+ * Create one asset per variant under /Game/Variant_Combat and point the game mode's Variant Assets at it.
+ */
+UCLASS(BlueprintType)
+class UCombatVariantAssets : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Primary asset type scanned by the Asset Manager (see DefaultGame.ini) */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/** Bundle names */
+	static const FName MenuBundle;
+	static const FName GameBundle;
+
+	/** Player and partner character classes */
+	UPROPERTY(EditDefaultsOnly, Category = "Game", meta = (AssetBundles = "Game"))
+	TArray<TSoftClassPtr<ACombatCharacter>> Characters;
+
+	/** Enemy classes spawned by this variant's waves and spawners */
+	UPROPERTY(EditDefaultsOnly, Category = "Game", meta = (AssetBundles = "Game"))
+	TArray<TSoftClassPtr<ACombatEnemy>> Enemies;
+
+	/** HUD, controls overlay and other widgets created once play starts */
+	UPROPERTY(EditDefaultsOnly, Category = "Game", meta = (AssetBundles = "Game"))
+	TArray<TSoftClassPtr<UUserWidget>> GameWidgets;
+
+	/** Widgets needed before the Game bundle is in, e.g. the input mode selection screen */
+	UPROPERTY(EditDefaultsOnly, Category = "Menu", meta = (AssetBundles = "Menu"))
+	TArray<TSoftClassPtr<UUserWidget>> MenuWidgets;
+
+	/** Soft assets declared by the loaded character and enemy classes. Call once the Game bundle is loaded */
+	void GatherClassAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+};
@@ -0,0 +1,466 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatBenchmark.h"
+#include "CombatWaveSpawner.h"
+#include "CombatEnemy.h"
+#include "CombatCharacter.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** Give up waiting for a phase to fill after this long (spawns failing, etc.) */
+	const float MaxSpawnSeconds = 60.0f;
+
+	/** Seconds between memory samples; reading process memory isn't free on every platform */
+	const double MemorySampleInterval = 0.25;
+
+	/** Bots stop walking in once this close to their target */
+	const float BotStopDistance = 150.0f;
+
+	float Percentile(TArray<float>& Sorted, float Fraction)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	float Mean(const TArray<float>& Values)
+	{
+		double Total = 0.0;
+		for (float Value : Values)
+		{
+			Total += Value;
+		}
+		return Values.Num() > 0 ? float(Total / Values.Num()) : 0.0f;
+	}
+
+	double ToMB(uint64 Bytes)
+	{
+		return double(Bytes) / (1024.0 * 1024.0);
+	}
+
+	void RunBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatBenchmark* Benchmark = World ? World->GetSubsystem<UCombatBenchmark>() : nullptr;
+		if (!Benchmark)
+		{
+			UE_LOG(LogCPPd1, Warning, TEXT("Combat.Benchmark: only available in a game world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+		{
+			Benchmark->StopBenchmark();
+			return;
+		}
+
+		FCombatBenchmarkSettings Settings;
+		UCombatBenchmark::ParseSettings(*FString::Join(Args, TEXT(" ")), TEXT(""), Settings);
+		Settings.bQuitWhenDone = Args.Contains(TEXT("Quit"));
+		Benchmark->StartBenchmark(Settings);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CombatBenchmarkCommand(
+		TEXT("Combat.Benchmark"),
+		TEXT("Runs the wave-combat benchmark. Combat.Benchmark [Counts=10,50,200,500] [Phase=20] [Warmup=3] [Out=Saved/Benchmarks/CombatBenchmark.csv] [Quit], or Combat.Benchmark Stop"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmarkCommand));
+}
+
+void UCombatBenchmark::ParseSettings(const TCHAR* Stream, const TCHAR* Prefix, FCombatBenchmarkSettings& OutSettings)
+{
+	const FString Key(Prefix);
+
+	FString Counts;
+	if (FParse::Value(Stream, *(Key + TEXT("Counts=")), Counts, false))
+	{
+		TArray<FString> Parts;
+		Counts.ParseIntoArray(Parts, TEXT(","));
+
+		OutSettings.EnemyCounts.Reset();
+		for (const FString& Part : Parts)
+		{
+			const int32 Count = FCString::Atoi(*Part);
+			if (Count > 0)
+			{
+				OutSettings.EnemyCounts.Add(Count);
+			}
+		}
+	}
+
+	FParse::Value(Stream, *(Key + TEXT("Phase=")), OutSettings.PhaseSeconds);
+	FParse::Value(Stream, *(Key + TEXT("Warmup=")), OutSettings.WarmupSeconds);
+	FParse::Value(Stream, *(Key + TEXT("Out=")), OutSettings.OutputPath, false);
+}
+
+bool UCombatBenchmark::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatBenchmark::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// unattended runs: -CombatBenchmark starts on the first map and quits when done
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (FParse::Param(CommandLine, TEXT("CombatBenchmark")))
+	{
+		FCombatBenchmarkSettings CommandLineSettings;
+		ParseSettings(CommandLine, TEXT("CombatBenchmark"), CommandLineSettings);
+		CommandLineSettings.bQuitWhenDone = true;
+		StartBenchmark(CommandLineSettings);
+	}
+}
+
+void UCombatBenchmark::Deinitialize()
+{
+	UnbindTimingDelegates();
+	State = EState::Idle;
+
+	Super::Deinitialize();
+}
+
+TStatId UCombatBenchmark::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatBenchmark, STATGROUP_Combat);
+}
+
+bool UCombatBenchmark::StartBenchmark(const FCombatBenchmarkSettings& InSettings)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("CombatBenchmark: already running"));
+		return false;
+	}
+
+	TActorIterator<ACombatWaveSpawner> It(GetWorld());
+	if (!It)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatBenchmark: %s has no CombatWaveSpawner"), *GetWorld()->GetMapName());
+		return false;
+	}
+
+	if (InSettings.EnemyCounts.Num() == 0)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatBenchmark: no enemy counts given"));
+		return false;
+	}
+
+	Settings = InSettings;
+	if (Settings.OutputPath.IsEmpty())
+	{
+		Settings.OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/CombatBenchmark.csv");
+	}
+	Settings.OutputPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Settings.OutputPath);
+
+	Spawner = *It;
+	Phases.Reset();
+
+	BindTimingDelegates();
+	StartPhase(0);
+	return true;
+}
+
+void UCombatBenchmark::StopBenchmark()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	// drop the unfinished phase
+	Phases.Pop();
+	UE_LOG(LogCPPd1, Display, TEXT("CombatBenchmark: stopped"));
+	FinishBenchmark();
+}
+
+void UCombatBenchmark::StartPhase(int32 PhaseIndex)
+{
+	ACombatWaveSpawner* WaveSpawner = Spawner.Get();
+	if (!WaveSpawner)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatBenchmark: wave spawner went away"));
+		FinishBenchmark();
+		return;
+	}
+
+	ClearEnemies();
+
+	FCombatBenchmarkPhase& Phase = Phases.AddDefaulted_GetRef();
+	Phase.EnemyCount = Settings.EnemyCounts[PhaseIndex];
+
+	WaveSpawner->StartScriptedWave(Phase.EnemyCount, Settings.SpawnInterval);
+
+	State = EState::Spawning;
+	StateTime = 0.0f;
+
+	UE_LOG(LogCPPd1, Display, TEXT("CombatBenchmark: phase %d/%d, %d enemies"), PhaseIndex + 1, Settings.EnemyCounts.Num(), Phase.EnemyCount);
+}
+
+void UCombatBenchmark::EndPhase()
+{
+	FCombatBenchmarkPhase& Phase = Phases.Last();
+	if (const ACombatWaveSpawner* WaveSpawner = Spawner.Get())
+	{
+		Phase.EnemiesAliveAtEnd = WaveSpawner->GetCurrentWaveEnemyCount();
+	}
+	Phase.ProcessPeakPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+
+	if (Phases.Num() < Settings.EnemyCounts.Num())
+	{
+		StartPhase(Phases.Num());
+	}
+	else
+	{
+		FinishBenchmark();
+	}
+}
+
+void UCombatBenchmark::FinishBenchmark()
+{
+	UnbindTimingDelegates();
+	State = EState::Idle;
+
+	ClearEnemies();
+	if (ACombatWaveSpawner* WaveSpawner = Spawner.Get())
+	{
+		WaveSpawner->ResetWaves();
+	}
+
+	for (FCombatBenchmarkPhase& Phase : Phases)
+	{
+		TArray<float> Sorted = Phase.FrameMs;
+		Sorted.Sort();
+		UE_LOG(LogCPPd1, Display, TEXT("CombatBenchmark: %4d enemies  frame p50 %.2fms p99 %.2fms  game thread %.2fms  GC %d (max %.1fms)  mem %.0fMB"),
+			Phase.EnemyCount, Percentile(Sorted, 0.5f), Percentile(Sorted, 0.99f), Mean(Phase.GameThreadMs),
+			Phase.GCCount, Phase.GCMaxMs, ToMB(Phase.UsedPhysicalHighWater));
+	}
+
+	if (Phases.Num() > 0)
+	{
+		if (WriteCsv())
+		{
+			UE_LOG(LogCPPd1, Display, TEXT("CombatBenchmark: results appended to %s"), *Settings.OutputPath);
+		}
+		else
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("CombatBenchmark: failed to write %s"), *Settings.OutputPath);
+		}
+	}
+
+	if (Settings.bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("CombatBenchmark"));
+	}
+}
+
+void UCombatBenchmark::ClearEnemies()
+{
+	for (TActorIterator<ACombatEnemy> It(GetWorld()); It; ++It)
+	{
+		It->Destroy();
+	}
+}
+
+void UCombatBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (State == EState::Idle)
+	{
+		return;
+	}
+
+	StateTime += DeltaTime;
+	UpdateBots(DeltaTime);
+
+	switch (State)
+	{
+	case EState::Spawning:
+	{
+		const ACombatWaveSpawner* WaveSpawner = Spawner.Get();
+		if (!WaveSpawner || !WaveSpawner->IsSpawningWave() || StateTime >= MaxSpawnSeconds)
+		{
+			State = EState::Warmup;
+			StateTime = 0.0f;
+		}
+		break;
+	}
+
+	case EState::Warmup:
+		if (StateTime >= Settings.WarmupSeconds)
+		{
+			State = EState::Measuring;
+			StateTime = 0.0f;
+		}
+		break;
+
+	case EState::Measuring:
+		if (StateTime >= Settings.PhaseSeconds)
+		{
+			EndPhase();
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UCombatBenchmark::UpdateBots(float DeltaTime)
+{
+	BotAttackCooldown -= DeltaTime;
+	const bool bAttack = BotAttackCooldown <= 0.0f;
+	if (bAttack)
+	{
+		BotAttackCooldown = Settings.BotAttackInterval;
+	}
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		ACombatCharacter* Character = PC ? Cast<ACombatCharacter>(PC->GetPawn()) : nullptr;
+		if (!Character || Character->GetCurrentHP() <= 0.0f)
+		{
+			continue;
+		}
+
+		// lock-on turns the control rotation toward the target, so walking forward closes in
+		if (bAttack)
+		{
+			Character->DoLockOn();
+			Character->DoComboAttackStart();
+			Character->DoComboAttackEnd();
+		}
+
+		const AActor* Target = Character->GetLockOnTarget();
+		if (Target && FVector::DistSquared(Target->GetActorLocation(), Character->GetActorLocation()) > FMath::Square(BotStopDistance))
+		{
+			Character->DoMove(0.0f, 1.0f);
+		}
+	}
+}
+
+void UCombatBenchmark::BindTimingDelegates()
+{
+	FrameStartTime = LastFrameStartTime = FPlatformTime::Seconds();
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UCombatBenchmark::HandleBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UCombatBenchmark::HandleEndFrame);
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UCombatBenchmark::HandlePreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UCombatBenchmark::HandlePostGarbageCollect);
+}
+
+void UCombatBenchmark::UnbindTimingDelegates()
+{
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+	BeginFrameHandle.Reset();
+	EndFrameHandle.Reset();
+	PreGCHandle.Reset();
+	PostGCHandle.Reset();
+}
+
+void UCombatBenchmark::HandleBeginFrame()
+{
+	LastFrameStartTime = FrameStartTime;
+	FrameStartTime = FPlatformTime::Seconds();
+
+	if (State == EState::Measuring)
+	{
+		Phases.Last().FrameMs.Add(float((FrameStartTime - LastFrameStartTime) * 1000.0));
+	}
+}
+
+void UCombatBenchmark::HandleEndFrame()
+{
+	if (State != EState::Measuring)
+	{
+		return;
+	}
+
+	// the engine's own game-thread time, which leaves out the frame limiter and idle waits
+	const double Now = FPlatformTime::Seconds();
+	FCombatBenchmarkPhase& Phase = Phases.Last();
+	Phase.GameThreadMs.Add(float(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+	if (Now >= NextMemorySampleTime)
+	{
+		NextMemorySampleTime = Now + MemorySampleInterval;
+		Phase.UsedPhysicalHighWater = FMath::Max<uint64>(Phase.UsedPhysicalHighWater, FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+void UCombatBenchmark::HandlePreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void UCombatBenchmark::HandlePostGarbageCollect()
+{
+	if (State != EState::Measuring || GCStartTime <= 0.0)
+	{
+		return;
+	}
+
+	const double PauseMs = (FPlatformTime::Seconds() - GCStartTime) * 1000.0;
+	GCStartTime = 0.0;
+
+	FCombatBenchmarkPhase& Phase = Phases.Last();
+	++Phase.GCCount;
+	Phase.GCTotalMs += PauseMs;
+	Phase.GCMaxMs = FMath::Max(Phase.GCMaxMs, PauseMs);
+}
+
+bool UCombatBenchmark::WriteCsv() const
+{
+	// one row per phase; the run and build columns keep rows from different builds comparable
+	const FString RunId = FDateTime::UtcNow().ToIso8601();
+	const FString Build = FString::Printf(TEXT("%s-%s-CL%u"), FApp::GetBuildVersion(), LexToString(FApp::GetBuildConfiguration()), FEngineVersion::Current().GetChangelist());
+	const FString MapName = GetWorld()->GetMapName();
+
+	FString Csv;
+	if (!FPaths::FileExists(Settings.OutputPath))
+	{
+		Csv += TEXT("RunId,Build,Platform,Map,EnemyCount,EnemiesAliveAtEnd,Frames,FrameMsMean,FrameMsP50,FrameMsP90,FrameMsP99,FrameMsMax,GameThreadMsMean,GameThreadMsP50,GameThreadMsP90,GameThreadMsP99,GCCount,GCMsTotal,GCMsMax,UsedPhysicalMBHighWater,ProcessPeakPhysicalMB");
+		Csv += LINE_TERMINATOR;
+	}
+
+	for (const FCombatBenchmarkPhase& Phase : Phases)
+	{
+		TArray<float> Frame = Phase.FrameMs;
+		TArray<float> GameThread = Phase.GameThreadMs;
+		Frame.Sort();
+		GameThread.Sort();
+
+		Csv += FString::Printf(TEXT("%s,%s,%s,%s,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%.3f,%.3f,%.1f,%.1f"),
+			*RunId, *Build, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), *MapName,
+			Phase.EnemyCount, Phase.EnemiesAliveAtEnd, Frame.Num(),
+			Mean(Frame), Percentile(Frame, 0.5f), Percentile(Frame, 0.9f), Percentile(Frame, 0.99f), Frame.Num() > 0 ? Frame.Last() : 0.0f,
+			Mean(GameThread), Percentile(GameThread, 0.5f), Percentile(GameThread, 0.9f), Percentile(GameThread, 0.99f),
+			Phase.GCCount, Phase.GCTotalMs, Phase.GCMaxMs,
+			ToMB(Phase.UsedPhysicalHighWater), ToMB(Phase.ProcessPeakPhysical));
+		Csv += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Settings.OutputPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatBenchmark.generated.h"
+
+class ACombatWaveSpawner;
+
+/** Settings for one benchmark run */
+struct FCombatBenchmarkSettings
+{
+	/** Enemies spawned per phase, in order */
+	TArray<int32> EnemyCounts = { 10, 50, 200, 500 };
+
+	/** Seconds measured per phase, after spawning and warmup */
+	float PhaseSeconds = 20.0f;
+
+	/** Seconds between the last spawn and the start of measuring */
+	float WarmupSeconds = 3.0f;
+
+	/** Seconds between enemy spawns while filling a phase */
+	float SpawnInterval = 0.02f;
+
+	/** Seconds between bot attacks */
+	float BotAttackInterval = 0.6f;
+
+	/** CSV the results are appended to */
+	FString OutputPath;
+
+	/** Quit the game once the last phase is written */
+	bool bQuitWhenDone = false;
+};
+
+/** Raw samples and aggregates for one phase */
+struct FCombatBenchmarkPhase
+{
+	int32 EnemyCount = 0;
+	int32 EnemiesAliveAtEnd = 0;
+
+	TArray<float> FrameMs;
+	TArray<float> GameThreadMs;
+
+	int32 GCCount = 0;
+	double GCTotalMs = 0.0;
+	double GCMaxMs = 0.0;
+
+	uint64 UsedPhysicalHighWater = 0;
+	uint64 ProcessPeakPhysical = 0;
+};
+
+/**
+ * Repeatable wave-combat benchmark.
+ * Fills the level's first ACombatWaveSpawner with scripted waves of increasing size, drives the local players
+ * as bots (lock on, walk in, attack), and measures each phase: frame and game-thread time percentiles,
+ * GC pauses and memory high-water marks. Results are appended to a CSV with the build and map,
+ * so runs from different builds land side by side.
+ *
+ * Console:      Combat.Benchmark [Counts=10,50,200,500] [Phase=20] [Warmup=3] [Out=Saved/Benchmarks/CombatBenchmark.csv] [Quit]
+ * Command line: UnrealEditor CPPd1.uproject /Game/Maps/Arena -game -nullrhi -unattended -CombatBenchmark [-CombatBenchmarkCounts=10,50] [-CombatBenchmarkOut=...]
+ *               (the command line run quits when done)
+ */
+UCLASS()
+class CPPd1_API UCombatBenchmark : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Start a run. Fails (and logs) if the level has no wave spawner */
+	bool StartBenchmark(const FCombatBenchmarkSettings& InSettings);
+
+	/** Abort the current run; finished phases are still written */
+	void StopBenchmark();
+
+	bool IsRunning() const { return State != EState::Idle; }
+
+	/** Parse Counts/Phase/Warmup/Out from a console or command line string. Prefix is prepended to every key */
+	static void ParseSettings(const TCHAR* Stream, const TCHAR* Prefix, FCombatBenchmarkSettings& OutSettings);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	enum class EState : uint8
+	{
+		Idle,
+		Spawning,
+		Warmup,
+		Measuring
+	};
+
+	EState State = EState::Idle;
+	FCombatBenchmarkSettings Settings;
+
+	/** Spawner driven by the run */
+	TWeakObjectPtr<ACombatWaveSpawner> Spawner;
+
+	/** Finished phases plus the one in progress */
+	TArray<FCombatBenchmarkPhase> Phases;
+
+	/** Game time spent in the current state */
+	float StateTime = 0.0f;
+
+	/** Game time until the bots attack again */
+	float BotAttackCooldown = 0.0f;
+
+	/** Frame timing, taken from the engine's begin/end frame callbacks */
+	double FrameStartTime = 0.0;
+	double LastFrameStartTime = 0.0;
+	double NextMemorySampleTime = 0.0;
+	double GCStartTime = 0.0;
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+
+	/** Clear the arena and start spawning the next phase's enemies */
+	void StartPhase(int32 PhaseIndex);
+
+	/** Close the current phase and move on, or finish */
+	void EndPhase();
+
+	/** Write the CSV, log a summary, and quit if asked */
+	void FinishBenchmark();
+
+	/** Destroy every enemy in the world */
+	void ClearEnemies();
+
+	/** Lock on, walk in and attack with every local combat character */
+	void UpdateBots(float DeltaTime);
+
+	void HandleBeginFrame();
+	void HandleEndFrame();
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+
+	void BindTimingDelegates();
+	void UnbindTimingDelegates();
+
+	/** Append all phases to the output CSV (header only for a new file) */
+	bool WriteCsv() const;
+};
@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatHitchDetector.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarHitchDetector(
+		TEXT("Combat.HitchDetector"),
+		1,
+		TEXT("Record combat events and write a report when a frame runs over Combat.HitchThresholdMs (0 = off)"));
+
+	TAutoConsoleVariable<float> CVarHitchThresholdMs(
+		TEXT("Combat.HitchThresholdMs"),
+		50.0f,
+		TEXT("Frames longer than this are written to Saved/Profiling/CombatHitches-<session>.txt"));
+
+	TAutoConsoleVariable<float> CVarHitchWindowSeconds(
+		TEXT("Combat.HitchWindowSeconds"),
+		5.0f,
+		TEXT("Seconds of combat events written with each hitch report"));
+
+	/** Reports written per world before the detector goes quiet */
+	const int32 MaxReports = 100;
+
+	void RunHitchDumpCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UCombatHitchDetector* Detector = World ? World->GetSubsystem<UCombatHitchDetector>() : nullptr)
+		{
+			Detector->WriteReport(TEXT("Manual dump"));
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CombatHitchDumpCommand(
+		TEXT("Combat.HitchDump"),
+		TEXT("Writes the hitch detector's last frame timings and combat events to the hitch file now"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunHitchDumpCommand));
+}
+
+bool UCombatHitchDetector::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatHitchDetector::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Events.SetNum(EventCapacity);
+	ReportPath = FPaths::ProfilingDir() / FString::Printf(TEXT("CombatHitches-%s.txt"), *FDateTime::Now().ToString());
+
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UCombatHitchDetector::HandleBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UCombatHitchDetector::HandleEndFrame);
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UCombatHitchDetector::HandlePreGC);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UCombatHitchDetector::HandlePostGC);
+}
+
+void UCombatHitchDetector::Deinitialize()
+{
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Super::Deinitialize();
+}
+
+void UCombatHitchDetector::RecordEvent(const UObject* WorldContextObject, ECombatHitchEvent Event, const UObject* Subject, float Value)
+{
+	if (!CVarHitchDetector.GetValueOnGameThread() || !IsInGameThread())
+	{
+		return;
+	}
+
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (UCombatHitchDetector* Detector = World ? World->GetSubsystem<UCombatHitchDetector>() : nullptr)
+	{
+		Detector->AddEvent(Event, Subject ? Subject->GetFName() : NAME_None, Value);
+	}
+}
+
+void UCombatHitchDetector::AddEvent(ECombatHitchEvent Event, FName Subject, float Value)
+{
+	FEventRecord& Record = Events[NextEvent];
+	Record.Time = FPlatformTime::Seconds();
+	Record.Frame = GFrameCounter;
+	Record.Event = Event;
+	Record.Subject = Subject;
+	Record.Value = Value;
+
+	NextEvent = (NextEvent + 1) % EventCapacity;
+	NumEvents = FMath::Min(NumEvents + 1, EventCapacity);
+}
+
+void UCombatHitchDetector::HandleBeginFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (FrameStartTime > 0.0 && !bSkipNextFrame)
+	{
+		LastFrameMs = (Now - FrameStartTime) * 1000.0;
+
+		// loading and the first frames of a map hitch by design
+		const UWorld* World = GetWorld();
+		if (CVarHitchDetector.GetValueOnGameThread() && World && World->HasBegunPlay()
+			&& LastFrameMs > CVarHitchThresholdMs.GetValueOnGameThread() && ReportsWritten < MaxReports)
+		{
+			WriteReport(TEXT("Hitch"));
+			++ReportsWritten;
+			bSkipNextFrame = true;
+		}
+	}
+	else
+	{
+		bSkipNextFrame = false;
+	}
+
+	FrameStartTime = Now;
+	FrameGCSeconds = 0.0;
+	FCombatSystemTimer::ResetFrame();
+}
+
+void UCombatHitchDetector::HandleEndFrame()
+{
+	LastGameThreadMs = (FPlatformTime::Seconds() - FrameStartTime) * 1000.0;
+	LastFrameGCMs = FrameGCSeconds * 1000.0;
+	FMemory::Memcpy(LastFrameSystemCycles, FCombatSystemTimer::FrameCycles, sizeof(LastFrameSystemCycles));
+}
+
+void UCombatHitchDetector::HandlePreGC()
+{
+	GCStartTime = FPlatformTime::Seconds();
+	AddEvent(ECombatHitchEvent::GCStarted, NAME_None, 0.0f);
+}
+
+void UCombatHitchDetector::HandlePostGC()
+{
+	const double Seconds = FPlatformTime::Seconds() - GCStartTime;
+	FrameGCSeconds += Seconds;
+	AddEvent(ECombatHitchEvent::GCFinished, NAME_None, float(Seconds * 1000.0));
+}
+
+void UCombatHitchDetector::WriteReport(const TCHAR* Reason)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double WindowSeconds = CVarHitchWindowSeconds.GetValueOnGameThread();
+
+	FString Report = FString::Printf(TEXT("=== %s at %s, frame %llu, map %s"),
+		Reason, *FDateTime::Now().ToString(), GFrameCounter, *GetWorld()->GetMapName());
+	Report += LINE_TERMINATOR;
+
+	Report += FString::Printf(TEXT("Frame %.2f ms (threshold %.0f ms), game thread %.2f ms, GC %.2f ms"),
+		LastFrameMs, CVarHitchThresholdMs.GetValueOnGameThread(), LastGameThreadMs, LastFrameGCMs);
+	Report += LINE_TERMINATOR;
+
+	Report += TEXT("Systems (ms):");
+	for (int32 System = 0; System < (int32)ECombatTimedSystem::Count; ++System)
+	{
+		Report += FString::Printf(TEXT(" %s=%.3f"), FCombatSystemTimer::GetName(ECombatTimedSystem(System)), FPlatformTime::ToMilliseconds64(LastFrameSystemCycles[System]));
+	}
+	Report += LINE_TERMINATOR;
+
+	Report += FString::Printf(TEXT("Events (last %.1f s, oldest first; seconds before the report):"), WindowSeconds);
+	Report += LINE_TERMINATOR;
+
+	int32 EventsWritten = 0;
+	for (int32 Offset = NumEvents; Offset > 0; --Offset)
+	{
+		const FEventRecord& Record = Events[(NextEvent - Offset + EventCapacity) % EventCapacity];
+		if (Now - Record.Time > WindowSeconds)
+		{
+			continue;
+		}
+
+		Report += FString::Printf(TEXT("  %8.3f  frame %-8llu %-16s %-32s %.2f"),
+			Record.Time - Now, Record.Frame, GetEventName(Record.Event), *Record.Subject.ToString(), Record.Value);
+		Report += LINE_TERMINATOR;
+		++EventsWritten;
+	}
+	Report += LINE_TERMINATOR;
+
+	FFileHelper::SaveStringToFile(Report, *ReportPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	UE_LOG(LogCPPd1, Warning, TEXT("CombatHitchDetector: %s, %.1f ms frame, %d events written to %s"), Reason, LastFrameMs, EventsWritten, *ReportPath);
+}
+
+const TCHAR* UCombatHitchDetector::GetEventName(ECombatHitchEvent Event)
+{
+	switch (Event)
+	{
+	case ECombatHitchEvent::EnemySpawned:		return TEXT("EnemySpawned");
+	case ECombatHitchEvent::EnemyDied:			return TEXT("EnemyDied");
+	case ECombatHitchEvent::EnemyRemoved:		return TEXT("EnemyRemoved");
+	case ECombatHitchEvent::PlayerDied:			return TEXT("PlayerDied");
+	case ECombatHitchEvent::PlayerRespawned:	return TEXT("PlayerRespawned");
+	case ECombatHitchEvent::RagdollOn:			return TEXT("RagdollOn");
+	case ECombatHitchEvent::RagdollOff:			return TEXT("RagdollOff");
+	case ECombatHitchEvent::WaveStarted:		return TEXT("WaveStarted");
+	case ECombatHitchEvent::WidgetCreated:		return TEXT("WidgetCreated");
+	case ECombatHitchEvent::GCStarted:			return TEXT("GCStarted");
+	case ECombatHitchEvent::GCFinished:			return TEXT("GCFinished");
+	default:									return TEXT("Unknown");
+	}
+}
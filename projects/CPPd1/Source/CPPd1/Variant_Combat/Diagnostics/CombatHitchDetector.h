@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatHitchDetector.generated.h"
+
+/** Combat events kept in the hitch detector's ring buffer */
+enum class ECombatHitchEvent : uint8
+{
+	EnemySpawned,
+	EnemyDied,
+	EnemyRemoved,
+	PlayerDied,
+	PlayerRespawned,
+	RagdollOn,
+	RagdollOff,
+	WaveStarted,
+	WidgetCreated,
+	GCStarted,
+	GCFinished,
+	Count
+};
+
+/**
+ * Always-on hitch detector.
+ * Keeps the last few seconds of combat events (spawns, deaths, ragdolls, wave starts, widget creation, GC) in a
+ * fixed-size ring buffer, and times every frame plus the game-thread combat systems (COMBAT_SCOPE). When a frame
+ * runs over Combat.HitchThresholdMs, the frame's timings and the buffered events are appended to
+ * Saved/Profiling/CombatHitches-<session>.txt.
+ *
+ * CVars: Combat.HitchDetector (0/1), Combat.HitchThresholdMs, Combat.HitchWindowSeconds
+ * Console: Combat.HitchDump writes the buffer now, without a hitch
+ */
+UCLASS()
+class CPPd1_API UCombatHitchDetector : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Add an event to the world's ring buffer. Subject is named in the report; Value is event specific (wave index, GC ms) */
+	static void RecordEvent(const UObject* WorldContextObject, ECombatHitchEvent Event, const UObject* Subject = nullptr, float Value = 0.0f);
+
+	void AddEvent(ECombatHitchEvent Event, FName Subject, float Value);
+
+	/** Append a report for the last frame to the hitch file. Reason is written in the header */
+	void WriteReport(const TCHAR* Reason);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	struct FEventRecord
+	{
+		double Time = 0.0;
+		uint64 Frame = 0;
+		ECombatHitchEvent Event = ECombatHitchEvent::EnemySpawned;
+		FName Subject;
+		float Value = 0.0f;
+	};
+
+	/** Ring buffer: fixed size, oldest overwritten */
+	static constexpr int32 EventCapacity = 1024;
+	TArray<FEventRecord> Events;
+	int32 NextEvent = 0;
+	int32 NumEvents = 0;
+
+	/** Timings of the last completed frame */
+	double FrameStartTime = 0.0;
+	double LastFrameMs = 0.0;
+	double LastGameThreadMs = 0.0;
+	double FrameGCSeconds = 0.0;
+	double LastFrameGCMs = 0.0;
+	uint64 LastFrameSystemCycles[(int32)ECombatTimedSystem::Count] = {};
+
+	double GCStartTime = 0.0;
+
+	/** Skip the frame after a report; writing it is part of that frame */
+	bool bSkipNextFrame = true;
+
+	/** Reports written this session; capped so a bad level can't fill the disk */
+	int32 ReportsWritten = 0;
+
+	FString ReportPath;
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+
+	void HandleBeginFrame();
+	void HandleEndFrame();
+	void HandlePreGC();
+	void HandlePostGC();
+
+	static const TCHAR* GetEventName(ECombatHitchEvent Event);
+};
@@ -0,0 +1,382 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatInputRecorder.h"
+#include "CombatCharacter.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** 'CBRC' */
+	const uint32 RecordingMagic = 0x43425243;
+	const uint16 RecordingVersion = 1;
+
+	/** Smallest a frame and an event can be on disk: delta plus a one-byte packed count, player plus input bytes */
+	const int64 MinFrameBytes = sizeof(float) + 1;
+	const int64 MinEventBytes = 2;
+
+	/** The command line applies to the first game world only; travel doesn't restart or overwrite it */
+	bool bCommandLineConsumed = false;
+
+	bool HasAxisValue(ECombatRecordedInput Input)
+	{
+		return Input == ECombatRecordedInput::Move || Input == ECombatRecordedInput::Look;
+	}
+
+	void RunRecordCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatInputRecorder* Recorder = World ? World->GetSubsystem<UCombatInputRecorder>() : nullptr;
+		if (Args.Num() > 0 && Args[0] == TEXT("Stop") && Recorder)
+		{
+			Recorder->StopRecording();
+			return;
+		}
+
+		UE_LOG(LogCPPd1, Display, TEXT("Combat.Record: start with -CombatRecord=<File> on the command line; Combat.Record Stop writes it early"));
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CombatRecordCommand(
+		TEXT("Combat.Record"),
+		TEXT("Combat.Record Stop writes the input recording started with -CombatRecord=<File>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunRecordCommand));
+}
+
+bool UCombatInputRecorder::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatInputRecorder::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// actors pull their seeds in BeginPlay, so the seed is settled here
+	SessionSeed = int32(FPlatformTime::Cycles());
+	FParse::Value(FCommandLine::Get(), TEXT("CombatSeed="), SessionSeed);
+
+	if (!bCommandLineConsumed)
+	{
+		if (FParse::Value(FCommandLine::Get(), TEXT("CombatReplay="), Filename))
+		{
+			bCommandLineConsumed = true;
+			StartReplay();
+		}
+		else if (FParse::Value(FCommandLine::Get(), TEXT("CombatRecord="), Filename))
+		{
+			bCommandLineConsumed = true;
+			Mode = EMode::Recording;
+			UE_LOG(LogCPPd1, Display, TEXT("CombatInputRecorder: recording to %s (seed %d)"), *Filename, SessionSeed);
+		}
+	}
+
+	SeedStream.Initialize(SessionSeed);
+
+	if (Mode != EMode::Idle)
+	{
+		WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UCombatInputRecorder::HandleWorldTickStart);
+	}
+}
+
+void UCombatInputRecorder::Deinitialize()
+{
+	if (IsRecording())
+	{
+		StopRecording();
+	}
+	else if (IsReplaying())
+	{
+		FinishReplay();
+	}
+
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	WorldTickStartHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+int32 UCombatInputRecorder::MakeRandomSeed(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UCombatInputRecorder* Recorder = World ? World->GetSubsystem<UCombatInputRecorder>() : nullptr;
+	return Recorder ? int32(Recorder->SeedStream.GetUnsignedInt()) : FMath::Rand();
+}
+
+void UCombatInputRecorder::RecordInput(const APawn* Pawn, ECombatRecordedInput Input, const FVector2D& Value)
+{
+	if (!IsRecording() || Frames.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 PlayerIndex = GetPlayerIndex(Pawn);
+	if (PlayerIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FRecordedEvent& Event = Events.AddDefaulted_GetRef();
+	Event.PlayerIndex = uint8(PlayerIndex);
+	Event.Input = Input;
+	Event.Value = FVector2f(Value);
+	++Frames.Last().NumEvents;
+}
+
+bool UCombatInputRecorder::StopRecording()
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+
+	Mode = EMode::Idle;
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	WorldTickStartHandle.Reset();
+
+	if (!Save())
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatInputRecorder: failed to write %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogCPPd1, Display, TEXT("CombatInputRecorder: wrote %d frames, %d inputs to %s"), Frames.Num(), Events.Num(), *Filename);
+	return true;
+}
+
+void UCombatInputRecorder::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	if (IsRecording())
+	{
+		// inputs processed during this tick land in this frame
+		FRecordedFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.DeltaSeconds = DeltaSeconds;
+		Frame.FirstEvent = Events.Num();
+		return;
+	}
+
+	if (!IsReplaying())
+	{
+		return;
+	}
+
+	if (!Frames.IsValidIndex(ReplayFrame))
+	{
+		FinishReplay();
+		return;
+	}
+
+	// feed this frame's inputs before anything ticks, the same point live input is consumed from
+	const FRecordedFrame& Frame = Frames[ReplayFrame];
+	for (int32 EventIndex = Frame.FirstEvent; EventIndex < Frame.FirstEvent + Frame.NumEvents; ++EventIndex)
+	{
+		const FRecordedEvent& Event = Events[EventIndex];
+		if (ACombatCharacter* Character = Cast<ACombatCharacter>(FindPlayerPawn(Event.PlayerIndex)))
+		{
+			Character->DispatchRecordedInput(Event.Input, FVector2D(Event.Value));
+		}
+	}
+
+	// the engine reads the fixed delta when it starts the next frame
+	++ReplayFrame;
+	if (Frames.IsValidIndex(ReplayFrame))
+	{
+		FApp::SetFixedDeltaTime(Frames[ReplayFrame].DeltaSeconds);
+	}
+}
+
+void UCombatInputRecorder::StartReplay()
+{
+	if (!Load())
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatInputRecorder: could not read %s"), *Filename);
+		return;
+	}
+
+	Mode = EMode::Replaying;
+	ReplayFrame = 0;
+
+	// recorded deltas, no frame-rate limit: runs as fast as the machine allows
+	bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	if (Frames.Num() > 0)
+	{
+		FApp::SetFixedDeltaTime(Frames[0].DeltaSeconds);
+	}
+
+	UE_LOG(LogCPPd1, Display, TEXT("CombatInputRecorder: replaying %d frames, %d inputs from %s (seed %d)"), Frames.Num(), Events.Num(), *Filename, SessionSeed);
+}
+
+void UCombatInputRecorder::FinishReplay()
+{
+	if (!IsReplaying())
+	{
+		return;
+	}
+
+	Mode = EMode::Idle;
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	UE_LOG(LogCPPd1, Display, TEXT("CombatInputRecorder: replay finished after %d frames"), ReplayFrame);
+
+	if (FApp::IsUnattended())
+	{
+		FPlatformMisc::RequestExit(false, TEXT("CombatInputRecorder"));
+	}
+}
+
+int32 UCombatInputRecorder::GetPlayerIndex(const APawn* Pawn)
+{
+	const APlayerController* PC = Pawn ? Cast<APlayerController>(Pawn->GetController()) : nullptr;
+	const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : INDEX_NONE;
+}
+
+APawn* UCombatInputRecorder::FindPlayerPawn(int32 PlayerIndex) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+		if (LocalPlayer && LocalPlayer->GetLocalPlayerIndex() == PlayerIndex)
+		{
+			return PC->GetPawn();
+		}
+	}
+	return nullptr;
+}
+
+bool UCombatInputRecorder::Save() const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = RecordingMagic;
+	uint16 Version = RecordingVersion;
+	int32 Seed = SessionSeed;
+	FString MapName = GetWorld()->GetMapName();
+	uint32 NumFrames = Frames.Num();
+	Writer << Magic << Version << Seed << MapName;
+	Writer.SerializeIntPacked(NumFrames);
+
+	// per frame: delta, packed event count, then player/input bytes and axis values only where the input has one
+	for (const FRecordedFrame& Frame : Frames)
+	{
+		float DeltaSeconds = Frame.DeltaSeconds;
+		uint32 NumEvents = Frame.NumEvents;
+		Writer << DeltaSeconds;
+		Writer.SerializeIntPacked(NumEvents);
+
+		for (int32 EventIndex = Frame.FirstEvent; EventIndex < Frame.FirstEvent + Frame.NumEvents; ++EventIndex)
+		{
+			FRecordedEvent Event = Events[EventIndex];
+			uint8 InputByte = uint8(Event.Input);
+			Writer << Event.PlayerIndex << InputByte;
+			if (HasAxisValue(Event.Input))
+			{
+				Writer << Event.Value.X << Event.Value.Y;
+			}
+		}
+	}
+
+	const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Filename);
+	return FFileHelper::SaveArrayToFile(Bytes, *FullPath);
+}
+
+bool UCombatInputRecorder::Load()
+{
+	TArray<uint8> Bytes;
+	const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Filename);
+	if (!FFileHelper::LoadFileToArray(Bytes, *FullPath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	FString MapName;
+	uint32 NumFrames = 0;
+	Reader << Magic << Version;
+	if (Magic != RecordingMagic || Version != RecordingVersion)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatInputRecorder: %s is not a version %d recording"), *Filename, RecordingVersion);
+		return false;
+	}
+
+	Reader << SessionSeed << MapName;
+	Reader.SerializeIntPacked(NumFrames);
+
+	// a truncated or corrupt count would otherwise reserve gigabytes before the first read fails
+	if (Reader.IsError() || NumFrames > (Reader.TotalSize() - Reader.Tell()) / MinFrameBytes)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatInputRecorder: %s is truncated or corrupt"), *Filename);
+		return false;
+	}
+
+	if (MapName != GetWorld()->GetMapName())
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("CombatInputRecorder: recorded on %s, replaying on %s"), *MapName, *GetWorld()->GetMapName());
+	}
+
+	Frames.Reset(NumFrames);
+	Events.Reset();
+	for (uint32 FrameIndex = 0; FrameIndex < NumFrames && !Reader.IsError(); ++FrameIndex)
+	{
+		FRecordedFrame& Frame = Frames.AddDefaulted_GetRef();
+		uint32 NumEvents = 0;
+		Reader << Frame.DeltaSeconds;
+		Reader.SerializeIntPacked(NumEvents);
+		if (NumEvents > (Reader.TotalSize() - Reader.Tell()) / MinEventBytes)
+		{
+			Reader.SetError();
+			break;
+		}
+
+		Frame.FirstEvent = Events.Num();
+		Frame.NumEvents = NumEvents;
+
+		for (uint32 EventIndex = 0; EventIndex < NumEvents && !Reader.IsError(); ++EventIndex)
+		{
+			FRecordedEvent& Event = Events.AddDefaulted_GetRef();
+			uint8 InputByte = 0;
+			Reader << Event.PlayerIndex << InputByte;
+			if (InputByte >= uint8(ECombatRecordedInput::Count))
+			{
+				Reader.SetError();
+				break;
+			}
+
+			Event.Input = ECombatRecordedInput(InputByte);
+			if (HasAxisValue(Event.Input))
+			{
+				Reader << Event.Value.X << Event.Value.Y;
+			}
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatInputRecorder: %s is truncated or corrupt"), *Filename);
+		Frames.Reset();
+		Events.Reset();
+		return false;
+	}
+
+	return true;
+}
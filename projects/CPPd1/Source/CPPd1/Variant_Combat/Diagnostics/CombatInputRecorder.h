@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Math/RandomStream.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatInputRecorder.generated.h"
+
+class APawn;
+
+/** Player inputs the recorder captures. Values are written to disk: only append */
+enum class ECombatRecordedInput : uint8
+{
+	Move,
+	Look,
+	ComboAttack,
+	ChargedAttackStart,
+	ChargedAttackEnd,
+	LockOn,
+	Roll,
+	Backflip,
+	Frontflip,
+	SideflipLeft,
+	SideflipRight,
+	Flip360,
+	Kick,
+	ToggleFlight,
+	Count
+};
+
+/**
+ * Records every local player's Enhanced Input actions per frame, together with the frame deltas and the session
+ * random seed, into a compact binary file, and replays them at a fixed timestep as fast as the machine can run.
+ * Combat randomness (enemy combo/charge rolls, wave spawn offsets) comes from per-actor streams seeded through
+ * MakeRandomSeed, so a replay of the same map reproduces the same fight.
+ *
+ * Record: -CombatRecord=Saved/Replays/Fight.cbrec      (written when the world ends, or on Combat.Record Stop)
+ * Replay: -game -nullrhi -unattended -CombatReplay=Saved/Replays/Fight.cbrec   (quits when done when unattended)
+ * Both start with the first game world, so recordings cover a fight from map load.
+ */
+UCLASS()
+class CPPd1_API UCombatInputRecorder : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Add an input to the current frame. Ignored unless recording */
+	void RecordInput(const APawn* Pawn, ECombatRecordedInput Input, const FVector2D& Value);
+
+	/** Write the recording and stop. Returns false if nothing was recording or the write failed */
+	bool StopRecording();
+
+	bool IsRecording() const { return Mode == EMode::Recording; }
+	bool IsReplaying() const { return Mode == EMode::Replaying; }
+
+	/** Seed for a per-actor random stream; drawn from the session seed, so the same spawn order gets the same seeds */
+	static int32 MakeRandomSeed(const UObject* WorldContextObject);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	enum class EMode : uint8
+	{
+		Idle,
+		Recording,
+		Replaying
+	};
+
+	struct FRecordedEvent
+	{
+		uint8 PlayerIndex = 0;
+		ECombatRecordedInput Input = ECombatRecordedInput::Move;
+		FVector2f Value = FVector2f::ZeroVector;
+	};
+
+	struct FRecordedFrame
+	{
+		float DeltaSeconds = 0.0f;
+		int32 FirstEvent = 0;
+		int32 NumEvents = 0;
+	};
+
+	EMode Mode = EMode::Idle;
+
+	/** Seeds every per-actor stream handed out by MakeRandomSeed */
+	int32 SessionSeed = 0;
+	FRandomStream SeedStream;
+
+	/** Frames index into the flat event list */
+	TArray<FRecordedFrame> Frames;
+	TArray<FRecordedEvent> Events;
+
+	/** Replay position */
+	int32 ReplayFrame = 0;
+
+	/** File being recorded to or replayed from */
+	FString Filename;
+
+	/** Fixed-timestep settings to restore after a replay */
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	FDelegateHandle WorldTickStartHandle;
+
+	/** Start of every world tick: opens a recorded frame, or feeds a replayed one */
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void StartReplay();
+	void FinishReplay();
+
+	/** Local player index of the pawn's controller, or INDEX_NONE */
+	static int32 GetPlayerIndex(const APawn* Pawn);
+
+	/** Pawn controlled by the given local player */
+	APawn* FindPlayerPawn(int32 PlayerIndex) const;
+
+	bool Save() const;
+	bool Load();
+};
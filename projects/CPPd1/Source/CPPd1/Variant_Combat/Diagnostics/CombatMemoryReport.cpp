@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatMemoryReport.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/StateTreeComponent.h"
+#include "Components/WidgetComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "ProceduralMeshComponent.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	/** Native classes from this module are reported by package */
+	const TCHAR* ModulePackageName = TEXT("/Script/CPPd1");
+
+	double ToKB(uint64 Bytes)
+	{
+		return double(Bytes) / 1024.0;
+	}
+
+	void RunMemReportCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		TArray<FCombatMemoryReportRow> Rows;
+		FCombatMemoryReport::Gather(World, Rows);
+		FCombatMemoryReport::Print(Rows, Ar);
+
+		if (Args.Contains(TEXT("Csv")))
+		{
+			const FString Path = FCombatMemoryReport::WriteCsv(World, Rows);
+			if (Path.IsEmpty())
+			{
+				Ar.Logf(TEXT("Combat.MemReport: failed to write the CSV"));
+			}
+			else
+			{
+				Ar.Logf(TEXT("Combat.MemReport: wrote %s"), *Path);
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice CombatMemReportCommand(
+		TEXT("Combat.MemReport"),
+		TEXT("Per-class instance counts and resident memory for combat content. Combat.MemReport Csv also writes Saved/Profiling/CombatMemReport-<time>.csv"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunMemReportCommand));
+}
+
+bool FCombatMemoryReport::IsCombatClass(const UClass* Class)
+{
+	// engine classes the combat content is built from
+	if (Class->IsChildOf<UProceduralMeshComponent>() || Class->IsChildOf<UWidgetComponent>()
+		|| Class->IsChildOf<UStateTreeComponent>() || Class->IsChildOf<UUserWidget>())
+	{
+		return true;
+	}
+
+	// anything from this module, including Blueprints derived from it
+	for (const UClass* Native = Class; Native; Native = Native->GetSuperClass())
+	{
+		if (Native->HasAnyClassFlags(CLASS_Native))
+		{
+			return Native->GetOutermost()->GetFName() == FName(ModulePackageName);
+		}
+	}
+	return false;
+}
+
+void FCombatMemoryReport::MeasureObject(UObject* Object, uint64& OutObjectBytes, uint64& OutPropertyHeapBytes, uint64& OutResourceBytes)
+{
+	OutObjectBytes = Object->GetClass()->GetStructureSize();
+
+	FArchiveCountMem CountMem(Object);
+	OutPropertyHeapBytes = CountMem.GetMax();
+
+	FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+	Object->GetResourceSizeEx(ResourceSize);
+	OutResourceBytes = ResourceSize.GetTotalMemoryBytes();
+}
+
+void FCombatMemoryReport::Gather(const UWorld* World, TArray<FCombatMemoryReportRow>& OutRows)
+{
+	OutRows.Reset();
+	if (!World)
+	{
+		return;
+	}
+
+	TMap<const UClass*, int32> RowIndices;
+
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		UObject* Object = *It;
+		if (!IsValid(Object) || Object->IsTemplate() || !IsCombatClass(Object->GetClass()) || Object->GetWorld() != World)
+		{
+			continue;
+		}
+
+		const int32* ExistingIndex = RowIndices.Find(Object->GetClass());
+		const int32 RowIndex = ExistingIndex ? *ExistingIndex : RowIndices.Add(Object->GetClass(), OutRows.AddDefaulted());
+		FCombatMemoryReportRow& Row = OutRows[RowIndex];
+		Row.Class = Object->GetClass();
+		++Row.Instances;
+
+		uint64 ObjectBytes, PropertyHeapBytes, ResourceBytes;
+		MeasureObject(Object, ObjectBytes, PropertyHeapBytes, ResourceBytes);
+		Row.ObjectBytes += ObjectBytes;
+		Row.PropertyHeapBytes += PropertyHeapBytes;
+		Row.ResourceBytes += ResourceBytes;
+
+		// the whole-actor cost is what a pool or a spawn budget pays per instance
+		if (const AActor* Actor = Cast<AActor>(Object))
+		{
+			Row.WithComponentsBytes += ObjectBytes + PropertyHeapBytes + ResourceBytes;
+			Actor->ForEachComponent(false, [&Row](UActorComponent* Component)
+			{
+				uint64 ComponentObjectBytes, ComponentHeapBytes, ComponentResourceBytes;
+				MeasureObject(Component, ComponentObjectBytes, ComponentHeapBytes, ComponentResourceBytes);
+				Row.WithComponentsBytes += ComponentObjectBytes + ComponentHeapBytes + ComponentResourceBytes;
+			});
+		}
+	}
+
+	OutRows.Sort([](const FCombatMemoryReportRow& A, const FCombatMemoryReportRow& B)
+	{
+		return FMath::Max(A.GetTotalBytes(), A.WithComponentsBytes) > FMath::Max(B.GetTotalBytes(), B.WithComponentsBytes);
+	});
+}
+
+void FCombatMemoryReport::Print(const TArray<FCombatMemoryReportRow>& Rows, FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("%-48s %6s %10s %10s %10s %10s %10s %12s"),
+		TEXT("Class"), TEXT("Count"), TEXT("ObjKB"), TEXT("HeapKB"), TEXT("ResKB"), TEXT("TotalKB"), TEXT("KB/Inst"), TEXT("Actor+CmpKB"));
+
+	uint64 GrandTotal = 0;
+	for (const FCombatMemoryReportRow& Row : Rows)
+	{
+		GrandTotal += Row.GetTotalBytes();
+
+		// components of an actor are listed on their own rows too, so the last column overlaps them
+		const FString WithComponents = Row.WithComponentsBytes > 0 ? FString::Printf(TEXT("%.1f"), ToKB(Row.WithComponentsBytes)) : FString(TEXT("-"));
+		Ar.Logf(TEXT("%-48s %6d %10.1f %10.1f %10.1f %10.1f %10.2f %12s"),
+			*Row.Class->GetName(), Row.Instances,
+			ToKB(Row.ObjectBytes), ToKB(Row.PropertyHeapBytes), ToKB(Row.ResourceBytes),
+			ToKB(Row.GetTotalBytes()), ToKB(Row.GetBytesPerInstance()), *WithComponents);
+	}
+
+	Ar.Logf(TEXT("%d classes, %.1f KB total (Actor+CmpKB overlaps the component rows)"), Rows.Num(), ToKB(GrandTotal));
+}
+
+FString FCombatMemoryReport::WriteCsv(const UWorld* World, const TArray<FCombatMemoryReportRow>& Rows)
+{
+	const FString Path = FPaths::ProfilingDir() / FString::Printf(TEXT("CombatMemReport-%s.csv"), *FDateTime::Now().ToString());
+
+	FString Csv = TEXT("Map,Class,Instances,ObjectBytes,PropertyHeapBytes,ResourceBytes,TotalBytes,BytesPerInstance,ActorWithComponentsBytes");
+	Csv += LINE_TERMINATOR;
+
+	const FString MapName = World ? World->GetMapName() : FString();
+	for (const FCombatMemoryReportRow& Row : Rows)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%llu,%llu,%llu,%llu,%llu,%llu"),
+			*MapName, *Row.Class->GetName(), Row.Instances,
+			Row.ObjectBytes, Row.PropertyHeapBytes, Row.ResourceBytes,
+			Row.GetTotalBytes(), Row.GetBytesPerInstance(), Row.WithComponentsBytes);
+		Csv += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Path) ? Path : FString();
+}
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+
+class UWorld;
+class FOutputDevice;
+
+/** Instance count and memory for one class in the report */
+struct FCombatMemoryReportRow
+{
+	/** Class the instances were grouped under (Blueprint classes are kept apart from their native parent) */
+	const UClass* Class = nullptr;
+
+	int32 Instances = 0;
+
+	/** UObject allocations: the class size of every instance */
+	uint64 ObjectBytes = 0;
+
+	/** Heap owned by the instances' properties (arrays, maps, strings), as counted by FArchiveCountMem */
+	uint64 PropertyHeapBytes = 0;
+
+	/** Exclusive resource size (render data, physics state, mesh sections) */
+	uint64 ResourceBytes = 0;
+
+	/** Actors only: totals for the actor plus every component it owns, engine components included */
+	uint64 WithComponentsBytes = 0;
+
+	uint64 GetTotalBytes() const { return ObjectBytes + PropertyHeapBytes + ResourceBytes; }
+	uint64 GetBytesPerInstance() const { return Instances > 0 ? GetTotalBytes() / Instances : 0; }
+};
+
+/**
+ * Per-class instance counts and resident memory for combat content in a world: every class from this module
+ * (enemies, characters, spawners, trick/skill systems, HUD widgets) plus the engine classes combat leans on
+ * (procedural meshes, widget components, StateTree components, user widgets).
+ * Console: Combat.MemReport [Csv]. Pair with "stat LLMFULL", which shows the Combat/* LLM tags.
+ */
+class CPPd1_API FCombatMemoryReport
+{
+public:
+
+	/** Gather rows for the given world, largest total first */
+	static void Gather(const UWorld* World, TArray<FCombatMemoryReportRow>& OutRows);
+
+	/** Print the rows as a table */
+	static void Print(const TArray<FCombatMemoryReportRow>& Rows, FOutputDevice& Ar);
+
+	/** Write the rows to a new timestamped CSV under Saved/Profiling. Returns the path, or an empty string on failure */
+	static FString WriteCsv(const UWorld* World, const TArray<FCombatMemoryReportRow>& Rows);
+
+protected:
+
+	/** True if instances of the class belong in the report */
+	static bool IsCombatClass(const UClass* Class);
+
+	/** Object, property heap and resource bytes for a single object */
+	static void MeasureObject(UObject* Object, uint64& OutObjectBytes, uint64& OutPropertyHeapBytes, uint64& OutResourceBytes);
+};
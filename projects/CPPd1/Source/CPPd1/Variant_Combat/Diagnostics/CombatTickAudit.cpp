@@ -0,0 +1,349 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTickAudit.h"
+#include "Components/ActorComponent.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Enabled ticks averaging less than this per call are reported as empty candidates (about the cost of dispatching an empty Tick) */
+	const double EmptyTickSeconds = 1.0e-6;
+
+	const int32 DefaultAuditFrames = 300;
+
+	/** Blueprint Tick event on both actors and components */
+	const FName ReceiveTickName(TEXT("ReceiveTick"));
+
+	void RunTickAuditCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatTickAudit* Audit = World ? World->GetSubsystem<UCombatTickAudit>() : nullptr;
+		if (!Audit)
+		{
+			UE_LOG(LogCPPd1, Warning, TEXT("Combat.TickAudit: only available in a game world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+		{
+			Audit->StopAudit();
+			return;
+		}
+
+		int32 Frames = DefaultAuditFrames;
+		FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("Frames="), Frames);
+		Audit->StartAudit(Frames, Args.Contains(TEXT("Csv")));
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CombatTickAuditCommand(
+		TEXT("Combat.TickAudit"),
+		TEXT("Times every actor and component tick function for N frames and reports them by class. ")
+		TEXT("A tick that gameplay turns off during the audit keeps ticking and is turned back on at the end. ")
+		TEXT("Combat.TickAudit [Frames=300] [Csv], or Combat.TickAudit Stop"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunTickAuditCommand));
+}
+
+void FCombatTickAuditProxy::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!Entry || !Entry->bDisabledByAudit || !IsValid(Entry->Owner.Get()) || !Entry->TickFunction->IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	// re-enabled by gameplay: the engine ticks it itself again, and it stays gameplay's even if turned off later
+	if (Entry->TickFunction->IsTickFunctionEnabled())
+	{
+		Entry->bDisabledByAudit = false;
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Entry->TickFunction->ExecuteTick(DeltaTime, TickType, CurrentThread, MyCompletionGraphEvent);
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	++Entry->Calls;
+	Entry->TotalSeconds += Seconds;
+	Entry->PeakSeconds = FMath::Max(Entry->PeakSeconds, Seconds);
+}
+
+FString FCombatTickAuditProxy::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("CombatTickAudit proxy for %s"), Entry && Entry->TickFunction ? *Entry->TickFunction->DiagnosticMessage() : TEXT("(none)"));
+}
+
+bool UCombatTickAudit::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatTickAudit::Deinitialize()
+{
+	if (bAuditing)
+	{
+		StopAudit();
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId UCombatTickAudit::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTickAudit, STATGROUP_Combat);
+}
+
+void UCombatTickAudit::StartAudit(int32 InFrames, bool bInWriteCsv)
+{
+	if (bAuditing)
+	{
+		UE_LOG(LogCPPd1, Warning, TEXT("Combat.TickAudit: already running (%d/%d frames)"), FramesAudited, FramesToAudit);
+		return;
+	}
+
+	bAuditing = true;
+	bWriteCsv = bInWriteCsv;
+	FramesToAudit = FMath::Max(1, InFrames);
+	FramesAudited = 0;
+	Entries.Reset();
+	Proxies.Reset();
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		AActor* Actor = *It;
+		AddEntry(Actor, Actor->PrimaryActorTick, Actor->GetLevel(), false);
+
+		Actor->ForEachComponent(false, [this, Actor](UActorComponent* Component)
+		{
+			AddEntry(Component, Component->PrimaryComponentTick, Actor->GetLevel(), true);
+		});
+	}
+
+	// proxies take the place of the originals, so prerequisites on an audited tick point at its proxy
+	TMap<FTickFunction*, FCombatTickAuditProxy*> ProxyByTarget;
+	for (const TUniquePtr<FCombatTickAuditProxy>& Proxy : Proxies)
+	{
+		ProxyByTarget.Add(Proxy->Entry->TickFunction, Proxy.Get());
+	}
+
+	for (const TUniquePtr<FCombatTickAuditProxy>& Proxy : Proxies)
+	{
+		FTickFunction* Target = Proxy->Entry->TickFunction;
+		for (FTickPrerequisite& Prerequisite : Target->GetPrerequisites())
+		{
+			UObject* PrerequisiteObject = Prerequisite.PrerequisiteObject.Get();
+			FTickFunction* PrerequisiteFunction = Prerequisite.Get();
+			if (!PrerequisiteObject || !PrerequisiteFunction)
+			{
+				continue;
+			}
+
+			FCombatTickAuditProxy* const* PrerequisiteProxy = ProxyByTarget.Find(PrerequisiteFunction);
+			Proxy->AddPrerequisite(PrerequisiteObject, PrerequisiteProxy ? **PrerequisiteProxy : *PrerequisiteFunction);
+		}
+
+		Target->SetTickFunctionEnable(false);
+		Proxy->Entry->bDisabledByAudit = true;
+	}
+
+	UE_LOG(LogCPPd1, Display, TEXT("Combat.TickAudit: timing %d enabled of %d registered tick functions for %d frames"), Proxies.Num(), Entries.Num(), FramesToAudit);
+}
+
+void UCombatTickAudit::AddEntry(UObject* Owner, FTickFunction& TickFunction, ULevel* Level, bool bIsComponent)
+{
+	if (!TickFunction.IsTickFunctionRegistered() || !Level)
+	{
+		return;
+	}
+
+	FCombatTickAuditEntry& Entry = *Entries.Add_GetRef(MakeUnique<FCombatTickAuditEntry>());
+	Entry.Owner = Owner;
+	Entry.TickFunction = &TickFunction;
+	Entry.Class = Owner->GetClass();
+	Entry.bIsComponent = bIsComponent;
+	Entry.TickGroup = TickFunction.TickGroup;
+	Entry.TickInterval = TickFunction.TickInterval;
+	Entry.bWasEnabled = TickFunction.IsTickFunctionEnabled();
+	Entry.bHasScriptTick = Entry.Class->IsFunctionImplementedInScript(ReceiveTickName);
+
+	if (!Entry.bWasEnabled)
+	{
+		return;
+	}
+
+	// same schedule as the original; runs on the game thread so the timing is the tick itself
+	FCombatTickAuditProxy& Proxy = *Proxies.Add_GetRef(MakeUnique<FCombatTickAuditProxy>());
+	Proxy.Entry = &Entry;
+	Proxy.bCanEverTick = true;
+	Proxy.bStartWithTickEnabled = true;
+	Proxy.bTickEvenWhenPaused = TickFunction.bTickEvenWhenPaused;
+	Proxy.bAllowTickOnDedicatedServer = TickFunction.bAllowTickOnDedicatedServer;
+	Proxy.TickGroup = TickFunction.TickGroup;
+	Proxy.EndTickGroup = TickFunction.EndTickGroup;
+	Proxy.TickInterval = TickFunction.TickInterval;
+	Proxy.RegisterTickFunction(Level);
+}
+
+void UCombatTickAudit::Tick(float DeltaTime)
+{
+	if (!bAuditing)
+	{
+		return;
+	}
+
+	if (++FramesAudited >= FramesToAudit)
+	{
+		StopAudit();
+	}
+}
+
+void UCombatTickAudit::StopAudit()
+{
+	if (!bAuditing)
+	{
+		return;
+	}
+
+	RestoreTickFunctions();
+	bAuditing = false;
+
+	TArray<FCombatTickAuditRow> Rows;
+	BuildRows(Rows);
+	PrintReport(Rows);
+
+	if (bWriteCsv)
+	{
+		const FString Path = WriteCsv(Rows);
+		if (Path.IsEmpty())
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("Combat.TickAudit: failed to write the CSV"));
+		}
+		else
+		{
+			UE_LOG(LogCPPd1, Display, TEXT("Combat.TickAudit: wrote %s"), *Path);
+		}
+	}
+
+	Entries.Reset();
+}
+
+void UCombatTickAudit::RestoreTickFunctions()
+{
+	for (const TUniquePtr<FCombatTickAuditProxy>& Proxy : Proxies)
+	{
+		Proxy->UnRegisterTickFunction();
+
+		// only what the audit itself turned off. Left alone if gameplay destroyed the owner or took the tick back
+		FCombatTickAuditEntry& Entry = *Proxy->Entry;
+		if (Entry.bDisabledByAudit && IsValid(Entry.Owner.Get()) && Entry.TickFunction->IsTickFunctionRegistered())
+		{
+			Entry.TickFunction->SetTickFunctionEnable(true);
+		}
+		Entry.bDisabledByAudit = false;
+	}
+
+	Proxies.Reset();
+}
+
+void UCombatTickAudit::BuildRows(TArray<FCombatTickAuditRow>& OutRows) const
+{
+	OutRows.Reset();
+	TMap<const UClass*, int32> RowIndices;
+
+	for (const TUniquePtr<FCombatTickAuditEntry>& EntryPtr : Entries)
+	{
+		const FCombatTickAuditEntry& Entry = *EntryPtr;
+
+		const int32* ExistingIndex = RowIndices.Find(Entry.Class);
+		const bool bNewRow = !ExistingIndex;
+		const int32 RowIndex = bNewRow ? RowIndices.Add(Entry.Class, OutRows.AddDefaulted()) : *ExistingIndex;
+		FCombatTickAuditRow& Row = OutRows[RowIndex];
+
+		if (bNewRow)
+		{
+			Row.Class = Entry.Class;
+			Row.bIsComponent = Entry.bIsComponent;
+			Row.TickGroup = Entry.TickGroup;
+			Row.TickInterval = Entry.TickInterval;
+		}
+		else if (Row.TickGroup != Entry.TickGroup || !FMath::IsNearlyEqual(Row.TickInterval, Entry.TickInterval))
+		{
+			Row.bMixed = true;
+		}
+
+		++Row.Registered;
+		if (!Entry.bWasEnabled)
+		{
+			continue;
+		}
+
+		++Row.Enabled;
+		Row.Calls += Entry.Calls;
+		Row.TotalSeconds += Entry.TotalSeconds;
+		Row.PeakSeconds = FMath::Max(Row.PeakSeconds, Entry.PeakSeconds);
+
+		if (Entry.Calls > 0 && !Entry.bHasScriptTick && Entry.TotalSeconds / Entry.Calls < EmptyTickSeconds)
+		{
+			++Row.EmptyCandidates;
+		}
+	}
+
+	OutRows.Sort([](const FCombatTickAuditRow& A, const FCombatTickAuditRow& B)
+	{
+		return A.TotalSeconds != B.TotalSeconds ? A.TotalSeconds > B.TotalSeconds : A.Registered > B.Registered;
+	});
+}
+
+void UCombatTickAudit::PrintReport(const TArray<FCombatTickAuditRow>& Rows) const
+{
+	const double Frames = FMath::Max(1, FramesAudited);
+
+	UE_LOG(LogCPPd1, Display, TEXT("Combat.TickAudit: %d frames"), FramesAudited);
+	UE_LOG(LogCPPd1, Display, TEXT("%-44s %-5s %5s %5s %-20s %8s %10s %10s %10s %6s"),
+		TEXT("Class"), TEXT("Kind"), TEXT("Reg"), TEXT("On"), TEXT("Group"), TEXT("Interval"), TEXT("AvgUs"), TEXT("PeakUs"), TEXT("MsFrame"), TEXT("Empty"));
+
+	double TotalSeconds = 0.0;
+	int32 TotalEmpty = 0;
+	for (const FCombatTickAuditRow& Row : Rows)
+	{
+		TotalSeconds += Row.TotalSeconds;
+		TotalEmpty += Row.EmptyCandidates;
+
+		const FString Group = Row.bMixed ? FString(TEXT("(mixed)")) : UEnum::GetValueAsString(Row.TickGroup);
+		const double AvgUs = Row.Calls > 0 ? Row.TotalSeconds / Row.Calls * 1.0e6 : 0.0;
+		UE_LOG(LogCPPd1, Display, TEXT("%-44s %-5s %5d %5d %-20s %8.3f %10.2f %10.2f %10.4f %6d"),
+			*Row.Class->GetName(), Row.bIsComponent ? TEXT("Comp") : TEXT("Actor"),
+			Row.Registered, Row.Enabled, *Group, Row.TickInterval,
+			AvgUs, Row.PeakSeconds * 1.0e6, Row.TotalSeconds / Frames * 1000.0, Row.EmptyCandidates);
+	}
+
+	UE_LOG(LogCPPd1, Display, TEXT("Combat.TickAudit: %.3f ms/frame in audited ticks, %d enabled ticks averaging under %.1f us (empty candidates)"),
+		TotalSeconds / Frames * 1000.0, TotalEmpty, EmptyTickSeconds * 1.0e6);
+}
+
+FString UCombatTickAudit::WriteCsv(const TArray<FCombatTickAuditRow>& Rows) const
+{
+	const FString Path = FPaths::ProfilingDir() / FString::Printf(TEXT("CombatTickAudit-%s.csv"), *FDateTime::Now().ToString());
+	const double Frames = FMath::Max(1, FramesAudited);
+
+	FString Csv = TEXT("Map,Frames,Class,Kind,Registered,Enabled,TickGroup,TickInterval,Calls,AvgUs,PeakUs,MsPerFrame,EmptyCandidates");
+	Csv += LINE_TERMINATOR;
+
+	const FString MapName = GetWorld()->GetMapName();
+	for (const FCombatTickAuditRow& Row : Rows)
+	{
+		const FString Group = Row.bMixed ? FString(TEXT("Mixed")) : UEnum::GetValueAsString(Row.TickGroup);
+		const double AvgUs = Row.Calls > 0 ? Row.TotalSeconds / Row.Calls * 1.0e6 : 0.0;
+		Csv += FString::Printf(TEXT("%s,%d,%s,%s,%d,%d,%s,%.3f,%d,%.3f,%.3f,%.5f,%d"),
+			*MapName, FramesAudited, *Row.Class->GetName(), Row.bIsComponent ? TEXT("Component") : TEXT("Actor"),
+			Row.Registered, Row.Enabled, *Group, Row.TickInterval, Row.Calls,
+			AvgUs, Row.PeakSeconds * 1.0e6, Row.TotalSeconds / Frames * 1000.0, Row.EmptyCandidates);
+		Csv += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Path) ? Path : FString();
+}
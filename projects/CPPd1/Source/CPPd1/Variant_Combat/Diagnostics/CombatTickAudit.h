@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTickAudit.generated.h"
+
+/** One audited actor or component tick function and what it cost during the audit */
+struct FCombatTickAuditEntry
+{
+	/** Actor or component that owns the tick function; the tick function lives inside it */
+	TWeakObjectPtr<UObject> Owner;
+	FTickFunction* TickFunction = nullptr;
+
+	const UClass* Class = nullptr;
+	bool bIsComponent = false;
+
+	ETickingGroup TickGroup = TG_PrePhysics;
+	float TickInterval = 0.0f;
+
+	/** Enabled when the audit started; disabled tick functions are only counted */
+	bool bWasEnabled = false;
+
+	/**
+	 * The audit turned this tick function off and ticks it through a proxy. Cleared for good once gameplay turns it
+	 * back on; from then on it's gameplay's, and the audit neither ticks it nor restores it
+	 */
+	bool bDisabledByAudit = false;
+
+	/** Blueprint Tick event implemented (the native Tick may still be empty) */
+	bool bHasScriptTick = false;
+
+	int32 Calls = 0;
+	double TotalSeconds = 0.0;
+	double PeakSeconds = 0.0;
+};
+
+/** Ticks an audited tick function in place of the engine, and times it */
+struct FCombatTickAuditProxy : public FTickFunction
+{
+	FCombatTickAuditEntry* Entry = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+/** Per-class totals for the report */
+struct FCombatTickAuditRow
+{
+	const UClass* Class = nullptr;
+	bool bIsComponent = false;
+
+	int32 Registered = 0;
+	int32 Enabled = 0;
+
+	/** Enabled tick functions whose calls cost next to nothing: candidates for bCanEverTick = false */
+	int32 EmptyCandidates = 0;
+
+	/** Tick group and interval of the first instance; bMixed if instances differ */
+	ETickingGroup TickGroup = TG_PrePhysics;
+	float TickInterval = 0.0f;
+	bool bMixed = false;
+
+	int32 Calls = 0;
+	double TotalSeconds = 0.0;
+	double PeakSeconds = 0.0;
+};
+
+/**
+ * Runtime tick audit: lists every registered actor and component tick function in the world, grouped by class,
+ * with tick group, interval, average and peak cost over N frames, and flags enabled ticks that do next to nothing.
+ *
+ * While the audit runs, each enabled tick function is disabled and a timing proxy with the same group, interval and
+ * prerequisites ticks it instead, on the game thread. Ordering within a tick group can shift slightly, and
+ * any-thread ticks run on the game thread. Everything is restored when the audit ends.
+ *
+ * Turning off a tick function the audit has already turned off changes nothing the audit can see, so a tick that
+ * gameplay turns off mid-audit keeps ticking through its proxy and is turned back on at the end.
+ * Tickable objects and world subsystems (FTickableGameObject) aren't tick functions and aren't listed.
+ *
+ * Console: Combat.TickAudit [Frames=300] [Csv], or Combat.TickAudit Stop
+ */
+UCLASS()
+class CPPd1_API UCombatTickAudit : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Start auditing for the given number of frames */
+	void StartAudit(int32 InFrames, bool bInWriteCsv);
+
+	/** End early and report what was measured */
+	void StopAudit();
+
+	bool IsAuditing() const { return bAuditing; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	bool bAuditing = false;
+	bool bWriteCsv = false;
+	int32 FramesToAudit = 0;
+	int32 FramesAudited = 0;
+
+	/** Entries and their proxies; both are heap-allocated so the pointers they hold stay put */
+	TArray<TUniquePtr<FCombatTickAuditEntry>> Entries;
+	TArray<TUniquePtr<FCombatTickAuditProxy>> Proxies;
+
+	/** Register a tick function for the audit, with a proxy if it is enabled */
+	void AddEntry(UObject* Owner, FTickFunction& TickFunction, ULevel* Level, bool bIsComponent);
+
+	/** Unregister the proxies and give the engine its tick functions back */
+	void RestoreTickFunctions();
+
+	/** Group the entries by class, most expensive first */
+	void BuildRows(TArray<FCombatTickAuditRow>& OutRows) const;
+
+	void PrintReport(const TArray<FCombatTickAuditRow>& Rows) const;
+	FString WriteCsv(const TArray<FCombatTickAuditRow>& Rows) const;
+};
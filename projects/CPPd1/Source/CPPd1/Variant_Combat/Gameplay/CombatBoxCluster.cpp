@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatBoxCluster.h"
+#include "CPPd1.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Algo/Count.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "CPPd1RoundSnapshot.h"
+
+ACombatBoxCluster::ACombatBoxCluster()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the instanced boxes
+	RootComponent = Boxes = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Boxes"));
+
+	// set the collision properties. Resting boxes are kinematic; hit boxes simulate on pooled bodies
+	Boxes->SetCollisionProfileName(FName("BlockAllDynamic"));
+	Boxes->SetMobility(EComponentMobility::Movable);
+
+	// disable navigation relevance so boxes don't affect NavMesh generation
+	Boxes->bNavigationRelevant = false;
+}
+
+void ACombatBoxCluster::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// every placed instance starts as a live box at rest
+	ClusterBoxes.SetNum(Boxes->GetInstanceCount());
+	for (int32 BoxIndex = 0; BoxIndex < ClusterBoxes.Num(); ++BoxIndex)
+	{
+		ClusterBoxes[BoxIndex].HP = BoxHP;
+		ClusterBoxes[BoxIndex].Instance = BoxIndex;
+	}
+
+	// build the body pool up front so hits never spawn components
+	Bodies.Reserve(BodyPoolSize);
+	BodyOwners.Init(INDEX_NONE, BodyPoolSize);
+	for (int32 BodyIndex = 0; BodyIndex < BodyPoolSize; ++BodyIndex)
+	{
+		UStaticMeshComponent* Body = NewObject<UStaticMeshComponent>(this);
+		Body->SetStaticMesh(Boxes->GetStaticMesh());
+		for (int32 Slot = 0; Slot < Boxes->GetNumMaterials(); ++Slot)
+		{
+			Body->SetMaterial(Slot, Boxes->GetMaterial(Slot));
+		}
+
+		Body->SetCollisionProfileName(FName("BlockAllDynamic"));
+		Body->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Body->SetHiddenInGame(true);
+		Body->bNavigationRelevant = false;
+
+		// settle quickly, and report it so the box can go back to being an instance
+		Body->BodyInstance.SleepFamily = ESleepFamily::Custom;
+		Body->BodyInstance.CustomSleepThresholdMultiplier = SleepThresholdMultiplier;
+		Body->BodyInstance.bGenerateWakeEvents = true;
+		Body->OnComponentSleep.AddDynamic(this, &ACombatBoxCluster::OnBodySleep);
+
+		// not attached: the body moves on its own while simulating
+		Body->RegisterComponent();
+		AddInstanceComponent(Body);
+
+		Bodies.Add(Body);
+		INC_DWORD_STAT(STAT_CombatPooledActors);
+	}
+
+	UCPPd1RoundSnapshot::Register(this);
+}
+
+void ACombatBoxCluster::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	UCPPd1RoundSnapshot::Unregister(this);
+
+	// clear the debris timers
+	for (FClusterBox& Box : ClusterBoxes)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(Box.DebrisTimer);
+	}
+
+	// bodies still in the pool leave the pooled count with us
+	for (int32 Owner : BodyOwners)
+	{
+		if (Owner == INDEX_NONE)
+		{
+			DEC_DWORD_STAT(STAT_CombatPooledActors);
+		}
+	}
+	BodyOwners.Reset();
+}
+
+int32 ACombatBoxCluster::GetNumLiveBoxes() const
+{
+	return Algo::CountIf(ClusterBoxes, [](const FClusterBox& Box) { return Box.IsAlive(); });
+}
+
+int32 ACombatBoxCluster::FindNearestBox(const FVector& Location) const
+{
+	int32 Nearest = INDEX_NONE;
+	double NearestDistSq = TNumericLimits<double>::Max();
+
+	for (int32 BoxIndex = 0; BoxIndex < ClusterBoxes.Num(); ++BoxIndex)
+	{
+		if (!ClusterBoxes[BoxIndex].IsAlive())
+		{
+			continue;
+		}
+
+		const double DistSq = FVector::DistSquared(GetBoxTransform(BoxIndex).GetLocation(), Location);
+		if (DistSq < NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			Nearest = BoxIndex;
+		}
+	}
+
+	return Nearest;
+}
+
+FTransform ACombatBoxCluster::GetBoxTransform(int32 BoxIndex) const
+{
+	const FClusterBox& Box = ClusterBoxes[BoxIndex];
+
+	FTransform Transform = GetActorTransform();
+	if (Box.Instance != INDEX_NONE)
+	{
+		Boxes->GetInstanceTransform(Box.Instance, Transform, true);
+	}
+	else if (Box.Body != INDEX_NONE)
+	{
+		Transform = Bodies[Box.Body]->GetComponentTransform();
+	}
+
+	return Transform;
+}
+
+bool ACombatBoxCluster::PromoteBox(int32 BoxIndex)
+{
+	const int32 BodyIndex = BodyOwners.Find(INDEX_NONE);
+	if (BodyIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FTransform Transform = GetBoxTransform(BoxIndex);
+	RemoveBoxInstance(BoxIndex);
+
+	BodyOwners[BodyIndex] = BoxIndex;
+	ClusterBoxes[BoxIndex].Body = BodyIndex;
+	DEC_DWORD_STAT(STAT_CombatPooledActors);
+
+	// take the instance's place, then hand it to physics
+	UStaticMeshComponent* Body = Bodies[BodyIndex];
+	Body->SetWorldTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Body->SetCollisionProfileName(FName("BlockAllDynamic"));
+	Body->SetHiddenInGame(false);
+	Body->SetSimulatePhysics(true);
+
+	return true;
+}
+
+void ACombatBoxCluster::DemoteBox(int32 BoxIndex)
+{
+	FClusterBox& Box = ClusterBoxes[BoxIndex];
+	if (Box.Body == INDEX_NONE)
+	{
+		return;
+	}
+
+	Box.Instance = Boxes->AddInstance(Bodies[Box.Body]->GetComponentTransform(), true);
+
+	ReleaseBody(Box.Body);
+	Box.Body = INDEX_NONE;
+}
+
+void ACombatBoxCluster::RemoveBoxInstance(int32 BoxIndex)
+{
+	const int32 Removed = ClusterBoxes[BoxIndex].Instance;
+	if (Removed == INDEX_NONE)
+	{
+		return;
+	}
+
+	// removal shifts the later instances down by one
+	Boxes->RemoveInstance(Removed);
+	ClusterBoxes[BoxIndex].Instance = INDEX_NONE;
+
+	for (FClusterBox& Box : ClusterBoxes)
+	{
+		if (Box.Instance > Removed)
+		{
+			--Box.Instance;
+		}
+	}
+}
+
+void ACombatBoxCluster::ReleaseBody(int32 BodyIndex)
+{
+	UStaticMeshComponent* Body = Bodies[BodyIndex];
+	Body->SetSimulatePhysics(false);
+	Body->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Body->SetHiddenInGame(true);
+
+	if (BodyOwners[BodyIndex] != INDEX_NONE)
+	{
+		BodyOwners[BodyIndex] = INDEX_NONE;
+		INC_DWORD_STAT(STAT_CombatPooledActors);
+	}
+}
+
+void ACombatBoxCluster::OnBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	const int32 BodyIndex = Bodies.IndexOfByKey(SleepingComponent);
+	const int32 BoxIndex = BodyOwners.IsValidIndex(BodyIndex) ? BodyOwners[BodyIndex] : INDEX_NONE;
+
+	// debris stays where it landed until its timer frees the body
+	if (BoxIndex != INDEX_NONE && ClusterBoxes[BoxIndex].IsAlive())
+	{
+		DemoteBox(BoxIndex);
+	}
+}
+
+void ACombatBoxCluster::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	COMBAT_SCOPE(ApplyDamage);
+
+	const int32 BoxIndex = FindNearestBox(DamageLocation);
+	if (BoxIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FClusterBox& Box = ClusterBoxes[BoxIndex];
+
+	// apply the damage
+	Box.HP -= Damage;
+
+	// knock the box loose if a body is free, ignoring its mass
+	if (Box.Body != INDEX_NONE || PromoteBox(BoxIndex))
+	{
+		UStaticMeshComponent* Body = Bodies[Box.Body];
+		Body->AddImpulseAtLocation(DamageImpulse * Body->GetMass(), DamageLocation);
+	}
+
+	// is it destroyed?
+	if (!Box.IsAlive())
+	{
+		KillBox(BoxIndex);
+	}
+
+	// call the BP handler to play effects, etc.
+	OnBoxDamaged(BoxIndex, DamageLocation, DamageImpulse);
+}
+
+void ACombatBoxCluster::KillBox(int32 BoxIndex)
+{
+	FClusterBox& Box = ClusterBoxes[BoxIndex];
+	Box.HP = FMath::Min(Box.HP, 0.0f);
+
+	const FVector BoxLocation = GetBoxTransform(BoxIndex).GetLocation();
+
+	if (Box.Body != INDEX_NONE)
+	{
+		// change the collision object type to Visibility so we ignore most interactions but still retain physics collisions
+		Bodies[Box.Body]->SetCollisionObjectType(ECC_Visibility);
+
+		// set up the debris cleanup timer
+		GetWorld()->GetTimerManager().SetTimer(Box.DebrisTimer, FTimerDelegate::CreateUObject(this, &ACombatBoxCluster::RemoveDebris, BoxIndex), DeathDelayTime, false);
+	}
+	else
+	{
+		// no body to spare: the box just disappears
+		RemoveBoxInstance(BoxIndex);
+	}
+
+	// call the BP handler to play effects, etc.
+	OnBoxDestroyed(BoxIndex, BoxLocation);
+}
+
+void ACombatBoxCluster::RemoveDebris(int32 BoxIndex)
+{
+	FClusterBox& Box = ClusterBoxes[BoxIndex];
+	if (Box.Body != INDEX_NONE)
+	{
+		ReleaseBody(Box.Body);
+		Box.Body = INDEX_NONE;
+	}
+}
+
+void ACombatBoxCluster::HandleDeath()
+{
+	for (int32 BoxIndex = 0; BoxIndex < ClusterBoxes.Num(); ++BoxIndex)
+	{
+		if (ClusterBoxes[BoxIndex].IsAlive())
+		{
+			KillBox(BoxIndex);
+		}
+	}
+}
+
+void ACombatBoxCluster::ApplyHealing(float Healing, AActor* Healer)
+{
+	// stub
+}
+
+void ACombatBoxCluster::CaptureRoundState()
+{
+	RoundStartBoxes.SetNum(ClusterBoxes.Num());
+	for (int32 BoxIndex = 0; BoxIndex < ClusterBoxes.Num(); ++BoxIndex)
+	{
+		RoundStartBoxes[BoxIndex].Transform = GetBoxTransform(BoxIndex);
+		RoundStartBoxes[BoxIndex].HP = ClusterBoxes[BoxIndex].HP;
+	}
+}
+
+void ACombatBoxCluster::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	// every body back to the pool, then rebuild the instances in one pass
+	for (FClusterBox& Box : ClusterBoxes)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(Box.DebrisTimer);
+		if (Box.Body != INDEX_NONE)
+		{
+			ReleaseBody(Box.Body);
+			Box.Body = INDEX_NONE;
+		}
+	}
+
+	Boxes->ClearInstances();
+
+	for (int32 BoxIndex = 0; BoxIndex < ClusterBoxes.Num() && BoxIndex < RoundStartBoxes.Num(); ++BoxIndex)
+	{
+		FClusterBox& Box = ClusterBoxes[BoxIndex];
+		const FBoxRoundState& RoundStart = RoundStartBoxes[BoxIndex];
+
+		Box.HP = RoundStart.HP;
+		Box.Instance = Box.IsAlive() ? Boxes->AddInstance(RoundStart.Transform, true) : INDEX_NONE;
+	}
+}
@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatDamageable.h"
+#include "CPPd1RoundResettable.h"
+#include "CombatBoxCluster.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMeshComponent;
+
+/**
+ *  A group of damageable boxes drawn and collided as instances of one mesh.
+ *
+ *  Boxes at rest are kinematic instances: one draw call and no simulation cost. A box that gets hit is promoted
+ *  to a simulated body from a small pool, knocked back, and demoted to an instance again once it falls asleep.
+ *  Pooled bodies use a raised sleep threshold so they settle quickly. A destroyed box becomes debris: its body
+ *  lingers for DeathDelayTime and then goes back to the pool.
+ *
+ *  Place boxes by adding instances to the Boxes component.
+ */
+UCLASS(abstract)
+class ACombatBoxCluster : public AActor, public ICombatDamageable, public ICPPd1RoundResettable
+{
+	GENERATED_BODY()
+
+	/** Boxes at rest */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UInstancedStaticMeshComponent* Boxes;
+
+public:
+
+	/** Constructor */
+	ACombatBoxCluster();
+
+protected:
+
+	/** HP each box starts with */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.0f))
+	float BoxHP = 3.0f;
+
+	/** Time a destroyed box lingers as debris before its body goes back to the pool */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float DeathDelayTime = 6.0f;
+
+	/** Simulated bodies shared by hit and destroyed boxes. A box hit while none is free takes damage without moving */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 1, ClampMax = 32))
+	int32 BodyPoolSize = 6;
+
+	/** Multiplier on the default sleep thresholds of pooled bodies. Higher settles sooner */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 1.0f))
+	float SleepThresholdMultiplier = 8.0f;
+
+	/** One box of the cluster */
+	struct FClusterBox
+	{
+		float HP = 0.0f;
+
+		/** Instance index while at rest, INDEX_NONE while promoted or destroyed */
+		int32 Instance = INDEX_NONE;
+
+		/** Pooled body index while promoted or lingering as debris, INDEX_NONE otherwise */
+		int32 Body = INDEX_NONE;
+
+		/** Fires DeathDelayTime after the box was destroyed */
+		FTimerHandle DebrisTimer;
+
+		bool IsAlive() const { return HP > 0.0f; }
+	};
+
+	TArray<FClusterBox> ClusterBoxes;
+
+	/** Pooled simulated bodies */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStaticMeshComponent>> Bodies;
+
+	/** Box each pooled body stands in for, INDEX_NONE if it's free */
+	TArray<int32> BodyOwners;
+
+	/** Box transform and HP when the round snapshot was taken */
+	struct FBoxRoundState
+	{
+		FTransform Transform;
+		float HP = 0.0f;
+	};
+
+	TArray<FBoxRoundState> RoundStartBoxes;
+
+	/** Blueprint damage handler for effect playback */
+	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
+	void OnBoxDamaged(int32 BoxIndex, const FVector& DamageLocation, const FVector& DamageImpulse);
+
+	/** Blueprint destruction handler for effect playback */
+	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
+	void OnBoxDestroyed(int32 BoxIndex, const FVector& BoxLocation);
+
+	/** Live box closest to a world location, INDEX_NONE if none is left */
+	int32 FindNearestBox(const FVector& Location) const;
+
+	/** World transform of a box, wherever it currently lives */
+	FTransform GetBoxTransform(int32 BoxIndex) const;
+
+	/** Move a box from its instance onto a free pooled body. False if the pool is empty */
+	bool PromoteBox(int32 BoxIndex);
+
+	/** Put a box back into the instances at its body's transform and free the body */
+	void DemoteBox(int32 BoxIndex);
+
+	/** Remove a box's instance, keeping every other box's instance index valid */
+	void RemoveBoxInstance(int32 BoxIndex);
+
+	/** Destroy one box */
+	void KillBox(int32 BoxIndex);
+
+	/** Debris timer callback: free the destroyed box's body */
+	void RemoveDebris(int32 BoxIndex);
+
+	/** Hide a pooled body, stop its simulation and mark it free */
+	void ReleaseBody(int32 BodyIndex);
+
+	/** Pooled body fell asleep: demote the box it stands in for */
+	UFUNCTION()
+	void OnBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+public:
+
+	/** Builds the body pool and registers with the round snapshot */
+	virtual void BeginPlay() override;
+
+	/** EndPlay cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Number of boxes not yet destroyed */
+	UFUNCTION(BlueprintPure, Category="Damage")
+	int32 GetNumLiveBoxes() const;
+
+	// ~Begin CombatDamageable interface
+
+	/** Damages and knocks back the box nearest to DamageLocation */
+	virtual void ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse) override;
+
+	/** Destroys every remaining box */
+	virtual void HandleDeath() override;
+
+	/** Handles healing events */
+	virtual void ApplyHealing(float Healing, AActor* Healer) override;
+
+	// ~End CombatDamageable interface
+
+	// ~Begin CPPd1RoundResettable interface
+
+	virtual void CaptureRoundState() override;
+
+	/** Every box back to its round start HP, at rest where it was */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+
+	// ~End CPPd1RoundResettable interface
+};
@@ -4,6 +4,7 @@
 #include "CombatCheckpointVolume.h"
 #include "CombatCharacter.h"
 #include "CombatPlayerController.h"
+#include "CombatSaveSystem.h"
 
 ACombatCheckpointVolume::ACombatCheckpointVolume()
 {
@@ -41,6 +42,9 @@ void ACombatCheckpointVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent
 
 			// update the player's respawn checkpoint
 			PC->SetRespawnTransform(PlayerCharacter->GetActorTransform());
+
+			// persist the checkpoint along with the progression earned so far
+			UCombatSaveSystem::RequestSave(this);
 		}
 
 	}
@@ -2,9 +2,11 @@
 
 
 #include "CombatDamageableBox.h"
+#include "CPPd1.h"
 #include "Components/StaticMeshComponent.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
+#include "CPPd1RoundSnapshot.h"
 
 ACombatDamageableBox::ACombatDamageableBox()
 {
@@ -25,20 +27,43 @@ ACombatDamageableBox::ACombatDamageableBox()
 
 void ACombatDamageableBox::RemoveFromLevel()
 {
+	// in a level played in rounds the snapshot restores us in place, so just take the box out of play
+	if (const UCPPd1RoundSnapshot* Snapshot = GetWorld()->GetSubsystem<UCPPd1RoundSnapshot>())
+	{
+		if (Snapshot->HasSnapshot() && Snapshot->IsRegistered(this))
+		{
+			Mesh->SetSimulatePhysics(false);
+			SetActorEnableCollision(false);
+			SetActorHiddenInGame(true);
+			return;
+		}
+	}
+
 	// destroy this actor
 	Destroy();
 }
 
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UCPPd1RoundSnapshot::Register(this);
+}
+
 void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	UCPPd1RoundSnapshot::Unregister(this);
+
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
 }
 
 void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	COMBAT_SCOPE(ApplyDamage);
+
 	// only process damage if we still have HP
 	if (CurrentHP > 0.0f)
 	{
@@ -76,3 +101,29 @@ void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
 	// stub
 }
 
+
+void ACombatDamageableBox::CaptureRoundState()
+{
+	RoundStartHP = CurrentHP;
+	RoundStartObjectType = Mesh->GetCollisionObjectType();
+	bRoundStartSimulating = Mesh->IsSimulatingPhysics();
+}
+
+void ACombatDamageableBox::RestoreRoundState(const FTransform& RoundStartTransform)
+{
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	CurrentHP = RoundStartHP;
+	Mesh->SetCollisionObjectType(RoundStartObjectType);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	// teleport while kinematic, then hand it back to physics at rest
+	Mesh->SetSimulatePhysics(false);
+	SetActorTransform(RoundStartTransform, false, nullptr, ETeleportType::ResetPhysics);
+	if (bRoundStartSimulating)
+	{
+		Mesh->SetSimulatePhysics(true);
+		Mesh->PutRigidBodyToSleep();
+	}
+}
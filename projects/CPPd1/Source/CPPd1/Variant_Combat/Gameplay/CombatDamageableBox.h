@@ -5,13 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "CPPd1RoundResettable.h"
 #include "CombatDamageableBox.generated.h"
 
 /**
  *  A simple physics box that reacts to damage through the ICombatDamageable interface
  */
 UCLASS(abstract)
-class ACombatDamageableBox : public AActor, public ICombatDamageable
+class ACombatDamageableBox : public AActor, public ICombatDamageable, public ICPPd1RoundResettable
 {
 	GENERATED_BODY()
 	
@@ -37,6 +38,11 @@ protected:
 	/** Timer to defer destruction of this box after its HP are depleted */
 	FTimerHandle DeathTimer;
 
+	/** HP, collision object type and physics state when the round snapshot was taken */
+	float RoundStartHP = 0.0f;
+	TEnumAsByte<ECollisionChannel> RoundStartObjectType = ECC_PhysicsBody;
+	bool bRoundStartSimulating = true;
+
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDamaged(const FVector& DamageLocation, const FVector& DamageImpulse);
@@ -45,11 +51,14 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDestroyed();
 
-	/** Timer callback to remove the box from the level after it dies */
+	/** Timer callback to remove the box from the level after it dies. In a level played in rounds the box is only hidden, so the next round can bring it back */
 	void RemoveFromLevel();
 
 public:
 
+	/** Registers with the round snapshot */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
 	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
@@ -65,4 +74,13 @@ public:
 	virtual void ApplyHealing(float Healing, AActor* Healer) override;
 
 	// ~End CombatDamageable interface
+
+	// ~Begin CPPd1RoundResettable interface
+
+	virtual void CaptureRoundState() override;
+
+	/** Back to full HP, shown, and at rest at the round start transform */
+	virtual void RestoreRoundState(const FTransform& RoundStartTransform) override;
+
+	// ~End CPPd1RoundResettable interface
 };
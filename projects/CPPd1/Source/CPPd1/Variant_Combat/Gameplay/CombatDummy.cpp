@@ -2,6 +2,7 @@
 
 
 #include "CombatDummy.h"
+#include "CPPd1.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
@@ -33,6 +34,8 @@ ACombatDummy::ACombatDummy()
 
 void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	COMBAT_SCOPE(ApplyDamage);
+
 	// apply impulse to the dummy
 	Dummy->AddImpulseAtLocation(DamageImpulse, DamageLocation);
 
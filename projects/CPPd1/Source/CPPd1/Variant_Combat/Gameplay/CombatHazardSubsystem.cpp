@@ -0,0 +1,215 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatHazardSubsystem.h"
+#include "CombatDamageable.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UCombatHazardSubsystem* UCombatHazardSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatHazardSubsystem>() : nullptr;
+}
+
+void UCombatHazardSubsystem::AddZone(UPrimitiveComponent* Volume, float DamagePerSecond)
+{
+	if (!Volume)
+	{
+		return;
+	}
+
+	FZone* Zone = FindZone(Volume);
+	if (!Zone)
+	{
+		Zone = &Zones.AddDefaulted_GetRef();
+		Zone->Volume = Volume;
+	}
+
+	Zone->DamagePerSecond = DamagePerSecond;
+}
+
+void UCombatHazardSubsystem::RemoveZone(UPrimitiveComponent* Volume)
+{
+	Zones.RemoveAllSwap([Volume](const FZone& Zone) { return Zone.Volume == Volume; });
+	UpdateTimer();
+}
+
+void UCombatHazardSubsystem::EnterZone(UPrimitiveComponent* Volume, AActor* Actor)
+{
+	FZone* Zone = FindZone(Volume);
+	if (!Zone || !Cast<ICombatDamageable>(Actor))
+	{
+		return;
+	}
+
+	// several components of one actor (capsule, mesh) count once
+	if (Zone->Occupants.ContainsByPredicate([Actor](const FOccupant& Occupant) { return Occupant.Actor == Actor; }))
+	{
+		return;
+	}
+
+	// the first interval is charged on contact, like the old on-hit damage. Coming back while a recent visit is
+	// still prepaid picks that visit up again instead
+	const double Now = GetNow();
+	double PaidUntil = Now + TickInterval;
+	float EntryDamage = Zone->DamagePerSecond * TickInterval;
+
+	Zone->Departed.RemoveAllSwap([Now](const FOccupant& Departed) { return !Departed.Actor.IsValid() || Departed.PaidUntil <= Now; });
+	const int32 DepartedIndex = Zone->Departed.IndexOfByPredicate([Actor](const FOccupant& Departed) { return Departed.Actor == Actor; });
+	if (DepartedIndex != INDEX_NONE)
+	{
+		PaidUntil = Zone->Departed[DepartedIndex].PaidUntil;
+		EntryDamage = 0.0f;
+		Zone->Departed.RemoveAtSwap(DepartedIndex);
+	}
+
+	Zone->Occupants.Add({ Actor, PaidUntil });
+	AActor* Source = Zone->Volume.IsValid() ? Zone->Volume->GetOwner() : nullptr;
+	UpdateTimer();
+
+	DamageOccupant(Actor, EntryDamage, Source);
+}
+
+void UCombatHazardSubsystem::LeaveZone(UPrimitiveComponent* Volume, AActor* Actor)
+{
+	FZone* Zone = FindZone(Volume);
+	if (!Zone)
+	{
+		return;
+	}
+
+	// settle the time inside since the last batch
+	float Damage = 0.0f;
+	const double Now = GetNow();
+	const int32 OccupantIndex = Zone->Occupants.IndexOfByPredicate([Actor](const FOccupant& Occupant) { return Occupant.Actor == Actor; });
+	if (OccupantIndex != INDEX_NONE)
+	{
+		FOccupant& Occupant = Zone->Occupants[OccupantIndex];
+		Damage = SettleOccupant(*Zone, Occupant, Now);
+
+		// keep any prepaid time, so coming straight back isn't charged again
+		if (Occupant.PaidUntil > Now)
+		{
+			Zone->Departed.Add(Occupant);
+		}
+		Zone->Occupants.RemoveAtSwap(OccupantIndex);
+	}
+
+	AActor* Source = Zone->Volume.IsValid() ? Zone->Volume->GetOwner() : nullptr;
+	UpdateTimer();
+
+	DamageOccupant(Actor, Damage, Source);
+}
+
+float UCombatHazardSubsystem::SettleOccupant(const FZone& Zone, FOccupant& Occupant, double Now)
+{
+	// still inside the interval paid on entry
+	if (Now <= Occupant.PaidUntil)
+	{
+		return 0.0f;
+	}
+
+	const float Damage = Zone.DamagePerSecond * float(Now - Occupant.PaidUntil);
+	Occupant.PaidUntil = Now;
+	return Damage;
+}
+
+void UCombatHazardSubsystem::DamageOccupant(AActor* Target, float Damage, AActor* Source)
+{
+	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(Target))
+	{
+		if (Damage > 0.0f)
+		{
+			Damageable->ApplyHazardDamage(Damage, Source, Target->GetActorLocation());
+		}
+	}
+}
+
+UCombatHazardSubsystem::FZone* UCombatHazardSubsystem::FindZone(const UPrimitiveComponent* Volume)
+{
+	return Zones.FindByPredicate([Volume](const FZone& Zone) { return Zone.Volume == Volume; });
+}
+
+void UCombatHazardSubsystem::UpdateTimer()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const bool bOccupied = Zones.ContainsByPredicate([](const FZone& Zone) { return !Zone.Occupants.IsEmpty(); });
+	FTimerManager& TimerManager = World->GetTimerManager();
+
+	if (bOccupied && !TimerManager.IsTimerActive(BatchTimer))
+	{
+		TimerManager.SetTimer(BatchTimer, this, &UCombatHazardSubsystem::ApplyDamageBatch, TickInterval, true);
+	}
+	else if (!bOccupied)
+	{
+		TimerManager.ClearTimer(BatchTimer);
+	}
+}
+
+void UCombatHazardSubsystem::ApplyDamageBatch()
+{
+	COMBAT_SCOPE(HazardDamage);
+
+	struct FPendingDamage
+	{
+		TWeakObjectPtr<AActor> Target;
+		TWeakObjectPtr<AActor> Source;
+		float Damage;
+	};
+
+	const double Now = GetNow();
+
+	// settle every occupant first: damage can kill or move actors, which ends overlaps and edits the occupant lists
+	TArray<FPendingDamage, TInlineAllocator<16>> Batch;
+	for (FZone& Zone : Zones)
+	{
+		const UPrimitiveComponent* Volume = Zone.Volume.Get();
+		Zone.Occupants.RemoveAllSwap([](const FOccupant& Occupant) { return !Occupant.Actor.IsValid(); });
+		Zone.Departed.RemoveAllSwap([Now](const FOccupant& Departed) { return !Departed.Actor.IsValid() || Departed.PaidUntil <= Now; });
+
+		for (FOccupant& Occupant : Zone.Occupants)
+		{
+			const float Damage = SettleOccupant(Zone, Occupant, Now);
+			if (Volume && Damage > 0.0f)
+			{
+				Batch.Add({ Occupant.Actor, Volume->GetOwner(), Damage });
+			}
+		}
+	}
+
+	for (const FPendingDamage& Pending : Batch)
+	{
+		DamageOccupant(Pending.Target.Get(), Pending.Damage, Pending.Source.Get());
+	}
+
+	UpdateTimer();
+}
+
+double UCombatHazardSubsystem::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+bool UCombatHazardSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatHazardSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(BatchTimer);
+	}
+
+	Zones.Reset();
+
+	Super::Deinitialize();
+}
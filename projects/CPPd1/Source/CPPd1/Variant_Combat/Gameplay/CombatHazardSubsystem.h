@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatHazardSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Damage-over-time for every hazard zone in the world (lava floors and the like).
+ *
+ * Zones register an overlap volume and a damage per second, then report actors entering and leaving.
+ * One timer applies damage to every occupant of every zone in a single batch every TickInterval seconds.
+ * Each occupant takes DamagePerSecond times the time it spent inside, so damage doesn't depend on frame rate.
+ * Entering charges the first TickInterval up front, so even a brief touch hurts, and leaving settles the rest.
+ * An actor that leaves keeps what it prepaid until that runs out, and re-entering before then costs nothing, so
+ * flickering across the edge of a zone isn't charged per overlap event.
+ * Damage goes through ICombatDamageable::ApplyHazardDamage, which characters exempt from invincibility frames.
+ * The cost per batch only depends on how many actors are in hazards, not on how many physics contacts they make.
+ * The timer only runs while a zone has occupants.
+ */
+UCLASS()
+class CPPd1_API UCombatHazardSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Seconds between damage batches */
+	static constexpr float TickInterval = 0.25f;
+
+	/** Start tracking a zone. Registering the same volume again updates its damage */
+	void AddZone(UPrimitiveComponent* Volume, float DamagePerSecond);
+
+	/** Stop tracking a zone and forget its occupants */
+	void RemoveZone(UPrimitiveComponent* Volume);
+
+	/** An actor began overlapping a zone. Only ICombatDamageable actors are tracked */
+	void EnterZone(UPrimitiveComponent* Volume, AActor* Actor);
+
+	/** An actor stopped overlapping a zone. Call once none of its components overlap the volume any more */
+	void LeaveZone(UPrimitiveComponent* Volume, AActor* Actor);
+
+	/** Shorthand for zones registering from BeginPlay */
+	static UCombatHazardSubsystem* Get(const UObject* WorldContextObject);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	struct FOccupant
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** World time damage has been settled up to. Ahead of the clock right after entry */
+		double PaidUntil = 0.0;
+	};
+
+	struct FZone
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Volume;
+		float DamagePerSecond = 0.0f;
+		TArray<FOccupant> Occupants;
+
+		/** Actors that left with prepaid time still ahead of the clock, kept until it runs out */
+		TArray<FOccupant> Departed;
+	};
+
+	FZone* FindZone(const UPrimitiveComponent* Volume);
+
+	/** Start or stop the batch timer depending on whether anything is in a hazard */
+	void UpdateTimer();
+
+	/** Timer callback: damage every occupant of every zone */
+	void ApplyDamageBatch();
+
+	/** Damage owed by an occupant since it was last settled, marking it settled up to now */
+	static float SettleOccupant(const FZone& Zone, FOccupant& Occupant, double Now);
+
+	/** Hand hazard damage to an actor */
+	static void DamageOccupant(AActor* Target, float Damage, AActor* Source);
+
+	double GetNow() const;
+
+	TArray<FZone> Zones;
+
+	FTimerHandle BatchTimer;
+};
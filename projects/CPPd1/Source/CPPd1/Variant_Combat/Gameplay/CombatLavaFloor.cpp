@@ -2,8 +2,10 @@
 
 
 #include "CombatLavaFloor.h"
-#include "CombatDamageable.h"
+#include "CombatHazardSubsystem.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/StaticMesh.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -12,16 +14,83 @@ ACombatLavaFloor::ACombatLavaFloor()
 	// create the mesh
 	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
-	// bind the hit handler
-	Mesh->OnComponentHit.AddDynamic(this, &ACombatLavaFloor::OnFloorHit);
+	// create the hazard volume. Blocking contacts with the mesh don't report overlaps, so damage uses a separate volume
+	HazardVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("Hazard Volume"));
+	HazardVolume->SetupAttachment(Mesh);
+	HazardVolume->SetCollisionProfileName(FName("OverlapAllDynamic"));
+
+	// bind the overlap handlers
+	HazardVolume->OnComponentBeginOverlap.AddDynamic(this, &ACombatLavaFloor::OnHazardBeginOverlap);
+	HazardVolume->OnComponentEndOverlap.AddDynamic(this, &ACombatLavaFloor::OnHazardEndOverlap);
+}
+
+void ACombatLavaFloor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// cover the mesh and reach HazardHeight above its top, in the mesh's local space
+	if (const UStaticMesh* StaticMesh = Mesh->GetStaticMesh())
+	{
+		const FBox Bounds = StaticMesh->GetBoundingBox();
+		const float LocalHeight = HazardHeight / FMath::Max(UE_KINDA_SMALL_NUMBER, float(Mesh->GetComponentScale().Z));
+
+		FVector Extent = Bounds.GetExtent();
+		Extent.Z += LocalHeight * 0.5f;
+
+		FVector Center = Bounds.GetCenter();
+		Center.Z += LocalHeight * 0.5f;
+
+		HazardVolume->SetBoxExtent(Extent, false);
+		HazardVolume->SetRelativeLocation(Center);
+	}
 }
 
-void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ACombatLavaFloor::BeginPlay()
 {
-	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	Super::BeginPlay();
+
+	if (UCombatHazardSubsystem* Hazards = UCombatHazardSubsystem::Get(this))
+	{
+		Hazards->AddZone(HazardVolume, DamagePerSecond);
+
+		// anything already standing in the lava when play starts
+		TArray<AActor*> Occupants;
+		HazardVolume->GetOverlappingActors(Occupants);
+		for (AActor* Occupant : Occupants)
+		{
+			Hazards->EnterZone(HazardVolume, Occupant);
+		}
+	}
+}
+
+void ACombatLavaFloor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatHazardSubsystem* Hazards = UCombatHazardSubsystem::Get(this))
+	{
+		Hazards->RemoveZone(HazardVolume);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatLavaFloor::OnHazardBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (UCombatHazardSubsystem* Hazards = UCombatHazardSubsystem::Get(this))
+	{
+		Hazards->EnterZone(HazardVolume, OtherActor);
+	}
+}
+
+void ACombatLavaFloor::OnHazardEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// still inside while any other component (capsule, mesh, a box cluster's pooled bodies) overlaps
+	if (HazardVolume->IsOverlappingActor(OtherActor))
+	{
+		return;
+	}
+
+	if (UCombatHazardSubsystem* Hazards = UCombatHazardSubsystem::Get(this))
 	{
-		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		Hazards->LeaveZone(HazardVolume, OtherActor);
 	}
 }
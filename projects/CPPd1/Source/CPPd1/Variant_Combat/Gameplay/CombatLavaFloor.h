@@ -7,10 +7,12 @@
 #include "CombatLavaFloor.generated.h"
 
 class UStaticMeshComponent;
+class UBoxComponent;
 class UPrimitiveComponent;
 
 /**
- *  A basic actor that applies damage on contact through the ICombatDamageable interface. 
+ *  A floor that damages anything standing in it through the ICombatDamageable interface.
+ *  Damage is applied over time by UCombatHazardSubsystem while actors overlap the hazard volume above the mesh.
  */
 UCLASS(abstract)
 class ACombatLavaFloor : public AActor
@@ -21,20 +23,36 @@ class ACombatLavaFloor : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
+	/** Overlap volume covering the top of the mesh. Sized from the mesh bounds on construction */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* HazardVolume;
+
 protected:
 
-	/** Amount of damage to deal on contact */
-	UPROPERTY(EditAnywhere, Category="Damage")
-	float Damage = 10000.0f;
+	/** Damage per second dealt to every actor in the lava */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.0f))
+	float DamagePerSecond = 10000.0f;
+
+	/** How far above the mesh surface the hazard volume reaches, so actors standing on the floor are inside it */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.0f, Units = "cm"))
+	float HazardHeight = 20.0f;
 
 public:	
 
 	/** Constructor */
 	ACombatLavaFloor();
 
+	virtual void OnConstruction(const FTransform& Transform) override;
+
 protected:
 
-	/** Blocking hit handler */
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Hazard volume overlap handlers */
+	UFUNCTION()
+	void OnHazardBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
 	UFUNCTION()
-	void OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	void OnHazardEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 };
@@ -33,4 +33,10 @@ public:
 	/** Handles healing events */
 	UFUNCTION(BlueprintCallable, Category="Damageable")
 	virtual void ApplyHealing(float Healing, AActor* Healer) = 0;
+
+	/** Handles damage over time from hazard zones. Defaults to ApplyDamage with no impulse */
+	virtual void ApplyHazardDamage(float Damage, AActor* Hazard, const FVector& DamageLocation)
+	{
+		ApplyDamage(Damage, Hazard, DamageLocation, FVector::ZeroVector);
+	}
 };
@@ -4,14 +4,14 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnhancedInputComponent.h"
 #include "Variant_Combat/CombatCharacter.h"
+#include "CombatInputRecorder.h"
+#include "CombatAssetLoader.h"
 #include "CPPd1LockOnTargetComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
 
 ANinjaCharacter::ANinjaCharacter()
 {
-	MovementSpeed = 400.0f;
-	RotationRate = 540.0f;
 	LockOnRotationSpeed = 450.0f;
 	LockOnRadius = 1800.0f;
 	DefaultCameraDistance = 300.0f;
@@ -22,9 +22,16 @@ void ANinjaCharacter::BeginPlay()
 	Super::BeginPlay();
 	// Set jump count - JumpMaxCount is a property of Character, not CharacterMovementComponent
 	JumpMaxCount = FMath::Max(1, JumpCountMax);
+}
 
-	// Start at relaxed walk speed
-	GetCharacterMovement()->MaxWalkSpeed = RelaxedWalkSpeed;
+void ANinjaCharacter::ApplyMovementTuning()
+{
+	Super::ApplyMovementTuning();
+
+	GetCharacterMovement()->RotationRate = FRotator(0.0f, NinjaRotationRate, 0.0f);
+
+	// the ninja walks or sprints depending on lock-on instead of using the profile's speed
+	GetCharacterMovement()->MaxWalkSpeed = LockOnTarget ? CombatSprintSpeed : RelaxedWalkSpeed;
 }
 
 void ANinjaCharacter::DoRoll()
@@ -201,19 +208,42 @@ void ANinjaCharacter::EndFlip()
 	}
 }
 
+void ANinjaCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	// the base class restores the mesh transform, so the flip rotation needs no undoing here
+	bIsRolling = false;
+	RollTimeRemaining = 0.0f;
+	bIsFlipping = false;
+	CurrentFlipType = ENinjaFlipType::None;
+	FlipElapsed = 0.0f;
+	bIsFlying = false;
+	bLastDealtDamageWhileFlipping = false;
+
+	Super::ResetForRespawn(SpawnTransform);
+
+	// lock-on is cleared, so back to the relaxed pace
+	GetCharacterMovement()->MaxWalkSpeed = RelaxedWalkSpeed;
+}
+
 void ANinjaCharacter::DoKick()
 {
-	if (bIsAttacking || !KickMontage) return;
+	if (bIsAttacking || KickMontage.IsNull()) return;
 	UAnimInstance* Anim = GetMesh()->GetAnimInstance();
 	if (Anim)
-		Anim->Montage_Play(KickMontage, 1.0f);
+		Anim->Montage_Play(UCombatAssetLoader::Resolve(KickMontage), 1.0f);
 	if (GhostCharacter)
 	{
 		ANinjaCharacter* G = Cast<ANinjaCharacter>(GhostCharacter);
-		if (G && G->KickMontage) G->DoKick();
+		if (G && !G->KickMontage.IsNull()) G->DoKick();
 	}
 }
 
+void ANinjaCharacter::GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	Super::GatherPreloadAssets(OutPaths);
+	OutPaths.Add(KickMontage.ToSoftObjectPath());
+}
+
 bool ANinjaCharacter::ConsumeLastHitWasDuringFlip()
 {
 	const bool b = bLastDealtDamageWhileFlipping;
@@ -296,6 +326,32 @@ void ANinjaCharacter::ToggleFlight()
 	}
 }
 
+void ANinjaCharacter::NinjaActionPressed(ECombatRecordedInput Input)
+{
+	if (CaptureInput(Input))
+	{
+		DispatchRecordedInput(Input, FVector2D::ZeroVector);
+	}
+}
+
+void ANinjaCharacter::DispatchRecordedInput(ECombatRecordedInput Input, const FVector2D& Value)
+{
+	switch (Input)
+	{
+	case ECombatRecordedInput::Roll:			DoRoll(); break;
+	case ECombatRecordedInput::Backflip:		DoBackflip(); break;
+	case ECombatRecordedInput::Frontflip:		DoFrontflip(); break;
+	case ECombatRecordedInput::SideflipLeft:	DoSideflipLeft(); break;
+	case ECombatRecordedInput::SideflipRight:	DoSideflipRight(); break;
+	case ECombatRecordedInput::Flip360:			DoFlip360(); break;
+	case ECombatRecordedInput::Kick:			DoKick(); break;
+	case ECombatRecordedInput::ToggleFlight:	ToggleFlight(); break;
+	default:
+		Super::DispatchRecordedInput(Input, Value);
+		break;
+	}
+}
+
 void ANinjaCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -304,19 +360,19 @@ void ANinjaCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComp
 	if (!EIC) return;
 
 	if (RollAction)
-		EIC->BindAction(RollAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoRoll);
+		EIC->BindAction(RollAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::Roll);
 	if (BackflipAction)
-		EIC->BindAction(BackflipAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoBackflip);
+		EIC->BindAction(BackflipAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::Backflip);
 	if (FrontflipAction)
-		EIC->BindAction(FrontflipAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoFrontflip);
+		EIC->BindAction(FrontflipAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::Frontflip);
 	if (SideflipLeftAction)
-		EIC->BindAction(SideflipLeftAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoSideflipLeft);
+		EIC->BindAction(SideflipLeftAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::SideflipLeft);
 	if (SideflipRightAction)
-		EIC->BindAction(SideflipRightAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoSideflipRight);
+		EIC->BindAction(SideflipRightAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::SideflipRight);
 	if (Flip360Action)
-		EIC->BindAction(Flip360Action, ETriggerEvent::Started, this, &ANinjaCharacter::DoFlip360);
+		EIC->BindAction(Flip360Action, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::Flip360);
 	if (KickAction)
-		EIC->BindAction(KickAction, ETriggerEvent::Started, this, &ANinjaCharacter::DoKick);
+		EIC->BindAction(KickAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::Kick);
 	if (FlightAction)
-		EIC->BindAction(FlightAction, ETriggerEvent::Started, this, &ANinjaCharacter::ToggleFlight);
+		EIC->BindAction(FlightAction, ETriggerEvent::Started, this, &ANinjaCharacter::NinjaActionPressed, ECombatRecordedInput::ToggleFlight);
 }
@@ -9,6 +9,7 @@
 
 class UInputAction;
 class UAnimMontage;
+enum class ECombatRecordedInput : uint8;
 
 /** Type of acrobatic flip (drives mesh rotation axis and total angle) */
 UENUM(BlueprintType)
@@ -95,7 +96,7 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Input")
 	TObjectPtr<UInputAction> KickAction;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ninja|Combat")
-	TObjectPtr<UAnimMontage> KickMontage;
+	TSoftObjectPtr<UAnimMontage> KickMontage;
 	UFUNCTION(BlueprintCallable, Category = "Ninja")
 	void DoKick();
 
@@ -106,6 +107,9 @@ public:
 	/** Sprint speed when locked on (original movement speed) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ninja|Movement")
 	float CombatSprintSpeed = 500.0f;
+	/** Turn rate in degrees per second, applied over the tuning profile's */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ninja|Movement")
+	float NinjaRotationRate = 540.0f;
 
 	// ---- DBZ Flight ----
 	UPROPERTY(EditAnywhere, Category = "Input|Flight")
@@ -123,6 +127,12 @@ public:
 
 	virtual void DoAttackTrace(FName DamageSourceBone) override;
 
+	/** Adds the kick montage to the combat character's preloads */
+	virtual void GatherPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const override;
+
+	/** Routes recorded ninja actions (roll, flips, kick, flight) before falling back to the base combat inputs */
+	virtual void DispatchRecordedInput(ECombatRecordedInput Input, const FVector2D& Value) override;
+
 protected:
 	/** Set when we deal damage while flipping; read by ConsumeLastHitWasDuringFlip for scoring. */
 	bool bLastDealtDamageWhileFlipping = false;
@@ -139,10 +149,19 @@ protected:
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	/** Shared handler for the ninja action bindings; records the action, then routes it */
+	void NinjaActionPressed(ECombatRecordedInput Input);
+
 	/** Start a flip (impulse + state). Can be called from ground or air. */
 	void StartFlip(ENinjaFlipType FlipType, const FVector& HorizontalDir);
 	/** Update mesh rotation for current flip; call when bIsFlipping. */
 	void UpdateFlipMeshRotation(float DeltaTime);
 	/** End flip and reset mesh. */
 	void EndFlip();
+
+	/** Applies the profile, then the ninja's own turn rate and walk speed */
+	virtual void ApplyMovementTuning() override;
+
+	/** Also lands any roll, flip or flight in progress */
+	virtual void ResetForRespawn(const FTransform& SpawnTransform) override;
 };
@@ -9,6 +9,8 @@
 #include "InputMappingContext.h"
 #include "Engine/LocalPlayer.h"
 #include "Blueprint/UserWidget.h"
+#include "CombatHitchDetector.h"
+#include "CombatAssetLoader.h"
 
 ANinjaPlayerController::ANinjaPlayerController()
 {
@@ -22,8 +24,8 @@ void ANinjaPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Create HUD dynamically if not already set
-	if (!HUDWidget && IsLocalPlayerController())
+	// Create HUD dynamically if no HUD class is set (the configured one may still be loading)
+	if (HUDWidgetClass.IsNull() && IsLocalPlayerController())
 	{
 		CreateDynamicHUD();
 	}
@@ -44,22 +46,26 @@ void ANinjaPlayerController::BeginPlay()
 
 void ANinjaPlayerController::ShowInputModeSelection()
 {
-	if (!InputModeSelectionWidgetClass || !IsLocalPlayerController())
+	if (InputModeSelectionWidgetClass.IsNull() || !IsLocalPlayerController())
 	{
 		return;
 	}
 
-	InputModeSelectionWidget = CreateWidget<UUserWidget>(this, InputModeSelectionWidgetClass);
-	if (InputModeSelectionWidget)
+	UCombatAssetLoader::LoadClassAsync(this, InputModeSelectionWidgetClass, [this](UClass* WidgetClass)
 	{
-		InputModeSelectionWidget->AddToPlayerScreen(100); // High z-order
-
-		// Bind to selection event if it's an InputModeSelection widget
-		if (UInputModeSelection* SelectionWidget = Cast<UInputModeSelection>(InputModeSelectionWidget))
+		InputModeSelectionWidget = CreateWidget<UUserWidget>(this, WidgetClass);
+		if (InputModeSelectionWidget)
 		{
-			SelectionWidget->OnInputModeSelected.AddDynamic(this, &ANinjaPlayerController::OnInputModeSelected);
+			UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WidgetCreated, InputModeSelectionWidget);
+			InputModeSelectionWidget->AddToPlayerScreen(100); // High z-order
+
+			// Bind to selection event if it's an InputModeSelection widget
+			if (UInputModeSelection* SelectionWidget = Cast<UInputModeSelection>(InputModeSelectionWidget))
+			{
+				SelectionWidget->OnInputModeSelected.AddDynamic(this, &ANinjaPlayerController::OnInputModeSelected);
+			}
 		}
-	}
+	});
 }
 
 void ANinjaPlayerController::OnInputModeSelected(EInputMode SelectedMode)
@@ -129,19 +135,25 @@ void ANinjaPlayerController::UpdateInputMappings()
 
 void ANinjaPlayerController::CreateControlsOverlay()
 {
-	if (!ControlsOverlayWidgetClass || !IsLocalPlayerController())
+	if (ControlsOverlayWidgetClass.IsNull() || !IsLocalPlayerController())
 	{
 		return;
 	}
 
-	ControlsOverlayWidget = CreateWidget<UControlsOverlay>(this, ControlsOverlayWidgetClass);
-	if (ControlsOverlayWidget)
+	UCombatAssetLoader::LoadClassAsync(this, ControlsOverlayWidgetClass, [this](UClass* WidgetClass)
 	{
-		ControlsOverlayWidget->SetInputMode(CurrentInputMode);
-		ControlsOverlayWidget->AddToPlayerScreen(10); // Lower z-order than HUD
-		// Start visible - player can toggle it
-		ControlsOverlayWidget->SetOverlayVisible(true);
-	}
+		ControlsOverlayWidget = CreateWidget<UControlsOverlay>(this, WidgetClass);
+		if (ControlsOverlayWidget)
+		{
+			UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WidgetCreated, ControlsOverlayWidget);
+
+			// the mode may have been picked while the class was loading
+			ControlsOverlayWidget->SetInputMode(CurrentInputMode);
+			ControlsOverlayWidget->AddToPlayerScreen(10); // Lower z-order than HUD
+			// Start visible - player can toggle it
+			ControlsOverlayWidget->SetOverlayVisible(true);
+		}
+	});
 }
 
 void ANinjaPlayerController::ToggleControlsOverlay()
@@ -167,11 +179,14 @@ void ANinjaPlayerController::CreateDynamicHUD()
 		return;
 	}
 
+	LLM_SCOPE_BYTAG(Combat_HUD);
+
 	// Create NinjaHUD widget dynamically
 	// Use the C++ class directly - no Blueprint required
 	UNinjaHUD* NinjaHUD = CreateWidget<UNinjaHUD>(this);
 	if (NinjaHUD)
 	{
+		UCombatHitchDetector::RecordEvent(this, ECombatHitchEvent::WidgetCreated, NinjaHUD);
 		HUDWidget = NinjaHUD;
 		HUDWidget->AddToPlayerScreen();
 
@@ -22,13 +22,13 @@ public:
 
 	virtual void BeginPlay() override;
 
-	/** Input mode selection widget class */
+	/** Input mode selection widget class. Soft: list it in the variant's Menu bundle so it is in before the map finishes loading */
 	UPROPERTY(EditAnywhere, Category = "UI|Input Selection")
-	TSubclassOf<class UUserWidget> InputModeSelectionWidgetClass;
+	TSoftClassPtr<class UUserWidget> InputModeSelectionWidgetClass;
 
-	/** Controls overlay widget class */
+	/** Controls overlay widget class. Soft: loaded in the background and created once it arrives */
 	UPROPERTY(EditAnywhere, Category = "UI|Controls")
-	TSubclassOf<UControlsOverlay> ControlsOverlayWidgetClass;
+	TSoftClassPtr<UControlsOverlay> ControlsOverlayWidgetClass;
 
 	/** Get current input mode */
 	UFUNCTION(BlueprintCallable, Category = "Input")
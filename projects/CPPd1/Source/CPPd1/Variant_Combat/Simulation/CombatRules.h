@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+/**
+ * Combat rules shared by the gameplay components and the headless simulator.
+ * Plain functions over plain values: no UObjects, no world, no time source.
+ * The components own the state and the timing; these only decide what the numbers are.
+ */
+namespace CombatRules
+{
+	// ========== Stamina ==========
+
+	/** Stamina tuning as the rules see it */
+	struct FStaminaParams
+	{
+		float MaxStamina = 1.0f;
+		float BaseRecoveryRate = 0.2f;
+		float ExhaustedRecoveryRate = 0.05f;
+		float ExhaustionThreshold = 0.2f;
+
+		/** Skill-based efficiency: scales recovery up and drain down */
+		float Efficiency = 1.0f;
+	};
+
+	/** Stamina actually removed by a drain of Amount */
+	inline float StaminaDrainCost(const FStaminaParams& Params, float Amount)
+	{
+		return Amount / Params.Efficiency;
+	}
+
+	/** Stamina after recovering for Elapsed seconds: exhausted rate up to the threshold, then base rate up to max */
+	inline float RecoverStamina(const FStaminaParams& Params, float Stamina, float Elapsed)
+	{
+		if (Elapsed <= 0.0f || Stamina >= Params.MaxStamina)
+		{
+			return Stamina;
+		}
+
+		// slow recovery while at or below the exhaustion threshold
+		if (Stamina <= Params.ExhaustionThreshold)
+		{
+			const float ExhaustedRate = Params.ExhaustedRecoveryRate * Params.Efficiency;
+			if (ExhaustedRate <= 0.0f)
+			{
+				return Stamina;
+			}
+
+			const float TimeToThreshold = (Params.ExhaustionThreshold - Stamina) / ExhaustedRate;
+			if (Elapsed <= TimeToThreshold)
+			{
+				return Stamina + ExhaustedRate * Elapsed;
+			}
+
+			Stamina = Params.ExhaustionThreshold;
+			Elapsed -= TimeToThreshold;
+		}
+
+		return FMath::Min(Params.MaxStamina, Stamina + Params.BaseRecoveryRate * Params.Efficiency * Elapsed);
+	}
+
+	inline bool IsExhausted(const FStaminaParams& Params, float Stamina)
+	{
+		return Stamina <= Params.ExhaustionThreshold;
+	}
+
+	// ========== Flow ==========
+
+	/** Flow after decaying for Elapsed seconds */
+	inline float DecayFlow(float Flow, float DecayRate, float Elapsed)
+	{
+		return FMath::Max(0.0f, Flow - DecayRate * FMath::Max(0.0f, Elapsed));
+	}
+
+	/** Flow gained by the ComboCount-th hit of a combo (longer combos earn more) */
+	inline float ComboFlowGain(int32 ComboCount, float ComboFlowPoints)
+	{
+		return ComboFlowPoints * ComboCount;
+	}
+
+	/** Damage/speed multiplier from the flow meter */
+	inline float FlowMultiplier(float Flow, float FlowStateThreshold, float FlowStateMultiplier)
+	{
+		return Flow >= FlowStateThreshold ? FlowStateMultiplier : 1.0f;
+	}
+
+	// ========== Parry / block ==========
+
+	/** Where a parry landed inside the window */
+	enum class EParryTiming : uint8
+	{
+		Outside,
+		Perfect,
+		Good
+	};
+
+	/** Classify a parry Elapsed seconds after the window opened */
+	inline EParryTiming ClassifyParry(float Elapsed, float PerfectWindow, float GoodWindow)
+	{
+		if (Elapsed < 0.0f || Elapsed > GoodWindow)
+		{
+			return EParryTiming::Outside;
+		}
+		return Elapsed <= PerfectWindow ? EParryTiming::Perfect : EParryTiming::Good;
+	}
+
+	/** Damage left after a block with the given effectiveness (fraction removed) */
+	inline float BlockedDamage(float Damage, float BlockEffectiveness)
+	{
+		return Damage * (1.0f - FMath::Clamp(BlockEffectiveness, 0.0f, 1.0f));
+	}
+
+	// ========== Skill ==========
+
+	/** Highest skill level */
+	constexpr float MaxSkillLevel = 100.0f;
+
+	/** XP cost of each level grows by this factor (k levels from now cost ExperienceToNextLevel * Growth^k) */
+	constexpr float SkillXPGrowth = 1.1f;
+
+	constexpr int32 MaxSkillLevels = 100;
+
+	/** Growth^k and the summed cost of k levels, both in units of the current ExperienceToNextLevel */
+	struct FSkillXPTable
+	{
+		float Scale[MaxSkillLevels + 1] = {};
+		float Cumulative[MaxSkillLevels + 1] = {};
+	};
+
+	constexpr FSkillXPTable MakeSkillXPTable()
+	{
+		FSkillXPTable Table;
+		float Scale = 1.0f;
+		float Cumulative = 0.0f;
+		for (int32 Levels = 0; Levels <= MaxSkillLevels; ++Levels)
+		{
+			Table.Scale[Levels] = Scale;
+			Table.Cumulative[Levels] = Cumulative;
+			Cumulative += Scale;
+			Scale *= SkillXPGrowth;
+		}
+		return Table;
+	}
+
+	constexpr FSkillXPTable SkillXPTable = MakeSkillXPTable();
+
+	/**
+	 * Apply every level the banked experience pays for, in one step.
+	 * Returns the number of levels gained (0 if none).
+	 */
+	inline int32 ApplySkillLevelUps(float& SkillLevel, float& Experience, float& ExperienceToNextLevel)
+	{
+		const int32 LevelsLeft = FMath::Clamp(FMath::CeilToInt(MaxSkillLevel - SkillLevel), 0, MaxSkillLevels);
+		if (LevelsLeft == 0 || ExperienceToNextLevel <= 0.0f || Experience < ExperienceToNextLevel)
+		{
+			return 0;
+		}
+
+		// last table entry whose summed cost fits in the banked experience; one level always fits
+		const float Banked = Experience / ExperienceToNextLevel;
+		const int32 Levels = FMath::Max(1, Algo::UpperBound(MakeArrayView(SkillXPTable.Cumulative, LevelsLeft + 1), Banked) - 1);
+
+		Experience = FMath::Max(0.0f, Experience - ExperienceToNextLevel * SkillXPTable.Cumulative[Levels]);
+		SkillLevel = FMath::Min(MaxSkillLevel, SkillLevel + Levels);
+		ExperienceToNextLevel *= SkillXPTable.Scale[Levels];
+		return Levels;
+	}
+
+	/** Striking: outgoing damage multiplier */
+	inline float StrikingDamageMultiplier(float SkillLevel, float BaseMultiplier, float MaxMultiplier)
+	{
+		return FMath::Lerp(BaseMultiplier, MaxMultiplier, SkillLevel / 100.0f);
+	}
+
+	/** Defense: block effectiveness */
+	inline float DefenseEffectiveness(float SkillLevel, float BaseEffectiveness, float MaxEffectiveness)
+	{
+		return FMath::Lerp(BaseEffectiveness, MaxEffectiveness, SkillLevel / 100.0f);
+	}
+
+	/** Stamina: efficiency, 0.5x drain at max level */
+	inline float StaminaEfficiency(float SkillLevel)
+	{
+		return 1.0f - (SkillLevel / 200.0f);
+	}
+
+	/** Technique: combo execution accuracy, 0.0 to 1.0 */
+	inline float TechniqueAccuracy(float SkillLevel)
+	{
+		return SkillLevel / 100.0f;
+	}
+
+	/** Flow: trick chaining multiplier, 1.0x to 3.0x at max */
+	inline float FlowSkillMultiplier(float SkillLevel)
+	{
+		return 1.0f + (SkillLevel / 50.0f);
+	}
+}
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSimulateCommandlet.h"
+#include "CombatSimulation.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCombatSimulateCommandlet::UCombatSimulateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatSimulateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	FCombatSimConfig Config;
+
+	if (const FString* CharacterPath = ParamValues.Find(TEXT("Character")))
+	{
+		UClass* CharacterClass = LoadClass<ACombatCharacter>(nullptr, **CharacterPath);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("CombatSimulate: could not load character class %s"), **CharacterPath);
+			return 1;
+		}
+		GetDefault<ACombatCharacter>(CharacterClass)->ExportSimulationTuning(Config.Player);
+	}
+
+	if (const FString* EnemyPath = ParamValues.Find(TEXT("Enemy")))
+	{
+		UClass* EnemyClass = LoadClass<ACombatEnemy>(nullptr, **EnemyPath);
+		if (!EnemyClass)
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("CombatSimulate: could not load enemy class %s"), **EnemyPath);
+			return 1;
+		}
+		GetDefault<ACombatEnemy>(EnemyClass)->ExportSimulationTuning(Config.Enemy);
+	}
+
+	int32 NumFights = 10000;
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Fights="), NumFights);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Step="), Config.TimeStep);
+	FParse::Value(*Params, TEXT("MaxTime="), Config.MaxFightTime);
+
+	if (NumFights <= 0 || Config.TimeStep <= 0.0f)
+	{
+		UE_LOG(LogCPPd1, Error, TEXT("CombatSimulate: -Fights and -Step must be positive"));
+		return 1;
+	}
+
+	const FCombatSimStats Stats = FCombatSimulation::RunBatch(Config, NumFights, Seed);
+	UE_LOG(LogCPPd1, Display, TEXT("CombatSimulate:\n%s"), *Stats.ToString());
+
+	if (const FString* OutPath = ParamValues.Find(TEXT("Out")))
+	{
+		const FString Filename = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), *OutPath);
+		const FString Csv = FCombatSimStats::GetCsvHeader() + LINE_TERMINATOR + Stats.ToCsvRow() + LINE_TERMINATOR;
+		if (!FFileHelper::SaveStringToFile(Csv, *Filename))
+		{
+			UE_LOG(LogCPPd1, Error, TEXT("CombatSimulate: failed to write %s"), *Filename);
+			return 1;
+		}
+		UE_LOG(LogCPPd1, Display, TEXT("CombatSimulate: wrote %s"), *Filename);
+	}
+
+	return 0;
+}
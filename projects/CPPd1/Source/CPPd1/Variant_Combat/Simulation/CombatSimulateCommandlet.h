@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatSimulateCommandlet.generated.h"
+
+/**
+ * Runs a batch of headless combat simulations and prints (and optionally saves) the aggregated stats.
+ *
+ * UnrealEditor-Cmd CPPd1.uproject -run=CombatSimulate [-Fights=10000] [-Seed=1] [-Step=0.0166] [-MaxTime=120] [-Out=Saved/CombatSim.csv]
+ *     [-Character=/Game/Variant_Combat/Blueprints/BP_CombatCharacter.BP_CombatCharacter_C] [-Enemy=/Game/Variant_Combat/Blueprints/AI/BP_CombatEnemy.BP_CombatEnemy_C]
+ *
+ * -Character and -Enemy read the tuning from those classes' defaults instead of the simulator defaults.
+ */
+UCLASS()
+class CPPd1_API UCombatSimulateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCombatSimulateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
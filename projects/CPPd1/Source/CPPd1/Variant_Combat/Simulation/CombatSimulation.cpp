@@ -0,0 +1,541 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSimulation.h"
+#include "CombatRules.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Fights per parallel work item. Fixed so results don't depend on the core count */
+	constexpr int32 FightsPerChunk = 64;
+
+	CombatRules::FStaminaParams MakeStaminaParams(const FCombatSimFighterTuning& Tuning, float Efficiency)
+	{
+		CombatRules::FStaminaParams Params;
+		Params.MaxStamina = Tuning.MaxStamina;
+		Params.BaseRecoveryRate = Tuning.BaseStaminaRecoveryRate;
+		Params.ExhaustedRecoveryRate = Tuning.ExhaustedStaminaRecoveryRate;
+		Params.ExhaustionThreshold = Tuning.ExhaustionThreshold;
+		Params.Efficiency = Efficiency;
+		return Params;
+	}
+}
+
+FCombatSimConfig::FCombatSimConfig()
+{
+	// player: the full set of combat components, always finishes its combo string
+	Player.bHasCombatSystems = true;
+	Player.MaxHP = 5.0f;
+	Player.InvincibilityFrames = 0.5f;
+
+	// enemy: plain HP, random combo length, flinches when hit
+	Enemy.MaxHP = 3.0f;
+	Enemy.bRandomComboLength = true;
+	Enemy.bInterruptedByHits = true;
+	Enemy.ComboStages = 4;
+	Enemy.ChargedAttackChance = 0.3f;
+	Enemy.MinAttackInterval = 1.0f;
+	Enemy.MaxAttackInterval = 3.0f;
+}
+
+// ========== Stats ==========
+
+void FCombatSimStats::Add(const FCombatSimFightResult& Result)
+{
+	++NumFights;
+	switch (Result.Winner)
+	{
+	case FCombatSimFightResult::EWinner::Player: ++PlayerWins; break;
+	case FCombatSimFightResult::EWinner::Enemy: ++EnemyWins; break;
+	default: ++Draws; break;
+	}
+
+	TotalDuration += Result.Duration;
+	TotalDurationSquared += double(Result.Duration) * Result.Duration;
+	MinDuration = FMath::Min(MinDuration, Result.Duration);
+	MaxDuration = FMath::Max(MaxDuration, Result.Duration);
+
+	TotalPlayerHPLeft += Result.PlayerHPLeft;
+	TotalPlayerHits += Result.PlayerHits;
+	TotalEnemyHits += Result.EnemyHits;
+	TotalPlayerDamage += Result.PlayerDamageDealt;
+	TotalEnemyDamage += Result.EnemyDamageDealt;
+	TotalPerfectParries += Result.PerfectParries;
+	TotalGoodParries += Result.GoodParries;
+	TotalBlocks += Result.Blocks;
+	TotalExhaustions += Result.Exhaustions;
+	TotalTimeInFlowState += Result.TimeInFlowState;
+	TotalFinalStrikingLevel += Result.FinalStrikingLevel;
+	MaxCombo = FMath::Max(MaxCombo, Result.MaxCombo);
+}
+
+void FCombatSimStats::Merge(const FCombatSimStats& Other)
+{
+	NumFights += Other.NumFights;
+	PlayerWins += Other.PlayerWins;
+	EnemyWins += Other.EnemyWins;
+	Draws += Other.Draws;
+
+	TotalDuration += Other.TotalDuration;
+	TotalDurationSquared += Other.TotalDurationSquared;
+	MinDuration = FMath::Min(MinDuration, Other.MinDuration);
+	MaxDuration = FMath::Max(MaxDuration, Other.MaxDuration);
+
+	TotalPlayerHPLeft += Other.TotalPlayerHPLeft;
+	TotalPlayerHits += Other.TotalPlayerHits;
+	TotalEnemyHits += Other.TotalEnemyHits;
+	TotalPlayerDamage += Other.TotalPlayerDamage;
+	TotalEnemyDamage += Other.TotalEnemyDamage;
+	TotalPerfectParries += Other.TotalPerfectParries;
+	TotalGoodParries += Other.TotalGoodParries;
+	TotalBlocks += Other.TotalBlocks;
+	TotalExhaustions += Other.TotalExhaustions;
+	TotalTimeInFlowState += Other.TotalTimeInFlowState;
+	TotalFinalStrikingLevel += Other.TotalFinalStrikingLevel;
+	MaxCombo = FMath::Max(MaxCombo, Other.MaxCombo);
+}
+
+double FCombatSimStats::GetDurationStdDev() const
+{
+	if (NumFights == 0)
+	{
+		return 0.0;
+	}
+
+	const double Mean = TotalDuration / NumFights;
+	return FMath::Sqrt(FMath::Max(0.0, TotalDurationSquared / NumFights - Mean * Mean));
+}
+
+FString FCombatSimStats::ToString() const
+{
+	const double Percent = NumFights > 0 ? 100.0 / NumFights : 0.0;
+
+	FString Out;
+	Out += FString::Printf(TEXT("Fights: %d in %.2fs (%.0f fights/s)\n"), NumFights, WallSeconds, WallSeconds > 0.0 ? NumFights / WallSeconds : 0.0);
+	Out += FString::Printf(TEXT("Player wins: %.1f%%  Enemy wins: %.1f%%  Draws: %.1f%%\n"), PlayerWins * Percent, EnemyWins * Percent, Draws * Percent);
+	Out += FString::Printf(TEXT("Duration: mean %.2fs  stddev %.2fs  min %.2fs  max %.2fs\n"), GetMean(TotalDuration), GetDurationStdDev(), NumFights > 0 ? MinDuration : 0.0f, MaxDuration);
+	Out += FString::Printf(TEXT("Player HP left: %.2f  Hits: player %.2f / enemy %.2f  Damage: player %.2f / enemy %.2f\n"),
+		GetMean(TotalPlayerHPLeft), GetMean(TotalPlayerHits), GetMean(TotalEnemyHits), GetMean(TotalPlayerDamage), GetMean(TotalEnemyDamage));
+	Out += FString::Printf(TEXT("Parries: perfect %.2f / good %.2f  Blocks: %.2f  Exhaustions: %.2f\n"),
+		GetMean(TotalPerfectParries), GetMean(TotalGoodParries), GetMean(TotalBlocks), GetMean(TotalExhaustions));
+	Out += FString::Printf(TEXT("Flow state: %.2fs per fight  Max combo: %d  Final striking level: %.2f"),
+		GetMean(TotalTimeInFlowState), MaxCombo, GetMean(TotalFinalStrikingLevel));
+	return Out;
+}
+
+FString FCombatSimStats::GetCsvHeader()
+{
+	return TEXT("Fights,PlayerWinRate,EnemyWinRate,DrawRate,MeanDuration,StdDevDuration,MinDuration,MaxDuration,MeanPlayerHPLeft,MeanPlayerHits,MeanEnemyHits,MeanPlayerDamage,MeanEnemyDamage,MeanPerfectParries,MeanGoodParries,MeanBlocks,MeanExhaustions,MeanFlowStateTime,MaxCombo,MeanFinalStrikingLevel,WallSeconds");
+}
+
+FString FCombatSimStats::ToCsvRow() const
+{
+	const double Rate = NumFights > 0 ? 1.0 / NumFights : 0.0;
+	return FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%.4f,%.4f"),
+		NumFights, PlayerWins * Rate, EnemyWins * Rate, Draws * Rate,
+		GetMean(TotalDuration), GetDurationStdDev(), NumFights > 0 ? MinDuration : 0.0f, MaxDuration,
+		GetMean(TotalPlayerHPLeft), GetMean(TotalPlayerHits), GetMean(TotalEnemyHits), GetMean(TotalPlayerDamage), GetMean(TotalEnemyDamage),
+		GetMean(TotalPerfectParries), GetMean(TotalGoodParries), GetMean(TotalBlocks), GetMean(TotalExhaustions),
+		GetMean(TotalTimeInFlowState), MaxCombo, GetMean(TotalFinalStrikingLevel), WallSeconds);
+}
+
+// ========== Simulation ==========
+
+FCombatSimulation::FCombatSimulation(const FCombatSimConfig& InConfig, int32 Seed)
+	: Config(InConfig)
+	, Random(Seed)
+{
+	InitFighter(Player, Config.Player);
+	InitFighter(Enemy, Config.Enemy);
+}
+
+FCombatSimFightResult FCombatSimulation::Run()
+{
+	while (Step())
+	{
+	}
+
+	Result.Duration = Time;
+	Result.PlayerHPLeft = FMath::Max(0.0f, Player.HP);
+	Result.EnemyHPLeft = FMath::Max(0.0f, Enemy.HP);
+	Result.FinalStrikingLevel = Player.SkillLevel[Skill_Striking];
+
+	if (Enemy.HP <= 0.0f)
+	{
+		Result.Winner = FCombatSimFightResult::EWinner::Player;
+	}
+	else if (Player.HP <= 0.0f)
+	{
+		Result.Winner = FCombatSimFightResult::EWinner::Enemy;
+	}
+	else
+	{
+		Result.Winner = FCombatSimFightResult::EWinner::Draw;
+	}
+
+	return Result;
+}
+
+bool FCombatSimulation::Step()
+{
+	if (Player.HP <= 0.0f || Enemy.HP <= 0.0f || Time >= Config.MaxFightTime)
+	{
+		return false;
+	}
+
+	const float DeltaTime = Config.TimeStep;
+	Time += DeltaTime;
+
+	UpdateFighter(Player, DeltaTime);
+	UpdateFighter(Enemy, DeltaTime);
+
+	// player acts first within a step; a dead enemy doesn't get its swing in
+	UpdateAction(Player, Enemy, true);
+	UpdateAction(Enemy, Player, false);
+
+	return Player.HP > 0.0f && Enemy.HP > 0.0f && Time < Config.MaxFightTime;
+}
+
+FCombatSimStats FCombatSimulation::RunBatch(const FCombatSimConfig& Config, int32 NumFights, int32 BaseSeed)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(FMath::Max(0, NumFights), FightsPerChunk);
+	TArray<FCombatSimStats> ChunkStats;
+	ChunkStats.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&Config, &ChunkStats, NumFights, BaseSeed](int32 Chunk)
+	{
+		const int32 First = Chunk * FightsPerChunk;
+		const int32 Last = FMath::Min(NumFights, First + FightsPerChunk);
+		for (int32 FightIndex = First; FightIndex < Last; ++FightIndex)
+		{
+			FCombatSimulation Simulation(Config, BaseSeed + FightIndex);
+			ChunkStats[Chunk].Add(Simulation.Run());
+		}
+	});
+
+	// merge in chunk order so the totals are identical run to run
+	FCombatSimStats Stats;
+	for (const FCombatSimStats& Chunk : ChunkStats)
+	{
+		Stats.Merge(Chunk);
+	}
+	Stats.WallSeconds = FPlatformTime::Seconds() - StartTime;
+	return Stats;
+}
+
+void FCombatSimulation::InitFighter(FFighter& Fighter, const FCombatSimFighterTuning& Tuning)
+{
+	Fighter.Tuning = &Tuning;
+	Fighter.HP = Tuning.MaxHP;
+	Fighter.Stamina = Tuning.MaxStamina;
+	Fighter.NextActionTime = Random.FRandRange(Tuning.MinAttackInterval, Tuning.MaxAttackInterval);
+
+	for (int32 Skill = 0; Skill < UE_ARRAY_COUNT(Fighter.SkillLevel); ++Skill)
+	{
+		Fighter.SkillLevel[Skill] = Tuning.StartingSkillLevel;
+		Fighter.SkillXPToNext[Skill] = 100.0f;
+	}
+
+	// the sim doesn't train the stamina skill, so its efficiency stays at the starting level
+	Fighter.StaminaEfficiency = CombatRules::StaminaEfficiency(Tuning.StartingSkillLevel);
+}
+
+void FCombatSimulation::UpdateFighter(FFighter& Fighter, float DeltaTime)
+{
+	const FCombatSimFighterTuning& Tuning = *Fighter.Tuning;
+	Fighter.TimeSinceDamage += DeltaTime;
+
+	if (!Tuning.bHasCombatSystems || Fighter.HP <= 0.0f)
+	{
+		return;
+	}
+
+	const CombatRules::FStaminaParams StaminaParams = MakeStaminaParams(Tuning, Fighter.StaminaEfficiency);
+
+	// stamina: drain while holding a block, otherwise recover once the delay has passed
+	if (Time <= Fighter.BlockUntil)
+	{
+		Fighter.Stamina = FMath::Max(0.0f, Fighter.Stamina - CombatRules::StaminaDrainCost(StaminaParams, Tuning.BlockStaminaDrainRate * DeltaTime));
+	}
+	else if (Time > Fighter.RecoveryStartTime)
+	{
+		const float Elapsed = FMath::Min(DeltaTime, Time - Fighter.RecoveryStartTime);
+		Fighter.Stamina = CombatRules::RecoverStamina(StaminaParams, Fighter.Stamina, Elapsed);
+	}
+
+	const bool bExhausted = CombatRules::IsExhausted(StaminaParams, Fighter.Stamina);
+	if (bExhausted && !Fighter.bExhausted && &Fighter == &Player)
+	{
+		++Result.Exhaustions;
+	}
+	Fighter.bExhausted = bExhausted;
+
+	// exhaustion drops the block
+	if (bExhausted)
+	{
+		Fighter.BlockUntil = FMath::Min(Fighter.BlockUntil, Time);
+	}
+
+	// flow decays; the combo resets after a quiet spell
+	Fighter.Flow = CombatRules::DecayFlow(Fighter.Flow, Tuning.FlowDecayRate, DeltaTime);
+	if (Fighter.Flow >= Tuning.FlowStateThreshold && &Fighter == &Player)
+	{
+		Result.TimeInFlowState += DeltaTime;
+	}
+
+	if (Fighter.FlowCombo > 0 && Time - Fighter.LastComboHitTime > Tuning.ComboResetTime)
+	{
+		Fighter.FlowCombo = 0;
+	}
+}
+
+void FCombatSimulation::UpdateAction(FFighter& Attacker, FFighter& Defender, bool bAttackerIsPlayer)
+{
+	if (Attacker.HP <= 0.0f || Defender.HP <= 0.0f)
+	{
+		return;
+	}
+
+	const FCombatSimFighterTuning& Tuning = *Attacker.Tuning;
+	const float StageDuration = Tuning.ComboStageDuration;
+	const float HitTime = Tuning.HitTimeFraction * StageDuration;
+
+	switch (Attacker.Action)
+	{
+	case EAction::Idle:
+		if (Time >= Attacker.NextActionTime)
+		{
+			StartAttack(Attacker);
+		}
+		break;
+
+	case EAction::Combo:
+	{
+		Attacker.ActionTime += Config.TimeStep;
+		const float StageTime = Attacker.ActionTime - Attacker.ComboStage * StageDuration;
+
+		if (Attacker.bHitPending && StageTime >= HitTime)
+		{
+			Attacker.bHitPending = false;
+			ResolveHit(Attacker, Defender, bAttackerIsPlayer, 1.0f);
+		}
+
+		// the hit may have interrupted us
+		if (Attacker.Action == EAction::Combo && StageTime >= StageDuration)
+		{
+			++Attacker.ComboStage;
+
+			// next stage needs the stamina for another light attack
+			const bool bCanContinue = !Tuning.bHasCombatSystems || Attacker.Stamina >= Tuning.LightAttackStaminaCost;
+			if (Attacker.ComboStage >= Attacker.ComboTarget || !bCanContinue)
+			{
+				if (Tuning.bHasCombatSystems && Attacker.ComboStage >= Attacker.ComboTarget)
+				{
+					Attacker.PendingXP[Skill_Technique] += Tuning.TechniqueXPPerCombo;
+				}
+				EndAttack(Attacker);
+			}
+			else
+			{
+				if (Tuning.bHasCombatSystems)
+				{
+					DrainStamina(Attacker, Tuning.LightAttackStaminaCost);
+				}
+				Attacker.bHitPending = true;
+			}
+		}
+		break;
+	}
+
+	case EAction::Charged:
+		Attacker.ActionTime += Config.TimeStep;
+
+		if (Attacker.bHitPending && Attacker.ActionTime >= Attacker.ChargeTime + HitTime)
+		{
+			Attacker.bHitPending = false;
+			ResolveHit(Attacker, Defender, bAttackerIsPlayer, Tuning.ChargedDamageMultiplier);
+		}
+
+		if (Attacker.Action == EAction::Charged && Attacker.ActionTime >= Attacker.ChargeTime + StageDuration)
+		{
+			EndAttack(Attacker);
+		}
+		break;
+	}
+}
+
+void FCombatSimulation::StartAttack(FFighter& Fighter)
+{
+	const FCombatSimFighterTuning& Tuning = *Fighter.Tuning;
+
+	const bool bWantsCharged = Random.FRand() < Tuning.ChargedAttackChance;
+	const float Cost = bWantsCharged ? Tuning.HeavyAttackStaminaCost : Tuning.LightAttackStaminaCost;
+
+	// not enough stamina: wait a little and try again
+	if (Tuning.bHasCombatSystems && Fighter.Stamina < Cost)
+	{
+		Fighter.NextActionTime = Time + 0.1f;
+		return;
+	}
+
+	Fighter.ActionTime = 0.0f;
+	Fighter.ComboStage = 0;
+	Fighter.bHitPending = true;
+
+	if (bWantsCharged)
+	{
+		Fighter.Action = EAction::Charged;
+		Fighter.ChargeTime = Random.RandRange(Tuning.MinChargeLoops, FMath::Max(Tuning.MinChargeLoops, Tuning.MaxChargeLoops)) * Tuning.ChargeLoopDuration;
+	}
+	else
+	{
+		Fighter.Action = EAction::Combo;
+		Fighter.ComboTarget = Tuning.bRandomComboLength ? Random.RandRange(1, FMath::Max(1, Tuning.ComboStages - 1)) : FMath::Max(1, Tuning.ComboStages);
+	}
+
+	if (Tuning.bHasCombatSystems)
+	{
+		DrainStamina(Fighter, Cost);
+	}
+}
+
+void FCombatSimulation::EndAttack(FFighter& Fighter)
+{
+	const FCombatSimFighterTuning& Tuning = *Fighter.Tuning;
+
+	Fighter.Action = EAction::Idle;
+	Fighter.bHitPending = false;
+	Fighter.NextActionTime = Time + Random.FRandRange(Tuning.MinAttackInterval, Tuning.MaxAttackInterval);
+
+	// everything the attack earned goes in as one batch
+	if (Tuning.bHasCombatSystems)
+	{
+		FlushExperience(Fighter);
+	}
+}
+
+void FCombatSimulation::ResolveHit(FFighter& Attacker, FFighter& Defender, bool bAttackerIsPlayer, float DamageScale)
+{
+	const FCombatSimFighterTuning& AttackerTuning = *Attacker.Tuning;
+	const FCombatSimFighterTuning& DefenderTuning = *Defender.Tuning;
+
+	float Damage = AttackerTuning.MeleeDamage * AttackerTuning.GlobalDamageMultiplier * DamageScale;
+
+	if (AttackerTuning.bHasCombatSystems)
+	{
+		if (AttackerTuning.bApplySkillAndFlowToDamage)
+		{
+			Damage *= CombatRules::StrikingDamageMultiplier(Attacker.SkillLevel[Skill_Striking], AttackerTuning.BaseDamageMultiplier, AttackerTuning.MaxDamageMultiplier);
+			Damage *= CombatRules::FlowMultiplier(Attacker.Flow, AttackerTuning.FlowStateThreshold, AttackerTuning.FlowStateMultiplier);
+		}
+
+		// counter-attack after a parry
+		if (Time <= Attacker.CounterUntil)
+		{
+			Damage *= Attacker.CounterMultiplier;
+			Attacker.CounterUntil = -1.0f;
+		}
+	}
+
+	// defender reactions: only while not mid-attack
+	if (DefenderTuning.bHasCombatSystems && Defender.Action == EAction::Idle)
+	{
+		if (Random.FRand() < DefenderTuning.ParryChance)
+		{
+			const float Elapsed = Random.FRand() * DefenderTuning.ParryTimingSpread;
+			const CombatRules::EParryTiming Timing = CombatRules::ClassifyParry(Elapsed, DefenderTuning.PerfectParryWindow, DefenderTuning.GoodParryWindow);
+			if (Timing != CombatRules::EParryTiming::Outside)
+			{
+				const bool bPerfect = Timing == CombatRules::EParryTiming::Perfect;
+				Defender.CounterUntil = Time + DefenderTuning.CounterAttackWindow;
+				Defender.CounterMultiplier = bPerfect ? DefenderTuning.PerfectParryDamageMultiplier : 1.0f;
+				Defender.PendingXP[Skill_Defense] += DefenderTuning.DefenseXPPerParry;
+				FlushExperience(Defender);
+
+				if (!bAttackerIsPlayer)
+				{
+					bPerfect ? ++Result.PerfectParries : ++Result.GoodParries;
+				}
+				return;
+			}
+		}
+
+		if (!Defender.bExhausted && Random.FRand() < DefenderTuning.BlockChance)
+		{
+			Defender.BlockUntil = FMath::Max(Defender.BlockUntil, Time + DefenderTuning.BlockHoldTime);
+			Defender.RecoveryStartTime = FMath::Max(Defender.RecoveryStartTime, Defender.BlockUntil + DefenderTuning.StaminaRecoveryDelay);
+			Damage = CombatRules::BlockedDamage(Damage, CombatRules::DefenseEffectiveness(Defender.SkillLevel[Skill_Defense], DefenderTuning.BaseDefenseEffectiveness, DefenderTuning.MaxDefenseEffectiveness));
+
+			if (!bAttackerIsPlayer)
+			{
+				++Result.Blocks;
+			}
+		}
+	}
+
+	// invincibility frames, then the defender's own defense multiplier
+	if (Defender.TimeSinceDamage < DefenderTuning.InvincibilityFrames)
+	{
+		return;
+	}
+
+	Damage *= DefenderTuning.GlobalDefenseMultiplier;
+	Defender.HP -= Damage;
+	Defender.TimeSinceDamage = 0.0f;
+
+	if (bAttackerIsPlayer)
+	{
+		++Result.PlayerHits;
+		Result.PlayerDamageDealt += Damage;
+	}
+	else
+	{
+		++Result.EnemyHits;
+		Result.EnemyDamageDealt += Damage;
+	}
+
+	// landed hits build the attacker's combo, flow and striking XP
+	if (AttackerTuning.bHasCombatSystems)
+	{
+		++Attacker.FlowCombo;
+		Attacker.LastComboHitTime = Time;
+		Attacker.Flow = FMath::Min(AttackerTuning.MaxFlow, Attacker.Flow + CombatRules::ComboFlowGain(Attacker.FlowCombo, AttackerTuning.ComboFlowPoints));
+		Attacker.PendingXP[Skill_Striking] += AttackerTuning.StrikingXPPerHit;
+
+		if (bAttackerIsPlayer)
+		{
+			Result.MaxCombo = FMath::Max(Result.MaxCombo, Attacker.FlowCombo);
+		}
+	}
+
+	if (DefenderTuning.bInterruptedByHits && Defender.Action != EAction::Idle && Defender.HP > 0.0f)
+	{
+		EndAttack(Defender);
+	}
+}
+
+void FCombatSimulation::DrainStamina(FFighter& Fighter, float Amount)
+{
+	const FCombatSimFighterTuning& Tuning = *Fighter.Tuning;
+	const CombatRules::FStaminaParams StaminaParams = MakeStaminaParams(Tuning, Fighter.StaminaEfficiency);
+
+	Fighter.Stamina = FMath::Max(0.0f, Fighter.Stamina - CombatRules::StaminaDrainCost(StaminaParams, Amount));
+	Fighter.RecoveryStartTime = FMath::Max(Fighter.RecoveryStartTime, Time + Tuning.StaminaRecoveryDelay);
+}
+
+void FCombatSimulation::FlushExperience(FFighter& Fighter)
+{
+	const float Multiplier = Fighter.Tuning->ExperienceMultiplier;
+	for (int32 Skill = 0; Skill < UE_ARRAY_COUNT(Fighter.SkillLevel); ++Skill)
+	{
+		if (Fighter.PendingXP[Skill] > 0.0f)
+		{
+			Fighter.SkillXP[Skill] += Fighter.PendingXP[Skill] * Multiplier;
+			Fighter.PendingXP[Skill] = 0.0f;
+			CombatRules::ApplySkillLevelUps(Fighter.SkillLevel[Skill], Fighter.SkillXP[Skill], Fighter.SkillXPToNext[Skill]);
+		}
+	}
+}
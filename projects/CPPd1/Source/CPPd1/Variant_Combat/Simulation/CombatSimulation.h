@@ -0,0 +1,279 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Everything the simulator needs to know about one side of a fight.
+ * Defaults match the component/character defaults; ACombatCharacter and ACombatEnemy can fill one from their tuning.
+ */
+struct CPPd1_API FCombatSimFighterTuning
+{
+	// ========== Health / damage ==========
+
+	float MaxHP = 5.0f;
+	float MeleeDamage = 1.0f;
+	float GlobalDamageMultiplier = 1.0f;
+	float GlobalDefenseMultiplier = 1.0f;
+
+	/** Seconds of invulnerability after taking damage */
+	float InvincibilityFrames = 0.0f;
+
+	/** Getting hit cancels the current attack (enemies stop their montage on damage) */
+	bool bInterruptedByHits = false;
+
+	// ========== Attacks ==========
+
+	/** Number of combo stages (combo montage sections) */
+	int32 ComboStages = 3;
+
+	/** Pick a random combo length in [1, ComboStages - 1] like the AI does, instead of always chaining the full string */
+	bool bRandomComboLength = false;
+
+	/** Seconds per combo stage, and where in the stage the hit lands (0-1) */
+	float ComboStageDuration = 0.6f;
+	float HitTimeFraction = 0.5f;
+
+	/** Chance to use a charged attack instead of a combo */
+	float ChargedAttackChance = 0.2f;
+
+	/** Charge loops before a charged attack releases, seconds per loop, and the damage multiplier of the release */
+	int32 MinChargeLoops = 2;
+	int32 MaxChargeLoops = 5;
+	float ChargeLoopDuration = 0.4f;
+	float ChargedDamageMultiplier = 2.0f;
+
+	/** Idle time between attacks */
+	float MinAttackInterval = 0.5f;
+	float MaxAttackInterval = 1.5f;
+
+	// ========== Combat systems (stamina / flow / skill / parry) ==========
+
+	/** Owns stamina, flow, skill and advanced-mechanics components. Enemies don't */
+	bool bHasCombatSystems = false;
+
+	float MaxStamina = 1.0f;
+	float LightAttackStaminaCost = 0.10f;
+	float HeavyAttackStaminaCost = 0.25f;
+	float BlockStaminaDrainRate = 0.15f;
+	float BaseStaminaRecoveryRate = 0.2f;
+	float ExhaustedStaminaRecoveryRate = 0.05f;
+	float StaminaRecoveryDelay = 1.0f;
+	float ExhaustionThreshold = 0.2f;
+
+	float MaxFlow = 1.0f;
+	float FlowDecayRate = 0.1f;
+	float FlowStateThreshold = 0.7f;
+	float FlowStateMultiplier = 1.5f;
+	float ComboFlowPoints = 0.05f;
+	float ComboResetTime = 3.0f;
+
+	float PerfectParryWindow = 0.1f;
+	float GoodParryWindow = 0.2f;
+	float PerfectParryDamageMultiplier = 2.0f;
+	float CounterAttackWindow = 1.0f;
+
+	float StartingSkillLevel = 0.0f;
+	float BaseDamageMultiplier = 0.5f;
+	float MaxDamageMultiplier = 2.0f;
+	float BaseDefenseEffectiveness = 0.3f;
+	float MaxDefenseEffectiveness = 0.9f;
+	float ExperienceMultiplier = 1.0f;
+
+	/** Scale hit damage by the striking skill and flow multipliers (the damage formula in ADVANCED_SYSTEMS_GUIDE.md) */
+	bool bApplySkillAndFlowToDamage = true;
+
+	/** XP per landed hit (striking), per parry (defense), per finished combo (technique) */
+	float StrikingXPPerHit = 10.0f;
+	float DefenseXPPerParry = 15.0f;
+	float TechniqueXPPerCombo = 10.0f;
+
+	// ========== Behaviour (stand-in for player input) ==========
+
+	/** Chance to try a parry against an incoming hit, and the spread of the parry timing (seconds after the window could open) */
+	float ParryChance = 0.3f;
+	float ParryTimingSpread = 0.3f;
+
+	/** Chance to block an incoming hit that wasn't parried */
+	float BlockChance = 0.3f;
+
+	/** Seconds of block held per blocked hit (drains stamina) */
+	float BlockHoldTime = 0.5f;
+};
+
+/** Fight setup shared by every fight in a batch */
+struct CPPd1_API FCombatSimConfig
+{
+	FCombatSimFighterTuning Player;
+	FCombatSimFighterTuning Enemy;
+
+	/** Fixed simulation step */
+	float TimeStep = 1.0f / 60.0f;
+
+	/** Fights still running after this long are draws */
+	float MaxFightTime = 120.0f;
+
+	FCombatSimConfig();
+};
+
+/** Outcome of one simulated fight */
+struct CPPd1_API FCombatSimFightResult
+{
+	enum class EWinner : uint8
+	{
+		Player,
+		Enemy,
+		Draw
+	};
+
+	EWinner Winner = EWinner::Draw;
+	float Duration = 0.0f;
+	float PlayerHPLeft = 0.0f;
+	float EnemyHPLeft = 0.0f;
+
+	int32 PlayerHits = 0;
+	int32 EnemyHits = 0;
+	float PlayerDamageDealt = 0.0f;
+	float EnemyDamageDealt = 0.0f;
+
+	int32 PerfectParries = 0;
+	int32 GoodParries = 0;
+	int32 Blocks = 0;
+	int32 Exhaustions = 0;
+	int32 MaxCombo = 0;
+	float TimeInFlowState = 0.0f;
+	float FinalStrikingLevel = 0.0f;
+};
+
+/** Aggregated results of a batch of fights */
+struct CPPd1_API FCombatSimStats
+{
+	int32 NumFights = 0;
+	int32 PlayerWins = 0;
+	int32 EnemyWins = 0;
+	int32 Draws = 0;
+
+	double TotalDuration = 0.0;
+	double TotalDurationSquared = 0.0;
+	float MinDuration = TNumericLimits<float>::Max();
+	float MaxDuration = 0.0f;
+
+	double TotalPlayerHPLeft = 0.0;
+	double TotalPlayerHits = 0.0;
+	double TotalEnemyHits = 0.0;
+	double TotalPlayerDamage = 0.0;
+	double TotalEnemyDamage = 0.0;
+	double TotalPerfectParries = 0.0;
+	double TotalGoodParries = 0.0;
+	double TotalBlocks = 0.0;
+	double TotalExhaustions = 0.0;
+	double TotalTimeInFlowState = 0.0;
+	double TotalFinalStrikingLevel = 0.0;
+	int32 MaxCombo = 0;
+
+	/** Wall-clock seconds the batch took */
+	double WallSeconds = 0.0;
+
+	void Add(const FCombatSimFightResult& Result);
+	void Merge(const FCombatSimStats& Other);
+
+	double GetMean(double Total) const { return NumFights > 0 ? Total / NumFights : 0.0; }
+	double GetDurationStdDev() const;
+
+	/** Multi-line human-readable summary */
+	FString ToString() const;
+
+	/** CSV header and a single row with the aggregated values */
+	static FString GetCsvHeader();
+	FString ToCsvRow() const;
+};
+
+/**
+ * Fixed-timestep, engine-independent fight between one player-like fighter and one enemy.
+ * Uses the same CombatRules as the gameplay components; montages are replaced by timed combo stages,
+ * player input by the behaviour chances in the tuning. Deterministic for a given seed.
+ */
+class CPPd1_API FCombatSimulation
+{
+public:
+
+	FCombatSimulation(const FCombatSimConfig& InConfig, int32 Seed);
+
+	/** Run until someone dies or MaxFightTime passes */
+	FCombatSimFightResult Run();
+
+	/** Advance one fixed step. Returns false once the fight is over */
+	bool Step();
+
+	/** Run NumFights fights (seeds BaseSeed + index) across all cores and aggregate them */
+	static FCombatSimStats RunBatch(const FCombatSimConfig& Config, int32 NumFights, int32 BaseSeed);
+
+private:
+
+	enum class EAction : uint8
+	{
+		Idle,
+		Combo,
+		Charged
+	};
+
+	struct FFighter
+	{
+		const FCombatSimFighterTuning* Tuning = nullptr;
+
+		float HP = 0.0f;
+		float TimeSinceDamage = TNumericLimits<float>::Max();
+
+		EAction Action = EAction::Idle;
+		float ActionTime = 0.0f;
+		float NextActionTime = 0.0f;
+		int32 ComboTarget = 0;
+		int32 ComboStage = 0;
+		bool bHitPending = false;
+		float ChargeTime = 0.0f;
+
+		float Stamina = 1.0f;
+		float RecoveryStartTime = 0.0f;
+		float BlockUntil = 0.0f;
+		bool bExhausted = false;
+
+		float Flow = 0.0f;
+		int32 FlowCombo = 0;
+		float LastComboHitTime = -1.0f;
+
+		float CounterUntil = -1.0f;
+		float CounterMultiplier = 1.0f;
+
+		float StaminaEfficiency = 1.0f;
+		float SkillLevel[3] = {};
+		float SkillXP[3] = {};
+		float SkillXPToNext[3] = {};
+		float PendingXP[3] = {};
+	};
+
+	/** Indices into FFighter's skill arrays */
+	enum ESimSkill : int32
+	{
+		Skill_Striking,
+		Skill_Defense,
+		Skill_Technique
+	};
+
+	void InitFighter(FFighter& Fighter, const FCombatSimFighterTuning& Tuning);
+	void UpdateFighter(FFighter& Fighter, float DeltaTime);
+	void UpdateAction(FFighter& Attacker, FFighter& Defender, bool bAttackerIsPlayer);
+	void StartAttack(FFighter& Fighter);
+	void EndAttack(FFighter& Fighter);
+	void ResolveHit(FFighter& Attacker, FFighter& Defender, bool bAttackerIsPlayer, float DamageScale);
+	void DrainStamina(FFighter& Fighter, float Amount);
+	void FlushExperience(FFighter& Fighter);
+
+	const FCombatSimConfig& Config;
+	FRandomStream Random;
+	FFighter Player;
+	FFighter Enemy;
+	float Time = 0.0f;
+	FCombatSimFightResult Result;
+};
@@ -11,17 +11,33 @@
 #include "Variant_Combat/AI/CombatEnemy.h"
 #include "Variant_Combat/CombatGameMode.h"
 
+namespace
+{
+	/** Bars are a few hundred pixels wide; smaller changes aren't visible */
+	constexpr float HUDBarEpsilon = 0.002f;
+}
+
 UCombatHUD::UCombatHUD(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bAutoUpdate = true;
-	UpdateRate = 0.1f;
 }
 
 void UCombatHUD::NativeConstruct()
 {
 	Super::NativeConstruct();
 
+	if (bAutoUpdate)
+	{
+		// follow the owning player's pawn across respawns
+		if (APlayerController* PC = GetOwningPlayer())
+		{
+			PC->OnPossessedPawnChanged.AddUniqueDynamic(this, &UCombatHUD::HandlePossessedPawnChanged);
+		}
+
+		BindToWaveSpawner();
+	}
+
 	// Try to find character automatically if not set
 	if (!TargetCharacter)
 	{
@@ -35,61 +51,110 @@ void UCombatHUD::NativeConstruct()
 	}
 }
 
+void UCombatHUD::NativeDestruct()
+{
+	UnbindFromCharacter();
+
+	if (ACombatWaveSpawner* WaveSpawner = BoundWaveSpawner.Get())
+	{
+		WaveSpawner->OnWaveEnemiesChanged.RemoveDynamic(this, &UCombatHUD::HandleWaveEnemiesChanged);
+	}
+	BoundWaveSpawner.Reset();
+
+	if (APlayerController* PC = GetOwningPlayer())
+	{
+		PC->OnPossessedPawnChanged.RemoveDynamic(this, &UCombatHUD::HandlePossessedPawnChanged);
+	}
+
+	Super::NativeDestruct();
+}
+
 void UCombatHUD::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
-	if (bAutoUpdate)
+	// stamina and flow are closed-form and only broadcast at transitions, so sample them while they move
+	const UCombatStaminaSystem* StaminaSystem = BoundStamina.Get();
+	if (StaminaSystem && StaminaSystem->IsStaminaChanging())
 	{
-		LastUpdateTime += InDeltaTime;
-		if (LastUpdateTime >= UpdateRate)
-		{
-			UpdateFromCharacter();
-			LastUpdateTime = 0.0f;
-		}
+		PendingStamina = StaminaSystem->GetStamina();
+		DirtyFlags |= Dirty_Stamina;
+	}
+
+	const UCombatFlowSystem* FlowSystem = BoundFlow.Get();
+	if (FlowSystem && FlowSystem->IsFlowDecaying())
+	{
+		PendingFlow = FlowSystem->GetFlowMeter();
+		DirtyFlags |= Dirty_Flow;
+	}
+
+	// several events can land in one frame; push them to the widgets once
+	if (DirtyFlags != Dirty_None)
+	{
+		FlushDirty();
 	}
 }
 
 void UCombatHUD::SetCharacter(ACombatCharacter* Character)
 {
+	if (bAutoUpdate)
+	{
+		UnbindFromCharacter();
+	}
+
 	TargetCharacter = Character;
+
+	if (bAutoUpdate)
+	{
+		BindToCharacter(Character);
+	}
+
 	UpdateFromCharacter();
 }
 
 void UCombatHUD::UpdateHealth(float HealthPercent)
 {
-	if (HealthBar)
+	HealthPercent = FMath::Clamp(HealthPercent, 0.0f, 1.0f);
+	if (HealthBar && !FMath::IsNearlyEqual(HealthPercent, ShownHealth, HUDBarEpsilon))
 	{
-		HealthBar->SetPercent(FMath::Clamp(HealthPercent, 0.0f, 1.0f));
+		HealthBar->SetPercent(HealthPercent);
+		ShownHealth = HealthPercent;
 	}
 }
 
 void UCombatHUD::UpdateStamina(float StaminaPercent)
 {
-	if (StaminaBar)
+	StaminaPercent = FMath::Clamp(StaminaPercent, 0.0f, 1.0f);
+	if (StaminaBar && !FMath::IsNearlyEqual(StaminaPercent, ShownStamina, HUDBarEpsilon))
 	{
-		StaminaBar->SetPercent(FMath::Clamp(StaminaPercent, 0.0f, 1.0f));
+		StaminaBar->SetPercent(StaminaPercent);
+		ShownStamina = StaminaPercent;
 	}
 }
 
 void UCombatHUD::UpdateFlow(float FlowPercent)
 {
-	if (FlowBar)
+	FlowPercent = FMath::Clamp(FlowPercent, 0.0f, 1.0f);
+	if (FlowBar && !FMath::IsNearlyEqual(FlowPercent, ShownFlow, HUDBarEpsilon))
 	{
-		FlowBar->SetPercent(FMath::Clamp(FlowPercent, 0.0f, 1.0f));
+		FlowBar->SetPercent(FlowPercent);
+		ShownFlow = FlowPercent;
 	}
 }
 
 void UCombatHUD::UpdateWaveInfo(int32 CurrentWave, int32 EnemiesRemaining)
 {
-	if (WaveNumberText)
+	// SetText invalidates layout, so only rebuild the strings when the numbers change
+	if (WaveNumberText && CurrentWave != ShownWaveNumber)
 	{
 		WaveNumberText->SetText(FText::FromString(FString::Printf(TEXT("Wave %d"), CurrentWave)));
+		ShownWaveNumber = CurrentWave;
 	}
 
-	if (EnemiesRemainingText)
+	if (EnemiesRemainingText && EnemiesRemaining != ShownEnemies)
 	{
 		EnemiesRemainingText->SetText(FText::FromString(FString::Printf(TEXT("Enemies: %d"), EnemiesRemaining)));
+		ShownEnemies = EnemiesRemaining;
 	}
 }
 
@@ -97,55 +162,175 @@ void UCombatHUD::SetWaveInfoVisible(bool bVisible)
 {
 	if (WaveInfoPanel)
 	{
-		WaveInfoPanel->SetVisibility(bVisible ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+		const ESlateVisibility NewVisibility = bVisible ? ESlateVisibility::Visible : ESlateVisibility::Collapsed;
+		if (WaveInfoPanel->GetVisibility() != NewVisibility)
+		{
+			WaveInfoPanel->SetVisibility(NewVisibility);
+		}
 	}
 }
 
-void UCombatHUD::UpdateFromCharacter()
+void UCombatHUD::BindToCharacter(ACombatCharacter* Character)
 {
-	if (!TargetCharacter)
+	if (!Character)
 	{
 		return;
 	}
 
-	// Update health
-	float CurrentHP = TargetCharacter->GetCurrentHP();
-	float MaxHP = TargetCharacter->GetMaxHP();
-	if (MaxHP > 0.0f)
+	Character->OnHealthChanged.AddUniqueDynamic(this, &UCombatHUD::HandleHealthChanged);
+
+	// the character caches its combat components; no lookups here
+	if (UCombatStaminaSystem* StaminaSystem = Character->GetCombatComponents().Stamina)
 	{
-		UpdateHealth(CurrentHP / MaxHP);
+		StaminaSystem->OnStaminaChanged.AddUniqueDynamic(this, &UCombatHUD::HandleStaminaChanged);
+		BoundStamina = StaminaSystem;
 	}
 
-	// Update stamina
-	if (UCombatStaminaSystem* StaminaSystem = TargetCharacter->FindComponentByClass<UCombatStaminaSystem>())
+	if (UCombatFlowSystem* FlowSystem = Character->GetCombatComponents().Flow)
 	{
-		UpdateStamina(StaminaSystem->GetStamina());
+		FlowSystem->OnFlowChanged.AddUniqueDynamic(this, &UCombatHUD::HandleFlowChanged);
+		BoundFlow = FlowSystem;
+	}
+}
+
+void UCombatHUD::UnbindFromCharacter()
+{
+	if (TargetCharacter)
+	{
+		TargetCharacter->OnHealthChanged.RemoveDynamic(this, &UCombatHUD::HandleHealthChanged);
 	}
 
-	// Update flow
-	if (UCombatFlowSystem* FlowSystem = TargetCharacter->FindComponentByClass<UCombatFlowSystem>())
+	if (UCombatStaminaSystem* StaminaSystem = BoundStamina.Get())
 	{
-		UpdateFlow(FlowSystem->GetFlowMeter());
+		StaminaSystem->OnStaminaChanged.RemoveDynamic(this, &UCombatHUD::HandleStaminaChanged);
+	}
+	BoundStamina.Reset();
+
+	if (UCombatFlowSystem* FlowSystem = BoundFlow.Get())
+	{
+		FlowSystem->OnFlowChanged.RemoveDynamic(this, &UCombatHUD::HandleFlowChanged);
+	}
+	BoundFlow.Reset();
+}
+
+void UCombatHUD::BindToWaveSpawner()
+{
+	if (BoundWaveSpawner.IsValid())
+	{
+		return;
 	}
 
-	// Update wave info
 	if (UWorld* World = GetWorld())
 	{
-		if (ACombatGameMode* GameMode = Cast<ACombatGameMode>(UGameplayStatics::GetGameMode(World)))
+		ACombatGameMode* GameMode = Cast<ACombatGameMode>(UGameplayStatics::GetGameMode(World));
+		if (GameMode && GameMode->WaveSpawner)
 		{
-			if (GameMode && GameMode->WaveSpawner)
-			{
-				ACombatWaveSpawner* WaveSpawner = GameMode->WaveSpawner;
-				// Get current wave and enemy count
-				TArray<ACombatEnemy*> CurrentEnemies = WaveSpawner->GetCurrentWaveEnemies();
-				int32 WaveNumber = WaveSpawner->GetCurrentWaveIndex() + 1; // 1-indexed for display
-				UpdateWaveInfo(WaveNumber, CurrentEnemies.Num());
-				SetWaveInfoVisible(true);
-			}
-			else
-			{
-				SetWaveInfoVisible(false);
-			}
+			GameMode->WaveSpawner->OnWaveEnemiesChanged.AddUniqueDynamic(this, &UCombatHUD::HandleWaveEnemiesChanged);
+			BoundWaveSpawner = GameMode->WaveSpawner;
 		}
 	}
 }
+
+void UCombatHUD::UpdateFromCharacter()
+{
+	// one full read to start in sync; events keep it current after this
+	if (TargetCharacter && TargetCharacter->GetMaxHP() > 0.0f)
+	{
+		PendingHealth = TargetCharacter->GetCurrentHP() / TargetCharacter->GetMaxHP();
+	}
+
+	UCombatStaminaSystem* StaminaSystem = TargetCharacter ? TargetCharacter->GetCombatComponents().Stamina.Get() : nullptr;
+	if (StaminaSystem)
+	{
+		PendingStamina = StaminaSystem->GetStamina();
+	}
+
+	UCombatFlowSystem* FlowSystem = TargetCharacter ? TargetCharacter->GetCombatComponents().Flow.Get() : nullptr;
+	if (FlowSystem)
+	{
+		PendingFlow = FlowSystem->GetFlowMeter();
+	}
+
+	BindToWaveSpawner();
+	if (ACombatWaveSpawner* WaveSpawner = BoundWaveSpawner.Get())
+	{
+		PendingWaveNumber = WaveSpawner->GetCurrentWaveIndex() + 1; // 1-indexed for display
+		PendingEnemies = WaveSpawner->GetCurrentWaveEnemyCount();
+		bPendingWaveVisible = true;
+	}
+	else
+	{
+		bPendingWaveVisible = false;
+	}
+
+	DirtyFlags = Dirty_All;
+	FlushDirty();
+}
+
+void UCombatHUD::FlushDirty()
+{
+	COMBAT_SCOPE(HUDRefresh);
+
+	if (DirtyFlags & Dirty_Health)
+	{
+		UpdateHealth(PendingHealth);
+	}
+
+	if (DirtyFlags & Dirty_Stamina)
+	{
+		UpdateStamina(PendingStamina);
+	}
+
+	if (DirtyFlags & Dirty_Flow)
+	{
+		UpdateFlow(PendingFlow);
+	}
+
+	if (DirtyFlags & Dirty_Wave)
+	{
+		SetWaveInfoVisible(bPendingWaveVisible);
+		if (bPendingWaveVisible)
+		{
+			UpdateWaveInfo(PendingWaveNumber, PendingEnemies);
+		}
+	}
+
+	DirtyFlags = Dirty_None;
+}
+
+void UCombatHUD::HandleHealthChanged(float CurrentHP, float MaxHP)
+{
+	if (MaxHP > 0.0f)
+	{
+		PendingHealth = CurrentHP / MaxHP;
+		DirtyFlags |= Dirty_Health;
+	}
+}
+
+void UCombatHUD::HandleStaminaChanged(float NewStamina)
+{
+	PendingStamina = NewStamina;
+	DirtyFlags |= Dirty_Stamina;
+}
+
+void UCombatHUD::HandleFlowChanged(float NewFlow)
+{
+	PendingFlow = NewFlow;
+	DirtyFlags |= Dirty_Flow;
+}
+
+void UCombatHUD::HandleWaveEnemiesChanged(int32 WaveIndex, int32 EnemiesRemaining)
+{
+	PendingWaveNumber = WaveIndex + 1; // 1-indexed for display
+	PendingEnemies = EnemiesRemaining;
+	bPendingWaveVisible = true;
+	DirtyFlags |= Dirty_Wave;
+}
+
+void UCombatHUD::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	if (ACombatCharacter* Character = Cast<ACombatCharacter>(NewPawn))
+	{
+		SetCharacter(Character);
+	}
+}
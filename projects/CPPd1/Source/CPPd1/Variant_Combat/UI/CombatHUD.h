@@ -10,12 +10,17 @@
 class ACombatCharacter;
 class UCombatStaminaSystem;
 class UCombatFlowSystem;
+class ACombatWaveSpawner;
 class UProgressBar;
 class UTextBlock;
 
 /**
  * Main HUD widget for combat - displays health, stamina, flow, wave info
  * Create a Blueprint from this to design the visual layout
+ * Event driven: binds to the character's HP/stamina/flow delegates and the wave spawner's enemy count,
+ * marks what changed and pushes it to the widgets once per frame. Nothing is touched while values are steady.
+ * Stamina and flow only broadcast at transitions, so they are sampled each frame while recovering or decaying.
+ * Wrap static panels (labels, frames) in a Retainer Box or Invalidation Box in the Blueprint layout.
  */
 UCLASS(BlueprintType, Blueprintable)
 class CPPd1_API UCombatHUD : public UUserWidget
@@ -26,6 +31,7 @@ public:
 	UCombatHUD(const FObjectInitializer& ObjectInitializer);
 
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 	/** Set the character to display stats for */
@@ -81,15 +87,67 @@ protected:
 	UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "Combat|HUD")
 	TObjectPtr<UWidget> WaveInfoPanel;
 
-	/** Auto-update from character components */
+	/** Auto-update from character and wave spawner events */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|HUD")
 	bool bAutoUpdate = true;
 
-	/** Update rate (how often to refresh from character) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|HUD", meta = (ClampMin = 0.0f))
-	float UpdateRate = 0.1f; // Update 10 times per second
+	/** Components we're bound to (from the character's cached component set) */
+	TWeakObjectPtr<UCombatStaminaSystem> BoundStamina;
+	TWeakObjectPtr<UCombatFlowSystem> BoundFlow;
+	TWeakObjectPtr<ACombatWaveSpawner> BoundWaveSpawner;
+
+	/** Dirty bits for values that changed since the last flush */
+	enum EHUDDirtyFlags : uint8
+	{
+		Dirty_None = 0,
+		Dirty_Health = 1 << 0,
+		Dirty_Stamina = 1 << 1,
+		Dirty_Flow = 1 << 2,
+		Dirty_Wave = 1 << 3,
+		Dirty_All = Dirty_Health | Dirty_Stamina | Dirty_Flow | Dirty_Wave
+	};
+	uint8 DirtyFlags = Dirty_None;
+
+	/** Latest values received from events */
+	float PendingHealth = 1.0f;
+	float PendingStamina = 1.0f;
+	float PendingFlow = 0.0f;
+	int32 PendingWaveNumber = 0;
+	int32 PendingEnemies = 0;
+	bool bPendingWaveVisible = false;
+
+	/** Values currently shown (skip widget writes when nothing visible changes) */
+	float ShownHealth = -1.0f;
+	float ShownStamina = -1.0f;
+	float ShownFlow = -1.0f;
+	int32 ShownWaveNumber = -1;
+	int32 ShownEnemies = -1;
+
+	/** Bind to the character (and its stamina/flow components) / unbind from TargetCharacter */
+	void BindToCharacter(ACombatCharacter* Character);
+	void UnbindFromCharacter();
+
+	/** Bind to the game mode's wave spawner */
+	void BindToWaveSpawner();
+
+	/** Read every value once (after binding) so the HUD starts in sync */
+	void UpdateFromCharacter();
 
-	float LastUpdateTime = 0.0f;
+	/** Push dirty values to the widgets */
+	void FlushDirty();
 
-	void UpdateFromCharacter();
+	UFUNCTION()
+	void HandleHealthChanged(float CurrentHP, float MaxHP);
+
+	UFUNCTION()
+	void HandleStaminaChanged(float NewStamina);
+
+	UFUNCTION()
+	void HandleFlowChanged(float NewFlow);
+
+	UFUNCTION()
+	void HandleWaveEnemiesChanged(int32 WaveIndex, int32 EnemiesRemaining);
+
+	UFUNCTION()
+	void HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
 };
@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Variant_Combat/UI/CombatLifeBarOverlay.h"
+#include "Components/SceneComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/SLeafWidget.h"
+
+namespace
+{
+	/** Bar size in Slate units (scaled by DPI) */
+	const FVector2D LifeBarSize(80.0f, 8.0f);
+
+	/** Border drawn around the fill */
+	const float LifeBarBorder = 1.0f;
+
+	const FLinearColor LifeBarBackgroundColor(0.0f, 0.0f, 0.0f, 0.6f);
+}
+
+/** Leaf widget that paints the overlay's projected bars. Volatile: it changes every frame anyway. */
+class SCombatLifeBarOverlay : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SCombatLifeBarOverlay) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UCombatLifeBarOverlay* InOverlay)
+	{
+		Overlay = InOverlay;
+		SetCanTick(false);
+		ForceVolatile(true);
+	}
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		const UCombatLifeBarOverlay* OverlayPtr = Overlay.Get();
+		if (!OverlayPtr || OverlayPtr->GetDrawItems().Num() == 0)
+		{
+			return LayerId;
+		}
+
+		const FSlateBrush* Brush = FCoreStyle::Get().GetBrush(TEXT("GenericWhiteBox"));
+		const float PixelToLocal = AllottedGeometry.Scale > 0.0f ? 1.0f / AllottedGeometry.Scale : 1.0f;
+		const FVector2D Inner = LifeBarSize - FVector2D(LifeBarBorder * 2.0f);
+
+		// all backgrounds on one layer and all fills on the next, so Slate batches each into a single draw
+		for (const FCombatLifeBarDrawItem& Item : OverlayPtr->GetDrawItems())
+		{
+			const FVector2D TopLeft = Item.ScreenPosition * PixelToLocal - FVector2D(LifeBarSize.X * 0.5f, LifeBarSize.Y);
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(LifeBarSize, FSlateLayoutTransform(TopLeft)),
+				Brush, ESlateDrawEffect::None, LifeBarBackgroundColor);
+		}
+
+		for (const FCombatLifeBarDrawItem& Item : OverlayPtr->GetDrawItems())
+		{
+			const FVector2D TopLeft = Item.ScreenPosition * PixelToLocal - FVector2D(LifeBarSize.X * 0.5f, LifeBarSize.Y) + FVector2D(LifeBarBorder);
+			const FVector2D FillSize(Inner.X * Item.Percent, Inner.Y);
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(FillSize, FSlateLayoutTransform(TopLeft)),
+				Brush, ESlateDrawEffect::None, Item.Color);
+		}
+
+		return LayerId + 1;
+	}
+
+private:
+	TWeakObjectPtr<UCombatLifeBarOverlay> Overlay;
+};
+
+int32 UCombatLifeBarOverlay::RegisterBar(USceneComponent* Anchor, const FLinearColor& Color)
+{
+	LLM_SCOPE_BYTAG(Combat_HUD);
+
+	if (!Anchor)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(EAllowShrinking::No) : HandleSlots.AddUninitialized();
+	const int32 Slot = Anchors.Add(Anchor);
+	Percents.Add(1.0f);
+	Colors.Add(Color);
+	Hidden.Add(false);
+	SlotHandles.Add(Handle);
+	HandleSlots[Handle] = Slot;
+
+	return Handle;
+}
+
+void UCombatLifeBarOverlay::UnregisterBar(int32 Handle)
+{
+	const int32 Slot = GetSlot(Handle);
+	if (Slot == INDEX_NONE)
+	{
+		return;
+	}
+
+	// move the last bar into the freed slot
+	const int32 LastSlot = Anchors.Num() - 1;
+	if (Slot != LastSlot)
+	{
+		HandleSlots[SlotHandles[LastSlot]] = Slot;
+	}
+
+	Anchors.RemoveAtSwap(Slot, EAllowShrinking::No);
+	Percents.RemoveAtSwap(Slot, EAllowShrinking::No);
+	Colors.RemoveAtSwap(Slot, EAllowShrinking::No);
+	Hidden.RemoveAtSwap(Slot, EAllowShrinking::No);
+	SlotHandles.RemoveAtSwap(Slot, EAllowShrinking::No);
+
+	HandleSlots[Handle] = INDEX_NONE;
+	FreeHandles.Add(Handle);
+}
+
+void UCombatLifeBarOverlay::SetBarPercent(int32 Handle, float Percent)
+{
+	const int32 Slot = GetSlot(Handle);
+	if (Slot != INDEX_NONE)
+	{
+		Percents[Slot] = FMath::Clamp(Percent, 0.0f, 1.0f);
+	}
+}
+
+void UCombatLifeBarOverlay::SetBarColor(int32 Handle, const FLinearColor& Color)
+{
+	const int32 Slot = GetSlot(Handle);
+	if (Slot != INDEX_NONE)
+	{
+		Colors[Slot] = Color;
+	}
+}
+
+void UCombatLifeBarOverlay::SetBarHidden(int32 Handle, bool bHidden)
+{
+	const int32 Slot = GetSlot(Handle);
+	if (Slot != INDEX_NONE)
+	{
+		Hidden[Slot] = bHidden;
+	}
+}
+
+bool UCombatLifeBarOverlay::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatLifeBarOverlay::OnWorldBeginPlay(UWorld& InWorld)
+{
+	LLM_SCOPE_BYTAG(Combat_HUD);
+
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UGameViewportClient* GameViewport = InWorld.GetGameViewport())
+	{
+		OverlayWidget = SNew(SCombatLifeBarOverlay, this).Visibility(EVisibility::HitTestInvisible);
+
+		// below the UMG HUD
+		GameViewport->AddViewportWidgetContent(OverlayWidget.ToSharedRef(), -1);
+		ViewportClient = GameViewport;
+	}
+}
+
+void UCombatLifeBarOverlay::Deinitialize()
+{
+	if (UGameViewportClient* GameViewport = ViewportClient.Get())
+	{
+		if (OverlayWidget.IsValid())
+		{
+			GameViewport->RemoveViewportWidgetContent(OverlayWidget.ToSharedRef());
+		}
+	}
+	OverlayWidget.Reset();
+	ViewportClient.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UCombatLifeBarOverlay::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatLifeBarOverlay, STATGROUP_Combat);
+}
+
+void UCombatLifeBarOverlay::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DrawItems.Reset();
+
+	UGameViewportClient* GameViewport = ViewportClient.Get();
+	if (Anchors.Num() == 0 || !GameViewport || !GameViewport->Viewport)
+	{
+		return;
+	}
+
+	// one view-projection per local player, then every anchor goes through it
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+		if (!LocalPlayer)
+		{
+			continue;
+		}
+
+		FSceneViewProjectionData ProjectionData;
+		if (!LocalPlayer->GetProjectionData(GameViewport->Viewport, ProjectionData))
+		{
+			continue;
+		}
+
+		const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+		const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+		for (int32 Slot = 0; Slot < Anchors.Num(); ++Slot)
+		{
+			// full-HP and dead bars are culled before touching the anchor
+			const float Percent = Percents[Slot];
+			if (Hidden[Slot] || Percent >= 1.0f || Percent <= 0.0f)
+			{
+				continue;
+			}
+
+			const USceneComponent* Anchor = Anchors[Slot].Get();
+			if (!Anchor)
+			{
+				continue;
+			}
+
+			FVector2D ScreenPosition;
+			if (!FSceneView::ProjectWorldToScreen(Anchor->GetComponentLocation(), ViewRect, ViewProjection, ScreenPosition))
+			{
+				continue;
+			}
+
+			// off this player's part of the screen
+			if (ScreenPosition.X < ViewRect.Min.X || ScreenPosition.X > ViewRect.Max.X || ScreenPosition.Y < ViewRect.Min.Y || ScreenPosition.Y > ViewRect.Max.Y)
+			{
+				continue;
+			}
+
+			FCombatLifeBarDrawItem& Item = DrawItems.AddDefaulted_GetRef();
+			Item.ScreenPosition = ScreenPosition;
+			Item.Percent = Percent;
+			Item.Color = Colors[Slot];
+		}
+	}
+}
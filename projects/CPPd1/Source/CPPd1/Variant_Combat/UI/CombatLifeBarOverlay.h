@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPPd1.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatLifeBarOverlay.generated.h"
+
+class SWidget;
+class USceneComponent;
+class UGameViewportClient;
+
+/** One projected bar, ready to paint (viewport pixel coordinates) */
+struct FCombatLifeBarDrawItem
+{
+	FVector2D ScreenPosition = FVector2D::ZeroVector;
+	float Percent = 1.0f;
+	FLinearColor Color = FLinearColor::Red;
+};
+
+/**
+ * Draws every combat life bar in the world from one screen-space overlay.
+ * Characters and enemies register an anchor component and push HP percentages; each frame the overlay
+ * projects all anchors once per local player and a single Slate widget paints the bars in one pass.
+ * Hidden, full-HP, dead and off-screen bars are culled before painting.
+ */
+UCLASS()
+class CPPd1_API UCombatLifeBarOverlay : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Add a bar anchored to the given component. Returns a handle for the other calls. */
+	int32 RegisterBar(USceneComponent* Anchor, const FLinearColor& Color);
+
+	/** Remove a bar. The handle may be reused afterwards. */
+	void UnregisterBar(int32 Handle);
+
+	/** Set the bar fill (0.0 to 1.0) */
+	void SetBarPercent(int32 Handle, float Percent);
+
+	/** Set the bar fill color */
+	void SetBarColor(int32 Handle, const FLinearColor& Color);
+
+	/** Hide or show a bar without unregistering it */
+	void SetBarHidden(int32 Handle, bool bHidden);
+
+	/** Bars that survived culling this frame */
+	const TArray<FCombatLifeBarDrawItem>& GetDrawItems() const { return DrawItems; }
+
+	/** Number of registered bars */
+	int32 GetNumBars() const { return Anchors.Num(); }
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Packed per-bar data, index-aligned. Removal swaps the last bar in, so slots move but handles don't. */
+	TArray<TWeakObjectPtr<USceneComponent>> Anchors;
+	TArray<float> Percents;
+	TArray<FLinearColor> Colors;
+	TArray<bool> Hidden;
+
+	/** slot -> handle */
+	TArray<int32> SlotHandles;
+
+	/** handle -> slot (INDEX_NONE when the handle is free) */
+	TArray<int32> HandleSlots;
+
+	/** Released handles waiting for reuse */
+	TArray<int32> FreeHandles;
+
+	/** Projected bars for this frame (reused to avoid allocations) */
+	TArray<FCombatLifeBarDrawItem> DrawItems;
+
+	/** The overlay widget added to the game viewport */
+	TSharedPtr<SWidget> OverlayWidget;
+
+	TWeakObjectPtr<UGameViewportClient> ViewportClient;
+
+	/** Slot for a handle, or INDEX_NONE */
+	int32 GetSlot(int32 Handle) const { return HandleSlots.IsValidIndex(Handle) ? HandleSlots[Handle] : INDEX_NONE; }
+};
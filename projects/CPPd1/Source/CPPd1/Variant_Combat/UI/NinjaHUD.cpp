@@ -9,6 +9,7 @@
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
 #include "Components/Border.h"
+#include "Components/InvalidationBox.h"
 #include "Slate/SlateBrushAsset.h"
 #include "Blueprint/WidgetTree.h"
 #include "Engine/Engine.h"
@@ -26,6 +27,9 @@ void UNinjaHUD::NativeConstruct()
 	if (!HealthBar)
 	{
 		BuildDynamicLayout();
+
+		// the base class synced before the bars existed
+		UpdateFromCharacter();
 	}
 }
 
@@ -39,7 +43,12 @@ void UNinjaHUD::BuildDynamicLayout()
 	if (!CanvasPanel)
 	{
 		CanvasPanel = NewObject<UCanvasPanel>(this);
-		WidgetTree->RootWidget = CanvasPanel;
+
+		// cache the whole layout; only bars whose percent changed get repainted
+		UInvalidationBox* InvalidationRoot = NewObject<UInvalidationBox>(this);
+		InvalidationRoot->SetCanCache(true);
+		InvalidationRoot->AddChild(CanvasPanel);
+		WidgetTree->RootWidget = InvalidationRoot;
 	}
 
 	// Create health bar container (top-left)